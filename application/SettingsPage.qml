@@ -113,5 +113,11 @@ Kirigami.ScrollablePage {
             checked: Mycroft.GlobalSettings.autoConnect
             onCheckedChanged: Mycroft.GlobalSettings.autoConnect = checked
         }
+
+        Controls.Switch {
+            text: "Show Performance Overlay"
+            checked: Mycroft.GlobalSettings.showPerformanceHud
+            onCheckedChanged: Mycroft.GlobalSettings.showPerformanceHud = checked
+        }
     }
 }
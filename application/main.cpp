@@ -23,6 +23,8 @@
 #include <QtQml>
 #include <QDebug>
 #include <QCursor>
+#include <QQuickWindow>
+#include <QTimer>
 #include <QtWebView/QtWebView>
 
 #include <QApplication>
@@ -30,10 +32,15 @@
 
 #include "speechintent.h"
 #include "appsettings.h"
+#include "startupprofiler.h"
 #include "version.h"
 
 int main(int argc, char *argv[])
 {
+    // Always recorded, it's cheap: only written with --profile-startup
+    StartupProfiler profiler;
+    profiler.begin(QStringLiteral("argument parsing"));
+
     QGuiApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 
     QStringList arguments;
@@ -50,16 +57,29 @@ int main(int argc, char *argv[])
     auto skillOption = QCommandLineOption(QStringLiteral("skill"), QStringLiteral("Single skill to load"), QStringLiteral("skill"));
     auto maximizeOption = QCommandLineOption(QStringLiteral("maximize"), QStringLiteral("When set, start maximized."));
     auto rotateScreen = QCommandLineOption(QStringLiteral("rotateScreen"), QStringLiteral("When set, rotate the screen by set degrees."), QStringLiteral("degrees"));
+    auto profileStartupOption = QCommandLineOption(QStringLiteral("profile-startup"), QStringLiteral("Write a timeline of the startup as a Chrome trace to the file."), QStringLiteral("file"));
     auto helpOption = QCommandLineOption(QStringLiteral("help"), QStringLiteral("Show this help message"));
     parser.addOptions({widthOption, heightOption, hideTextInputOption, skillOption,
                        dpiOption, maximizeOption,
-                       rotateScreen, helpOption});
+                       rotateScreen, profileStartupOption, helpOption});
     parser.process(arguments);
+    profiler.end(QStringLiteral("argument parsing"));
 
 
     qputenv("QT_WAYLAND_FORCE_DPI", parser.value(dpiOption).toLatin1());
 
+    profiler.begin(QStringLiteral("QApplication"));
     QApplication app(argc, argv);
+    profiler.end(QStringLiteral("QApplication"));
+
+    if (parser.isSet(profileStartupOption)) {
+        profiler.setOutputFile(parser.value(profileStartupOption));
+        // For the Mycroft plugin
+        app.setProperty("startupProfiler", QVariant::fromValue<QObject *>(&profiler));
+        // Also written if core never connects
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, &profiler, &StartupProfiler::write);
+        QTimer::singleShot(60000, &profiler, &StartupProfiler::write);
+    }
 
     app.setApplicationName(QStringLiteral("mycroft.gui"));
     app.setOrganizationDomain(QStringLiteral("kde.org"));
@@ -73,7 +93,11 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    profiler.begin(QStringLiteral("QtWebView::initialize"));
     QtWebView::initialize();
+    profiler.end(QStringLiteral("QtWebView::initialize"));
+
+    profiler.begin(QStringLiteral("engine setup"));
 
     QQuickView view;
     view.setResizeMode(QQuickView::SizeRootObjectToView);
@@ -103,9 +127,13 @@ int main(int argc, char *argv[])
         engine.rootContext()->setContextProperty(QStringLiteral("singleSkillHome"), QString());
     }
 
+    profiler.end(QStringLiteral("engine setup"));
+
     if (parser.isSet(skillOption)) {
+        profiler.begin(QStringLiteral("KDBusService"));
         app.setApplicationName(QStringLiteral("mycroft.gui.") + singleSkill);
         KDBusService service(KDBusService::Unique);
+        profiler.end(QStringLiteral("KDBusService"));
     }
 
     AppSettings *appSettings = new AppSettings(&view);
@@ -113,7 +141,18 @@ int main(int argc, char *argv[])
 
     qmlRegisterType<SpeechIntent>("org.kde.private.mycroftgui", 1, 0, "SpeechIntent");
 
+    profiler.begin(QStringLiteral("load main.qml"));
     engine.load(QUrl(QStringLiteral("qrc:/main.qml")));
+    profiler.end(QStringLiteral("load main.qml"));
+
+    if (!engine.rootObjects().isEmpty()) {
+        if (QQuickWindow *window = qobject_cast<QQuickWindow *>(engine.rootObjects().first())) {
+            profiler.watchWindow(window);
+        }
+    }
+    QTimer::singleShot(0, &profiler, [&profiler]() {
+        profiler.mark(QStringLiteral("event loop running"));
+    });
 
     return app.exec();
 }
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "startupprofiler.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+
+StartupProfiler::StartupProfiler(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_threads[QThread::currentThreadId()] = 1;
+    m_threadNames[1] = QStringLiteral("main");
+
+    // The trace is complete once both happened
+    m_awaitedMarks << QStringLiteral("first frame swapped") << QStringLiteral("core connected");
+}
+
+QString StartupProfiler::outputFile() const
+{
+    return m_outputFile;
+}
+
+void StartupProfiler::setOutputFile(const QString &fileName)
+{
+    m_outputFile = fileName;
+}
+
+int StartupProfiler::threadId()
+{
+    // Called with m_mutex held
+    const Qt::HANDLE handle = QThread::currentThreadId();
+    auto it = m_threads.constFind(handle);
+    if (it != m_threads.constEnd()) {
+        return it.value();
+    }
+
+    const int id = m_threads.count() + 1;
+    m_threads[handle] = id;
+    const QString name = QThread::currentThread()->objectName();
+    m_threadNames[id] = name.isEmpty() ? QStringLiteral("thread %1").arg(id) : name;
+    return id;
+}
+
+void StartupProfiler::begin(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_running.contains(name)) {
+        qWarning() << "Startup phase already running:" << name;
+        return;
+    }
+
+    Event event;
+    event.name = name;
+    event.start = m_clock.nsecsElapsed();
+    event.thread = threadId();
+    m_running[name] = m_events.count();
+    m_events << event;
+}
+
+void StartupProfiler::end(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_running.find(name);
+    if (it == m_running.end()) {
+        qWarning() << "Startup phase not running:" << name;
+        return;
+    }
+
+    Event &event = m_events[it.value()];
+    event.duration = m_clock.nsecsElapsed() - event.start;
+    m_running.erase(it);
+}
+
+void StartupProfiler::mark(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_marks.contains(name)) {
+        return;
+    }
+    m_marks << name;
+
+    Event event;
+    event.name = name;
+    event.start = m_clock.nsecsElapsed();
+    event.thread = threadId();
+    event.mark = true;
+    m_events << event;
+
+    if (m_awaitedMarks.remove(name) && m_awaitedMarks.isEmpty()) {
+        QMetaObject::invokeMethod(this, "write", Qt::QueuedConnection);
+    }
+}
+
+void StartupProfiler::watchWindow(QQuickWindow *window)
+{
+    // Right after the swap, in the render thread
+    QMetaObject::Connection *connection = new QMetaObject::Connection;
+    *connection = connect(window, &QQuickWindow::frameSwapped, this, [this, connection]() {
+        mark(QStringLiteral("first frame swapped"));
+        QObject::disconnect(*connection);
+    }, Qt::DirectConnection);
+    connect(window, &QObject::destroyed, this, [connection]() {
+        delete connection;
+    });
+}
+
+void StartupProfiler::write()
+{
+    if (m_written || m_outputFile.isEmpty()) {
+        return;
+    }
+    m_written = true;
+
+    QJsonArray traceEvents;
+    {
+        QMutexLocker locker(&m_mutex);
+        const double pid = QCoreApplication::applicationPid();
+
+        for (auto it = m_threadNames.constBegin(); it != m_threadNames.constEnd(); ++it) {
+            traceEvents.append(QJsonObject({{QStringLiteral("name"), QStringLiteral("thread_name")},
+                                            {QStringLiteral("ph"), QStringLiteral("M")},
+                                            {QStringLiteral("pid"), pid},
+                                            {QStringLiteral("tid"), it.key()},
+                                            {QStringLiteral("args"), QJsonObject({{QStringLiteral("name"), it.value()}})}}));
+        }
+
+        for (const Event &event : m_events) {
+            // Microseconds, as Chrome traces expect
+            QJsonObject object({{QStringLiteral("name"), event.name},
+                                {QStringLiteral("cat"), QStringLiteral("startup")},
+                                {QStringLiteral("ts"), event.start / 1000.0},
+                                {QStringLiteral("pid"), pid},
+                                {QStringLiteral("tid"), event.thread}});
+            if (event.mark) {
+                object[QStringLiteral("ph")] = QStringLiteral("i");
+                object[QStringLiteral("s")] = QStringLiteral("p");
+            } else if (event.duration >= 0) {
+                object[QStringLiteral("ph")] = QStringLiteral("X");
+                object[QStringLiteral("dur")] = event.duration / 1000.0;
+            } else {
+                // Still running when written: only its start is known
+                object[QStringLiteral("ph")] = QStringLiteral("B");
+            }
+            traceEvents.append(object);
+        }
+    }
+
+    QSaveFile file(m_outputFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Can't write the startup profile" << m_outputFile << file.errorString();
+        return;
+    }
+    const QJsonObject trace({{QStringLiteral("traceEvents"), traceEvents},
+                             {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")}});
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Can't write the startup profile" << m_outputFile << file.errorString();
+        return;
+    }
+    qWarning() << "Startup profile written to" << m_outputFile;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+class QQuickWindow;
+
+/**
+ * Timeline of the start of the application for --profile-startup, on a monotonic clock
+ * starting in main(). Written as a Chrome trace (chrome://tracing, Perfetto) once the first
+ * frame is on screen and core is connected, or when quitting.
+ *
+ * The Mycroft plugin doesn't link to the application: it finds the profiler as the
+ * startupProfiler property of the application and calls its invokable methods.
+ */
+class StartupProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StartupProfiler(QObject *parent = nullptr);
+
+    /**
+     * Where the trace is written, nothing is written if empty
+     */
+    QString outputFile() const;
+    void setOutputFile(const QString &fileName);
+
+    /**
+     * Phases nest if begun while another is running, names are unique among running phases
+     */
+    Q_INVOKABLE void begin(const QString &name);
+    Q_INVOKABLE void end(const QString &name);
+
+    /**
+     * A point in time, only the first mark of each name is kept
+     */
+    Q_INVOKABLE void mark(const QString &name);
+
+    /**
+     * Marks the first frame swapped by window
+     */
+    void watchWindow(QQuickWindow *window);
+
+public Q_SLOTS:
+    /**
+     * Writes the trace once, with what was recorded so far
+     */
+    void write();
+
+private:
+    struct Event {
+        QString name;
+        qint64 start = 0;
+        // -1 while running
+        qint64 duration = -1;
+        int thread = 0;
+        bool mark = false;
+    };
+
+    int threadId();
+
+    QElapsedTimer m_clock;
+    QString m_outputFile;
+    bool m_written = false;
+
+    // Marks may come from the render thread
+    QMutex m_mutex;
+    QVector<Event> m_events;
+    QHash<QString, int> m_running;
+    QHash<Qt::HANDLE, int> m_threads;
+    QHash<int, QString> m_threadNames;
+    QSet<QString> m_marks;
+    QSet<QString> m_awaitedMarks;
+};
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QBuffer>
+#include <QTemporaryDir>
+#include "../import/blobstore.h"
+
+class BlobStoreTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testRawImage();
+    void testEncodedImage();
+    void testSharedReferences();
+    void testInvalidBlobs();
+
+private:
+    void writeSegment(const QString &name, const QByteArray &data);
+
+    QTemporaryDir m_dir;
+};
+
+void BlobStoreTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    BlobStore::instance()->setSegmentDirectory(m_dir.path());
+}
+
+void BlobStoreTest::writeSegment(const QString &name, const QByteArray &data)
+{
+    QFile file(QDir(m_dir.path()).filePath(name));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+}
+
+void BlobStoreTest::testRawImage()
+{
+    // 2x2 rgba, lines padded to 12 bytes
+    QByteArray pixels(24, '\0');
+    pixels[0] = char(255);
+    pixels[3] = char(255);
+    pixels[18] = char(255);
+    pixels[19] = char(255);
+    writeSegment(QStringLiteral("raw"), pixels);
+
+    QSignalSpy releasedSpy(BlobStore::instance(), &BlobStore::blobReleased);
+    const QVariantMap descriptor({{QStringLiteral("size"), 24}, {QStringLiteral("format"), QStringLiteral("rgba8888")},
+                                  {QStringLiteral("width"), 2}, {QStringLiteral("height"), 2}, {QStringLiteral("bytes_per_line"), 12}});
+    QCOMPARE(BlobStore::instance()->acquire(QStringLiteral("raw"), descriptor), QUrl(QStringLiteral("image://mycroftblob/raw")));
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("raw")), 1);
+
+    BlobImageProvider provider;
+    QSize size;
+    QImage image = provider.requestImage(QStringLiteral("raw"), &size, QSize());
+    QCOMPARE(size, QSize(2, 2));
+    QCOMPARE(image.bytesPerLine(), 12);
+    QCOMPARE(image.pixel(0, 0), qRgba(255, 0, 0, 255));
+    QCOMPARE(image.pixel(1, 1), qRgba(0, 0, 255, 255));
+    QCOMPARE(image.pixel(1, 0), qRgba(0, 0, 0, 0));
+
+    // The image keeps the segment mapped after the session value is gone
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("raw")), 2);
+    BlobStore::instance()->release(QStringLiteral("raw"));
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("raw")), 1);
+    QVERIFY(releasedSpy.isEmpty());
+
+    image = QImage();
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("raw")), 0);
+    QCOMPARE(releasedSpy.count(), 1);
+    QCOMPARE(releasedSpy.first().first().toString(), QStringLiteral("raw"));
+
+    // Unmapped, so unknown to the provider
+    QVERIFY(provider.requestImage(QStringLiteral("raw"), &size, QSize()).isNull());
+}
+
+void BlobStoreTest::testEncodedImage()
+{
+    QImage source(400, 200, QImage::Format_RGB32);
+    source.fill(Qt::green);
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(source.save(&buffer, "PNG"));
+    writeSegment(QStringLiteral("chart"), png);
+
+    const QVariantMap descriptor({{QStringLiteral("size"), png.size()}, {QStringLiteral("format"), QStringLiteral("png")}});
+    QVERIFY(!BlobStore::instance()->acquire(QStringLiteral("chart"), descriptor).isEmpty());
+
+    QSize size;
+    QImage image = BlobStore::instance()->image(QStringLiteral("chart"), &size, QSize());
+    QCOMPARE(size, QSize(400, 200));
+    QCOMPARE(image.pixel(10, 10), QColor(Qt::green).rgb());
+
+    // Decoded to the requested size, and never upscaled
+    image = BlobStore::instance()->image(QStringLiteral("chart"), &size, QSize(100, 0));
+    QCOMPARE(size, QSize(100, 50));
+    image = BlobStore::instance()->image(QStringLiteral("chart"), &size, QSize(800, 800));
+    QCOMPARE(size, QSize(400, 200));
+
+    // Decoded images don't reference the segment
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("chart")), 1);
+    BlobStore::instance()->release(QStringLiteral("chart"));
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("chart")), 0);
+}
+
+void BlobStoreTest::testSharedReferences()
+{
+    writeSegment(QStringLiteral("shared"), QByteArray(16, 'x'));
+    const QVariantMap descriptor({{QStringLiteral("size"), 16}, {QStringLiteral("format"), QStringLiteral("grayscale8")},
+                                  {QStringLiteral("width"), 4}, {QStringLiteral("height"), 4}, {QStringLiteral("bytes_per_line"), 4}});
+
+    QSignalSpy releasedSpy(BlobStore::instance(), &BlobStore::blobReleased);
+    QVERIFY(!BlobStore::instance()->acquire(QStringLiteral("shared"), descriptor).isEmpty());
+    // Mapped once, the descriptor of later references is not used
+    QVERIFY(!BlobStore::instance()->acquire(QStringLiteral("shared"), QVariantMap()).isEmpty());
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("shared")), 2);
+
+    BlobStore::instance()->release(QStringLiteral("shared"));
+    QVERIFY(releasedSpy.isEmpty());
+    BlobStore::instance()->release(QStringLiteral("shared"));
+    QCOMPARE(releasedSpy.count(), 1);
+
+    // Releasing what isn't mapped does nothing
+    BlobStore::instance()->release(QStringLiteral("shared"));
+    QCOMPARE(releasedSpy.count(), 1);
+}
+
+void BlobStoreTest::testInvalidBlobs()
+{
+    writeSegment(QStringLiteral("small"), QByteArray(8, 'x'));
+    const QVariantMap raw({{QStringLiteral("size"), 8}, {QStringLiteral("format"), QStringLiteral("rgba8888")},
+                           {QStringLiteral("width"), 2}, {QStringLiteral("height"), 2}, {QStringLiteral("bytes_per_line"), 8}});
+
+    // Outside of the segment directory
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Invalid blob name")));
+    QVERIFY(BlobStore::instance()->acquire(QStringLiteral("../small"), raw).isEmpty());
+
+    // Pixels past the end of the segment
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Invalid geometry")));
+    QVERIFY(BlobStore::instance()->acquire(QStringLiteral("small"), raw).isEmpty());
+
+    // Segment smaller than announced
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Can't open")));
+    QVERIFY(BlobStore::instance()->acquire(QStringLiteral("small"), {{QStringLiteral("size"), 64}, {QStringLiteral("format"), QStringLiteral("png")}}).isEmpty());
+
+    // No segment
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Can't open")));
+    QVERIFY(BlobStore::instance()->acquire(QStringLiteral("missing"), {{QStringLiteral("size"), 8}, {QStringLiteral("format"), QStringLiteral("png")}}).isEmpty());
+
+    QCOMPARE(BlobStore::instance()->refCount(QStringLiteral("small")), 0);
+}
+
+QTEST_MAIN(BlobStoreTest);
+
+#include "blobstoretest.moc"
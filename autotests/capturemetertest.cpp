@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QTemporaryFile>
+#include <cmath>
+#include "wavfile.h"
+#include "../import/capturemeter.h"
+
+class CaptureMeterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTone();
+    void testSilence();
+    void testAnalysisRate();
+
+private:
+    // 16 bit mono WAV with a sine of the given frequency and amplitude
+    QString writeWav(QTemporaryFile &file, int sampleRate, qreal frequency, qreal amplitude, int seconds);
+};
+
+QString CaptureMeterTest::writeWav(QTemporaryFile &file, int sampleRate, qreal frequency, qreal amplitude, int seconds)
+{
+    const QByteArray wav = WavFile::sine(sampleRate, 1, sampleRate * seconds, frequency, amplitude);
+
+    file.setFileTemplate(QDir::tempPath() + QStringLiteral("/capturemetertest-XXXXXX.wav"));
+    if (!file.open()) {
+        return QString();
+    }
+    file.write(wav);
+    file.flush();
+    return file.fileName();
+}
+
+void CaptureMeterTest::testTone()
+{
+    QTemporaryFile file;
+    const QString path = writeWav(file, 16000, 1500, 0.5, 1);
+    QVERIFY(!path.isEmpty());
+
+    CaptureMeter meter;
+    meter.setInputFile(path);
+    QSignalSpy levelsSpy(&meter, &CaptureMeter::levelsChanged);
+
+    meter.start();
+    QVERIFY(meter.isRunning());
+    QVERIFY(levelsSpy.wait());
+
+    // Average of the absolute value of a sine: 2 / pi of its amplitude
+    QVERIFY(qAbs(meter.level() - 0.5 * 2 / M_PI) < 0.02);
+
+    // 1500Hz is in the 6th of the 8 bands between 100 and 4000Hz
+    const QVector<double> bands = meter.bands();
+    QCOMPARE(bands.count(), int(CaptureMeter::s_bandCount));
+    const int loudest = std::max_element(bands.constBegin(), bands.constEnd()) - bands.constBegin();
+    QCOMPARE(loudest, 5);
+    QVERIFY(bands[5] > bands[0] + 0.3);
+
+    meter.stop();
+    QVERIFY(!meter.isRunning());
+    QCOMPARE(meter.level(), 0.0);
+}
+
+void CaptureMeterTest::testSilence()
+{
+    QTemporaryFile file;
+    const QString path = writeWav(file, 16000, 1000, 0, 1);
+    QVERIFY(!path.isEmpty());
+
+    CaptureMeter meter;
+    meter.setInputFile(path);
+    QSignalSpy levelsSpy(&meter, &CaptureMeter::levelsChanged);
+
+    meter.start();
+    QVERIFY(levelsSpy.wait());
+    QCOMPARE(meter.level(), 0.0);
+    for (const auto band : meter.bands()) {
+        QCOMPARE(band, 0.0);
+    }
+}
+
+void CaptureMeterTest::testAnalysisRate()
+{
+    QTemporaryFile file;
+    const QString path = writeWav(file, 16000, 440, 0.3, 1);
+    QVERIFY(!path.isEmpty());
+
+    CaptureMeter meter;
+    meter.setInputFile(path);
+
+    QElapsedTimer timer;
+    timer.start();
+    meter.start();
+    // Past the end of the file, which loops
+    QTest::qWait(1500);
+    meter.stop();
+
+    // Never more than one analysis every 40ms, whatever the frame rate of the input
+    QVERIFY(meter.analyzedFrames() > 0);
+    QVERIFY(meter.analyzedFrames() <= timer.elapsed() / 40 + 1);
+}
+
+QTEST_MAIN(CaptureMeterTest);
+
+#include "capturemetertest.moc"
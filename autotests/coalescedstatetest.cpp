@@ -0,0 +1,138 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include "../import/coalescedstate.h"
+
+class CoalescedStateTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTransitions();
+    void testUnchanged();
+    void testBurst();
+    void testDebounce();
+    void testDebounceExpired();
+};
+
+void CoalescedStateTest::testTransitions()
+{
+    CoalescedState state;
+    QSignalSpy changedSpy(&state, &CoalescedState::valueChanged);
+
+    state.setValue(true);
+    // Notified at the end of the event loop iteration
+    QVERIFY(!state.value());
+    QVERIFY(changedSpy.isEmpty());
+    QTRY_COMPARE(changedSpy.count(), 1);
+    QVERIFY(state.value());
+
+    state.setValue(false);
+    QTRY_COMPARE(changedSpy.count(), 2);
+    QVERIFY(!state.value());
+}
+
+void CoalescedStateTest::testUnchanged()
+{
+    CoalescedState state;
+    QSignalSpy changedSpy(&state, &CoalescedState::valueChanged);
+
+    // e.g. record_end without a record_begin
+    state.setValue(false);
+    QTest::qWait(20);
+    QVERIFY(changedSpy.isEmpty());
+
+    state.setValue(true);
+    QTRY_COMPARE(changedSpy.count(), 1);
+    // e.g. wakeword then record_begin, in separate iterations
+    state.setValue(true);
+    QTest::qWait(20);
+    QCOMPARE(changedSpy.count(), 1);
+}
+
+void CoalescedStateTest::testBurst()
+{
+    CoalescedState state;
+    QSignalSpy changedSpy(&state, &CoalescedState::valueChanged);
+
+    // Several messages handled in the same iteration
+    state.setValue(true);
+    state.setValue(false);
+    state.setValue(true);
+    QTRY_COMPARE(changedSpy.count(), 1);
+    QVERIFY(state.value());
+
+    // Back to where it was: nothing to notify
+    state.setValue(false);
+    state.setValue(true);
+    QTest::qWait(20);
+    QCOMPARE(changedSpy.count(), 1);
+    QVERIFY(state.value());
+}
+
+void CoalescedStateTest::testDebounce()
+{
+    CoalescedState state;
+    state.setDebounceInterval(200);
+    QSignalSpy changedSpy(&state, &CoalescedState::valueChanged);
+
+    state.setValue(true);
+    QTRY_COMPARE(changedSpy.count(), 1);
+
+    // Chunks of a spoken answer
+    for (int i = 0; i < 3; ++i) {
+        state.setValue(false);
+        QTest::qWait(50);
+        QVERIFY(state.value());
+        state.setValue(true);
+        QTest::qWait(20);
+    }
+    QCOMPARE(changedSpy.count(), 1);
+
+    state.setValue(false);
+    QTRY_COMPARE(changedSpy.count(), 2);
+    QVERIFY(!state.value());
+}
+
+void CoalescedStateTest::testDebounceExpired()
+{
+    CoalescedState state;
+    state.setDebounceInterval(100);
+    QSignalSpy changedSpy(&state, &CoalescedState::valueChanged);
+
+    state.setValue(true);
+    QTRY_COMPARE(changedSpy.count(), 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    state.setValue(false);
+    QTest::qWait(50);
+    // Repeated end messages don't extend the window
+    state.setValue(false);
+    QTRY_COMPARE_WITH_TIMEOUT(changedSpy.count(), 2, 90);
+    // Coarse timers may fire a bit early
+    QVERIFY(timer.elapsed() >= 90);
+
+    // Starting again isn't debounced
+    state.setValue(true);
+    QTRY_COMPARE(changedSpy.count(), 3);
+}
+
+QTEST_MAIN(CoalescedStateTest);
+
+#include "coalescedstatetest.moc"
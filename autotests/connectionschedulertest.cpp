@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include "../import/connectionscheduler.h"
+
+class ConnectionSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testImmediateFirstRetry();
+    void testBackoff();
+    void testUnstableConnection();
+    void testJitter();
+    void testFastPath();
+    void testMetrics();
+};
+
+void ConnectionSchedulerTest::testImmediateFirstRetry()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 100, 1000);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+
+    QCOMPARE(backoff.nextDelay(), 0);
+    QElapsedTimer timer;
+    timer.start();
+    backoff.schedule();
+    QVERIFY(backoff.isPending());
+    QVERIFY(retrySpy.wait(1000));
+    QVERIFY(timer.elapsed() < 50);
+    QCOMPARE(backoff.attempts(), 1);
+    QVERIFY(!backoff.isPending());
+}
+
+void ConnectionSchedulerTest::testBackoff()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 10, 100);
+    backoff.setStableInterval(50);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+
+    // 0, 10, 20, 40, 80, then capped at 100
+    const QVector<int> expected({0, 10, 20, 40, 80, 100, 100});
+    for (const int delay : expected) {
+        QCOMPARE(backoff.nextDelay(), delay);
+        backoff.schedule();
+        // Scheduling again while pending doesn't move the attempt
+        backoff.schedule();
+        QVERIFY(retrySpy.wait(1000));
+    }
+    QCOMPARE(backoff.attempts(), expected.count());
+
+    // Reset once the connection stayed up
+    backoff.succeeded();
+    QCOMPARE(backoff.attempts(), expected.count());
+    QTRY_COMPARE(backoff.attempts(), 0);
+    QCOMPARE(backoff.nextDelay(), 0);
+}
+
+void ConnectionSchedulerTest::testUnstableConnection()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 10, 1000);
+    backoff.setStableInterval(200);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+
+    // A server accepting connections and dropping them right away
+    for (int i = 1; i <= 4; ++i) {
+        backoff.schedule();
+        QVERIFY(retrySpy.wait(1000));
+        backoff.succeeded();
+        QCOMPARE(backoff.attempts(), i);
+    }
+    QCOMPARE(backoff.nextDelay(), 80);
+
+    // Dropped before the stable interval: still backing off
+    QTest::qWait(100);
+    backoff.schedule();
+    QVERIFY(backoff.isPending());
+    QVERIFY(retrySpy.wait(1000));
+    QCOMPARE(backoff.attempts(), 5);
+    backoff.succeeded();
+    QTest::qWait(300);
+    QCOMPARE(backoff.attempts(), 0);
+}
+
+void ConnectionSchedulerTest::testJitter()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 200, 200);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+    backoff.schedule();
+    QVERIFY(retrySpy.wait(1000));
+
+    // Never earlier than half of the delay, never later than the delay
+    qint64 shortest = 1000;
+    qint64 longest = 0;
+    for (int i = 0; i < 10; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        backoff.schedule();
+        QVERIFY(retrySpy.wait(1000));
+        shortest = qMin(shortest, timer.elapsed());
+        longest = qMax(longest, timer.elapsed());
+    }
+    QVERIFY(shortest >= 95);
+    QVERIFY(longest <= 250);
+    QVERIFY(longest > shortest);
+}
+
+void ConnectionSchedulerTest::testFastPath()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 10000, 10000);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+    backoff.schedule();
+    QVERIFY(retrySpy.wait(1000));
+
+    // Nothing pending: nothing to fire
+    backoff.retryNow();
+    QCOMPARE(retrySpy.count(), 1);
+
+    backoff.schedule();
+    QVERIFY(backoff.isPending());
+    backoff.retryNow();
+    QCOMPARE(retrySpy.count(), 2);
+    QVERIFY(!backoff.isPending());
+}
+
+void ConnectionSchedulerTest::testMetrics()
+{
+    ReconnectBackoff backoff(QStringLiteral("test"), 10, 100);
+    QSignalSpy retrySpy(&backoff, &ReconnectBackoff::retry);
+
+    QVERIFY(backoff.metrics()[QStringLiteral("connected")].toBool());
+    QCOMPARE(backoff.metrics()[QStringLiteral("outages")].toInt(), 0);
+
+    backoff.schedule();
+    QVERIFY(retrySpy.wait(1000));
+    backoff.schedule();
+    QVERIFY(retrySpy.wait(1000));
+    QVERIFY(!backoff.metrics()[QStringLiteral("connected")].toBool());
+    QCOMPARE(backoff.metrics()[QStringLiteral("attempts")].toInt(), 2);
+    backoff.succeeded();
+
+    const QVariantMap metrics = backoff.metrics();
+    QVERIFY(metrics[QStringLiteral("connected")].toBool());
+    QCOMPARE(metrics[QStringLiteral("outages")].toInt(), 1);
+    QVERIFY(metrics[QStringLiteral("lastOutage")].toLongLong() >= 5);
+
+    QStringList events;
+    for (const auto &event : metrics[QStringLiteral("timeline")].toList()) {
+        events << event.toMap()[QStringLiteral("event")].toString();
+    }
+    QCOMPARE(events, QStringList({QStringLiteral("down"), QStringLiteral("retry"), QStringLiteral("retry"), QStringLiteral("up")}));
+}
+
+QTEST_MAIN(ConnectionSchedulerTest);
+
+#include "connectionschedulertest.moc"
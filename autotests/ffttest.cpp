@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QVector>
+#include <cmath>
+#include "../import/thirdparty/fft.h"
+
+class FFTTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTransform_data();
+    void testTransform();
+    void benchmarkMagnitudes_data();
+    void benchmarkMagnitudes();
+
+private:
+    QVector<float> testSignal(int size) const;
+};
+
+QVector<float> FFTTest::testSignal(int size) const
+{
+    QVector<float> samples(size);
+    for (int i = 0; i < size; ++i) {
+        samples[i] = 0.5 * std::sin(2 * PI * 17 * i / size) + 0.25 * std::cos(2 * PI * 3.3 * i / size)
+            + (i % 7) * 0.01;
+    }
+    return samples;
+}
+
+void FFTTest::testTransform_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("4") << 4;
+    QTest::newRow("64") << 64;
+    QTest::newRow("512") << 512;
+    QTest::newRow("2048") << 2048;
+}
+
+void FFTTest::testTransform()
+{
+    QFETCH(int, size);
+
+    const QVector<float> samples = testSignal(size);
+    RealFFT fft(size);
+    QVector<Complex> bins(size / 2 + 1);
+    QVector<float> magnitudes(size / 2);
+
+    fft.transform(samples.constData(), bins.data());
+    fft.magnitudes(samples.constData(), magnitudes.data());
+
+    // Compare with a plain DFT in double precision
+    for (int k = 0; k <= size / 2; ++k) {
+        std::complex<double> expected;
+        for (int t = 0; t < size; ++t) {
+            expected += std::polar(1.0, -2 * PI * k * t / size) * double(samples[t]);
+        }
+
+        QVERIFY2(std::abs(expected - std::complex<double>(bins[k])) < 1e-3 * size,
+                 qPrintable(QStringLiteral("bin %1").arg(k)));
+        if (k < size / 2) {
+            QVERIFY(std::abs(std::abs(expected) - magnitudes[k]) < 1e-3 * size);
+        }
+    }
+}
+
+void FFTTest::benchmarkMagnitudes_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("512") << 512;
+    QTest::newRow("1024") << 1024;
+    QTest::newRow("2048") << 2048;
+}
+
+void FFTTest::benchmarkMagnitudes()
+{
+    QFETCH(int, size);
+
+    const QVector<float> samples = testSignal(size);
+    RealFFT fft(size);
+    QVector<float> magnitudes(size / 2);
+
+    QBENCHMARK {
+        fft.magnitudes(samples.constData(), magnitudes.data());
+    }
+}
+
+QTEST_GUILESS_MAIN(FFTTest);
+
+#include "ffttest.moc"
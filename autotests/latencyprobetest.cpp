@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include "../import/latencyprobe.h"
+#include "../import/messagesocket.h"
+
+class LatencyProbeTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testPercentiles();
+    void testRollingWindow();
+    void testJitter();
+    void testThresholds();
+    void testLocalLink();
+};
+
+void LatencyProbeTest::testPercentiles()
+{
+    MessageSocket socket;
+    LatencyProbe probe(&socket);
+    QCOMPARE(probe.p50(), qreal(-1));
+
+    for (int i = 1; i <= 100; ++i) {
+        probe.addSample(i);
+    }
+    QCOMPARE(probe.samples(), 100);
+    QCOMPARE(probe.p50(), qreal(50));
+    QCOMPARE(probe.p95(), qreal(95));
+    QCOMPARE(probe.p99(), qreal(99));
+    QCOMPARE(probe.lastRtt(), qreal(100));
+
+    // 1, 2, 3-5, 6-10, 11-20, 21-50, 51-100
+    const QVariantList histogram = probe.histogram();
+    QCOMPARE(histogram.count(), probe.histogramBounds().count() + 1);
+    const QVector<int> expected({1, 1, 3, 5, 10, 30, 50, 0, 0, 0, 0, 0});
+    for (int i = 0; i < expected.count(); ++i) {
+        QCOMPARE(histogram[i].toInt(), expected[i]);
+    }
+}
+
+void LatencyProbeTest::testRollingWindow()
+{
+    MessageSocket socket;
+    LatencyProbe probe(&socket);
+
+    for (int i = 0; i < 1000; ++i) {
+        probe.addSample(1000);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        probe.addSample(1);
+    }
+
+    // Old samples are gone from both the percentiles and the histogram
+    QCOMPARE(probe.p99(), qreal(1));
+    int total = 0;
+    for (const auto &count : probe.histogram()) {
+        total += count.toInt();
+    }
+    QCOMPARE(total, probe.samples());
+    QCOMPARE(probe.histogram().first().toInt(), probe.samples());
+}
+
+void LatencyProbeTest::testJitter()
+{
+    MessageSocket socket;
+    LatencyProbe probe(&socket);
+
+    for (int i = 0; i < 200; ++i) {
+        probe.addSample(20);
+    }
+    QCOMPARE(probe.jitter(), qreal(0));
+
+    // Alternating by 10ms converges to 10ms of jitter
+    for (int i = 0; i < 200; ++i) {
+        probe.addSample(i % 2 ? 30 : 20);
+    }
+    QVERIFY(qAbs(probe.jitter() - 10) < 0.1);
+}
+
+void LatencyProbeTest::testThresholds()
+{
+    MessageSocket socket;
+    LatencyProbe probe(&socket);
+    probe.setDegradedThreshold(100);
+    QSignalSpy degradedSpy(&probe, &LatencyProbe::latencyDegraded);
+    QSignalSpy recoveredSpy(&probe, &LatencyProbe::latencyRecovered);
+
+    for (int i = 0; i < 20; ++i) {
+        probe.addSample(10);
+    }
+    QVERIFY(!probe.isDegraded());
+
+    for (int i = 0; i < 20; ++i) {
+        probe.addSample(300);
+    }
+    QVERIFY(probe.isDegraded());
+    QCOMPARE(degradedSpy.count(), 1);
+
+    // Just under the threshold isn't enough to recover, not to flap around it
+    for (int i = 0; i < 200; ++i) {
+        probe.addSample(90 + i % 2);
+    }
+    QVERIFY(probe.isDegraded());
+    QCOMPARE(recoveredSpy.count(), 0);
+
+    for (int i = 0; i < 200; ++i) {
+        probe.addSample(10);
+    }
+    QVERIFY(!probe.isDegraded());
+    QCOMPARE(recoveredSpy.count(), 1);
+    QCOMPARE(degradedSpy.count(), 1);
+}
+
+void LatencyProbeTest::testLocalLink()
+{
+    QWebSocketServer server(QStringLiteral("latencyprobetest"), QWebSocketServer::NonSecureMode);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QList<QWebSocket *> serverSockets;
+    connect(&server, &QWebSocketServer::newConnection, this, [&]() {
+        serverSockets << server.nextPendingConnection();
+    });
+
+    MessageSocket socket;
+    LatencyProbe probe(&socket);
+    probe.setInterval(20);
+    socket.open(QUrl(QStringLiteral("ws://localhost:%1").arg(server.serverPort())));
+
+    // Pongs are sent by the server websocket implementation
+    QTRY_VERIFY_WITH_TIMEOUT(probe.samples() >= 5, 5000);
+    QVERIFY(probe.p50() >= 0);
+    QVERIFY(probe.p50() < 100);
+    QCOMPARE(probe.lostPings(), 0);
+
+    socket.close();
+    qDeleteAll(serverSockets);
+}
+
+QTEST_MAIN(LatencyProbeTest);
+
+#include "latencyprobetest.moc"
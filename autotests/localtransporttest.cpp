@@ -0,0 +1,346 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTemporaryDir>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include "../import/latencyprobe.h"
+#include "../import/messagesocket.h"
+
+// Stand-in for a server exposing the local transport: echoes every frame back, answers pings
+class LocalEchoServer : public QLocalServer
+{
+public:
+    explicit LocalEchoServer(QObject *parent = nullptr)
+        : QLocalServer(parent)
+    {
+        connect(this, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket *connection = nextPendingConnection()) {
+                connections << connection;
+                connect(connection, &QLocalSocket::readyRead, this, [this, connection]() {
+                    QByteArray &buffer = m_buffers[connection];
+                    buffer += connection->readAll();
+                    while (buffer.size() >= MessageSocket::s_headerSize) {
+                        const int size = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(buffer.constData()));
+                        if (buffer.size() < MessageSocket::s_headerSize + size) {
+                            break;
+                        }
+                        received << buffer.left(MessageSocket::s_headerSize + size);
+                        if (buffer.at(4) == char(MessageSocket::PingFrame)) {
+                            if (answerPings) {
+                                connection->write(MessageSocket::frame(MessageSocket::PongFrame, buffer.mid(MessageSocket::s_headerSize, size)));
+                            }
+                        } else if (echo) {
+                            connection->write(received.last());
+                        }
+                        buffer.remove(0, MessageSocket::s_headerSize + size);
+                    }
+                });
+            }
+        });
+    }
+
+    QList<QLocalSocket *> connections;
+    QList<QByteArray> received;
+    bool echo = true;
+    bool answerPings = true;
+
+private:
+    QHash<QLocalSocket *, QByteArray> m_buffers;
+};
+
+class LocalTransportTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testSocketPath();
+    void testFraming();
+    void testOversizedFrame();
+    void testPing();
+    void testLatencyProbe();
+    void testFallback();
+    void testBenchmark_data();
+    void testBenchmark();
+
+private:
+    QTemporaryDir m_dir;
+    LocalEchoServer *m_localServer;
+    QWebSocketServer *m_webSocketServer;
+    QUrl m_localUrl;
+    QUrl m_webSocketUrl;
+};
+
+void LocalTransportTest::initTestCase()
+{
+    qRegisterMetaType<QAbstractSocket::SocketError>();
+    qRegisterMetaType<QAbstractSocket::SocketState>();
+    QVERIFY(m_dir.isValid());
+
+    m_localUrl = QUrl(QStringLiteral("ws://0.0.0.0:8181/core"));
+    m_localServer = new LocalEchoServer(this);
+    QVERIFY(m_localServer->listen(MessageSocket::localSocketPath(m_dir.path(), m_localUrl)));
+
+    m_webSocketServer = new QWebSocketServer(QStringLiteral("localtransporttest"), QWebSocketServer::NonSecureMode, this);
+    QVERIFY(m_webSocketServer->listen(QHostAddress::LocalHost));
+    m_webSocketUrl = QUrl(QStringLiteral("ws://127.0.0.1:%1/core").arg(m_webSocketServer->serverPort()));
+    connect(m_webSocketServer, &QWebSocketServer::newConnection, this, [this]() {
+        while (QWebSocket *connection = m_webSocketServer->nextPendingConnection()) {
+            connect(connection, &QWebSocket::textMessageReceived, connection, &QWebSocket::sendTextMessage);
+        }
+    });
+}
+
+void LocalTransportTest::testSocketPath()
+{
+    QCOMPARE(MessageSocket::localSocketPath(QStringLiteral("/run/ovos"), QUrl(QStringLiteral("ws://0.0.0.0:8181/core"))),
+             QStringLiteral("/run/ovos/core-8181.sock"));
+    QCOMPARE(MessageSocket::localSocketPath(QStringLiteral("/run/ovos"), QUrl(QStringLiteral("ws://localhost:18181/gui"))),
+             QStringLiteral("/run/ovos/gui-18181.sock"));
+    QVERIFY(MessageSocket::localSocketPath(QStringLiteral("/run/ovos"), QUrl(QStringLiteral("ws://192.168.1.4:8181/core"))).isEmpty());
+    QVERIFY(MessageSocket::localSocketPath(QString(), QUrl(QStringLiteral("ws://0.0.0.0:8181/core"))).isEmpty());
+}
+
+void LocalTransportTest::testFraming()
+{
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    QSignalSpy connectedSpy(&socket, &MessageSocket::connected);
+    QSignalSpy textSpy(&socket, &MessageSocket::textMessageReceived);
+    const int connections = m_localServer->connections.count();
+    //unix sockets usually connect right away
+    socket.open(m_localUrl);
+    QVERIFY(socket.isLocal());
+    QTRY_COMPARE(connectedSpy.count(), 1);
+    QCOMPARE(socket.state(), QAbstractSocket::ConnectedState);
+    QTRY_COMPARE(m_localServer->connections.count(), connections + 1);
+
+    m_localServer->received.clear();
+    m_localServer->echo = false;
+    socket.sendTextMessage(QStringLiteral("{\"type\": \"hello\"}"));
+    socket.sendBinaryMessage(QByteArray("{}"));
+    QTRY_COMPARE(m_localServer->received.count(), 2);
+    QCOMPARE(m_localServer->received[0], MessageSocket::frame(MessageSocket::TextFrame, QStringLiteral("{\"type\": \"hello\"}").toUtf8()));
+    QCOMPARE(m_localServer->received[1], MessageSocket::frame(MessageSocket::BinaryFrame, QByteArray("{}")));
+
+    //several frames in one write, binary ones skipped, then a frame split across writes
+    QLocalSocket *connection = m_localServer->connections.last();
+    connection->write(MessageSocket::frame(MessageSocket::TextFrame, "first")
+                      + MessageSocket::frame(MessageSocket::BinaryFrame, "skipped")
+                      + MessageSocket::frame(MessageSocket::TextFrame, "second"));
+    QTRY_COMPARE(textSpy.count(), 2);
+    const QByteArray split = MessageSocket::frame(MessageSocket::TextFrame, "third");
+    connection->write(split.left(3));
+    connection->flush();
+    QTest::qWait(50);
+    QCOMPARE(textSpy.count(), 2);
+    connection->write(split.mid(3));
+    QTRY_COMPARE(textSpy.count(), 3);
+    QCOMPARE(textSpy[0].first().toString(), QStringLiteral("first"));
+    QCOMPARE(textSpy[1].first().toString(), QStringLiteral("second"));
+    QCOMPARE(textSpy[2].first().toString(), QStringLiteral("third"));
+
+    QSignalSpy disconnectedSpy(&socket, &MessageSocket::disconnected);
+    socket.close();
+    QTRY_COMPARE(disconnectedSpy.count(), 1);
+    QCOMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+    m_localServer->echo = true;
+}
+
+void LocalTransportTest::testOversizedFrame()
+{
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    QSignalSpy connectedSpy(&socket, &MessageSocket::connected);
+    QSignalSpy errorSpy(&socket, &MessageSocket::error);
+    const int connections = m_localServer->connections.count();
+    socket.open(m_localUrl);
+    QTRY_COMPARE(connectedSpy.count(), 1);
+    QTRY_COMPARE(m_localServer->connections.count(), connections + 1);
+
+    QByteArray header(MessageSocket::s_headerSize, '\0');
+    qToBigEndian(MessageSocket::s_maxFrameSize + 1, reinterpret_cast<uchar *>(header.data()));
+    header[4] = char(MessageSocket::TextFrame);
+    m_localServer->connections.last()->write(header);
+
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.first().first().value<QAbstractSocket::SocketError>(), QAbstractSocket::DatagramTooLargeError);
+    QCOMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+}
+
+void LocalTransportTest::testPing()
+{
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    QSignalSpy connectedSpy(&socket, &MessageSocket::connected);
+    QSignalSpy pongSpy(&socket, &MessageSocket::pong);
+    const int connections = m_localServer->connections.count();
+    socket.open(m_localUrl);
+    QTRY_COMPARE(connectedSpy.count(), 1);
+    QTRY_COMPARE(m_localServer->connections.count(), connections + 1);
+
+    m_localServer->received.clear();
+    socket.ping(QByteArray("serial"));
+    QTRY_COMPARE(pongSpy.count(), 1);
+    QCOMPARE(pongSpy.first().at(1).toByteArray(), QByteArray("serial"));
+    QCOMPARE(m_localServer->received.first(), MessageSocket::frame(MessageSocket::PingFrame, "serial"));
+
+    //pings from the server are answered too
+    m_localServer->echo = false;
+    m_localServer->connections.last()->write(MessageSocket::frame(MessageSocket::PingFrame, "server"));
+    QTRY_COMPARE(m_localServer->received.count(), 2);
+    QCOMPARE(m_localServer->received.last(), MessageSocket::frame(MessageSocket::PongFrame, "server"));
+    m_localServer->echo = true;
+    socket.close();
+}
+
+void LocalTransportTest::testLatencyProbe()
+{
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    LatencyProbe probe(&socket);
+    probe.setInterval(20);
+    socket.open(m_localUrl);
+    QVERIFY(socket.isLocal());
+
+    QTRY_VERIFY_WITH_TIMEOUT(probe.samples() >= 5, 5000);
+    QVERIFY(probe.p50() >= 0);
+    QVERIFY(probe.p50() < 100);
+    QCOMPARE(probe.lostPings(), 0);
+
+    //a server which doesn't answer them
+    m_localServer->answerPings = false;
+    QTRY_VERIFY_WITH_TIMEOUT(probe.lostPings() >= 3, 5000);
+    const int samples = probe.samples();
+    QTest::qWait(100);
+    QCOMPARE(probe.samples(), samples);
+    m_localServer->answerPings = true;
+    socket.close();
+}
+
+void LocalTransportTest::testFallback()
+{
+    //no socket for this url in the directory
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    QSignalSpy connectedSpy(&socket, &MessageSocket::connected);
+    socket.open(m_webSocketUrl);
+    QVERIFY(!socket.isLocal());
+    QTRY_COMPARE(connectedSpy.count(), 1);
+    socket.close();
+    QTRY_COMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+
+    //a stale file left by a server which is gone
+    const QString stalePath = MessageSocket::localSocketPath(m_dir.path(), m_webSocketUrl);
+    QFile staleFile(stalePath);
+    QVERIFY(staleFile.open(QIODevice::WriteOnly));
+    staleFile.close();
+
+    QSignalSpy errorSpy(&socket, &MessageSocket::error);
+    QSignalSpy stateSpy(&socket, &MessageSocket::stateChanged);
+    connectedSpy.clear();
+    socket.open(m_webSocketUrl);
+    QTRY_COMPARE(connectedSpy.count(), 1);
+    QVERIFY(!socket.isLocal());
+    QCOMPARE(socket.state(), QAbstractSocket::ConnectedState);
+    QVERIFY(errorSpy.isEmpty());
+    //the refused local connection must not look like a disconnection, users would retry and close the fallback
+    for (const auto &arguments : stateSpy) {
+        QVERIFY(arguments.first().value<QAbstractSocket::SocketState>() != QAbstractSocket::UnconnectedState);
+    }
+    QCOMPARE(stateSpy.last().first().value<QAbstractSocket::SocketState>(), QAbstractSocket::ConnectedState);
+    socket.close();
+    QFile::remove(stalePath);
+}
+
+void LocalTransportTest::testBenchmark_data()
+{
+    QTest::addColumn<bool>("local");
+    QTest::addColumn<bool>("burst");
+
+    QTest::newRow("unix socket round trip") << true << false;
+    QTest::newRow("loopback websocket round trip") << false << false;
+    QTest::newRow("unix socket burst") << true << true;
+    QTest::newRow("loopback websocket burst") << false << true;
+}
+
+void LocalTransportTest::testBenchmark()
+{
+    QFETCH(bool, local);
+    QFETCH(bool, burst);
+    const int roundTrips = 500;
+    const int burstSize = 2000;
+    const QString payload = QString(1024, QLatin1Char('x'));
+
+    MessageSocket socket;
+    socket.setLocalSocketDirectory(m_dir.path());
+    QSignalSpy connectedSpy(&socket, &MessageSocket::connected);
+    socket.open(local ? m_localUrl : m_webSocketUrl);
+    QCOMPARE(socket.isLocal(), local);
+    QTRY_COMPARE(connectedSpy.count(), 1);
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    QElapsedTimer timer;
+
+    if (!burst) {
+        //latency: one message in flight at a time
+        int remaining = roundTrips;
+        connect(&socket, &MessageSocket::textMessageReceived, &loop, [&](const QString &message) {
+            if (--remaining > 0) {
+                socket.sendTextMessage(message);
+            } else {
+                loop.quit();
+            }
+        });
+        timer.start();
+        socket.sendTextMessage(QStringLiteral("ping"));
+        timeout.start(30000);
+        loop.exec();
+        const qint64 elapsed = timer.nsecsElapsed();
+        QCOMPARE(remaining, 0);
+        QTest::setBenchmarkResult(qreal(elapsed) / roundTrips, QTest::WalltimeNanoseconds);
+        return;
+    }
+
+    //throughput: a burst of 1KiB messages, echoed back
+    int remaining = burstSize;
+    connect(&socket, &MessageSocket::textMessageReceived, &loop, [&]() {
+        if (--remaining == 0) {
+            loop.quit();
+        }
+    });
+    timer.start();
+    for (int i = 0; i < burstSize; ++i) {
+        socket.sendTextMessage(payload);
+    }
+    timeout.start(30000);
+    loop.exec();
+    const qint64 elapsed = timer.nsecsElapsed();
+    QCOMPARE(remaining, 0);
+    QTest::setBenchmarkResult(2.0 * burstSize * payload.size() / (elapsed / 1000000000.0), QTest::BytesPerSecond);
+}
+
+QTEST_MAIN(LocalTransportTest);
+
+#include "localtransporttest.moc"
@@ -0,0 +1,283 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QAudioDeviceInfo>
+#include <QQuickWindow>
+#include "wavfile.h"
+#include "../import/mediaservice.h"
+#include "../import/spectrumbuffer.h"
+
+class MediaServiceTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testInterTrackGap();
+    void testPositionRate();
+    void testPresentationMode();
+
+private:
+    // 1024 frames of 16 bit stereo sine as the probe delivers them
+    QAudioBuffer toneBuffer(qreal amplitude) const;
+    // 16 bit stereo WAV with a sine of the given frequency, returns its url
+    QString writeWav(const QString &name, qreal frequency, int msecs);
+    // Milliseconds between the last buffer of the first track and the first buffer of the second one
+    qint64 measureGap(const QString &first, const QString &second, bool preload);
+
+    QTemporaryDir m_dir;
+};
+
+static const int s_sampleRate = 44100;
+
+QString MediaServiceTest::writeWav(const QString &name, qreal frequency, int msecs)
+{
+    const QByteArray wav = WavFile::sine(s_sampleRate, 2, s_sampleRate * msecs / 1000, frequency, 16000.0 / 32767);
+
+    QFile file(m_dir.filePath(name));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    file.write(wav);
+    return QUrl::fromLocalFile(file.fileName()).toString();
+}
+
+qint64 MediaServiceTest::measureGap(const QString &first, const QString &second, bool preload)
+{
+    MediaService service;
+    QElapsedTimer clock;
+    bool secondStarted = false;
+    qint64 lastOfFirst = -1;
+    qint64 firstOfSecond = -1;
+
+    // Buffers as seen by the probe, which is what the spectrum and the levels are made of
+    connect(&service, &MediaService::levels, this, [&]() {
+        if (!secondStarted) {
+            lastOfFirst = clock.elapsed();
+        } else if (firstOfSecond < 0) {
+            firstOfSecond = clock.elapsed();
+        }
+    });
+
+    if (preload) {
+        connect(&service, &MediaService::trackChanged, this, [&]() {
+            secondStarted = true;
+        });
+    } else {
+        // What a skill does without preloading: play the next track when the current one is over
+        connect(&service, &MediaService::mediaStatusChanged, this, [&](QMediaPlayer::MediaStatus status) {
+            if (status == QMediaPlayer::EndOfMedia && !secondStarted) {
+                secondStarted = true;
+                service.playURL(second);
+            }
+        });
+    }
+
+    clock.start();
+    service.playURL(first);
+    if (preload) {
+        service.preloadURL(second);
+    }
+
+    while (firstOfSecond < 0 && clock.elapsed() < 10000) {
+        QTest::qWait(10);
+    }
+    if (firstOfSecond < 0 || lastOfFirst < 0) {
+        return -1;
+    }
+
+    service.playerStop();
+    return firstOfSecond - lastOfFirst;
+}
+
+QAudioBuffer MediaServiceTest::toneBuffer(qreal amplitude) const
+{
+    QAudioFormat format;
+    format.setSampleRate(s_sampleRate);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    // Without the WAV header
+    return QAudioBuffer(WavFile::sine(s_sampleRate, 2, 1024, 440, amplitude).mid(44), format);
+}
+
+void MediaServiceTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void MediaServiceTest::testInterTrackGap()
+{
+    if (QAudioDeviceInfo::defaultOutputDevice().isNull()) {
+        QSKIP("No audio output device");
+    }
+
+    const QString first = writeWav(QStringLiteral("first.wav"), 440, 1000);
+    const QString second = writeWav(QStringLiteral("second.wav"), 660, 1000);
+    QVERIFY(!first.isEmpty());
+    QVERIFY(!second.isEmpty());
+
+    const qint64 coldGap = measureGap(first, second, false);
+    const qint64 preloadedGap = measureGap(first, second, true);
+    qInfo() << "Inter-track gap, cold start:" << coldGap << "ms, preloaded:" << preloadedGap << "ms";
+
+    QVERIFY(coldGap >= 0);
+    QVERIFY(preloadedGap >= 0);
+    // Pipeline setup and preroll are out of the way: about one buffer of slack
+    QVERIFY(preloadedGap < 50);
+    QVERIFY(preloadedGap <= coldGap);
+}
+
+void MediaServiceTest::testPositionRate()
+{
+    if (QAudioDeviceInfo::defaultOutputDevice().isNull()) {
+        QSKIP("No audio output device");
+    }
+
+    const int tracks = 100;
+    const int trackLength = 300;
+    const int interval = 50;
+
+    MediaService service;
+    service.setPositionInterval(interval);
+
+    QVector<int> counts;
+    qint64 lastPosition = -1;
+    bool repeated = false;
+    bool ended = false;
+    connect(&service, &MediaService::mediaStatusChanged, this, [&](QMediaPlayer::MediaStatus status) {
+        ended = ended || status == QMediaPlayer::EndOfMedia;
+    });
+    connect(&service, &MediaService::positionChanged, this, [&](qint64 position) {
+        repeated = repeated || position == lastPosition;
+        lastPosition = position;
+        ++counts.last();
+    });
+
+    for (int i = 0; i < tracks; ++i) {
+        const QString url = writeWav(QStringLiteral("track%1.wav").arg(i), 220 + i * 10, trackLength);
+        QVERIFY(!url.isEmpty());
+
+        counts << 0;
+        lastPosition = -1;
+        ended = false;
+        service.playURL(url);
+        QTRY_VERIFY_WITH_TIMEOUT(ended, 5000);
+    }
+
+    // One signal per interval plus the final position, whatever the number of tracks played before
+    const int expected = trackLength / interval + 1;
+    QVERIFY(!repeated);
+    for (int i = 0; i < tracks; ++i) {
+        QVERIFY2(counts[i] <= expected + 1, qPrintable(QStringLiteral("track %1: %2 signals").arg(i).arg(counts[i])));
+        QVERIFY2(counts[i] >= expected / 2, qPrintable(QStringLiteral("track %1: %2 signals").arg(i).arg(counts[i])));
+    }
+    QVERIFY(qAbs(counts.last() - counts.first()) <= 2);
+}
+
+void MediaServiceTest::testPresentationMode()
+{
+    // Buffers are fed straight to the service, nothing is played
+    MediaService service;
+    service.setupProbeSource();
+    MediaService reference;
+    reference.setupProbeSource();
+
+    QQuickWindow window;
+    window.resize(100, 100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    service.setPresentationWindow(&window);
+
+    int spectrumSignals = 0;
+    int levelSignals = 0;
+    QVector<double> publishedSpectrum;
+    QPair<double, double> publishedLevels;
+    connect(&service, &MediaService::spectrumChanged, this, [&]() {
+        ++spectrumSignals;
+        publishedSpectrum = service.spectrum();
+    });
+    connect(&service, &MediaService::levels, this, [&](double left, double right) {
+        ++levelSignals;
+        publishedLevels = qMakePair(left, right);
+    });
+
+    // Connected after the service, so it runs once the frame has been published
+    int frames = 0;
+    int totalSpectra = 0;
+    int totalLevels = 0;
+    int maxSpectraPerFrame = 0;
+    int maxLevelsPerFrame = 0;
+    connect(&window, &QQuickWindow::afterAnimating, this, [&]() {
+        ++frames;
+        totalSpectra += spectrumSignals;
+        totalLevels += levelSignals;
+        maxSpectraPerFrame = qMax(maxSpectraPerFrame, spectrumSignals);
+        maxLevelsPerFrame = qMax(maxLevelsPerFrame, levelSignals);
+        spectrumSignals = 0;
+        levelSignals = 0;
+    });
+
+    // Several buffers within one frame: only the levels of the last one are published, with the frame
+    service.processBuffer(toneBuffer(0.2));
+    service.processBuffer(toneBuffer(0.4));
+    service.processBuffer(toneBuffer(0.6));
+    QCOMPARE(levelSignals, 0);
+    QPair<double, double> expectedLevels;
+    connect(&reference, &MediaService::levels, this, [&](double left, double right) {
+        expectedLevels = qMakePair(left, right);
+    });
+    reference.processBuffer(toneBuffer(0.6));
+    QTRY_COMPARE(totalLevels, 1);
+    QCOMPARE(maxLevelsPerFrame, 1);
+    QCOMPARE(publishedLevels.first, expectedLevels.first);
+    QCOMPARE(publishedLevels.second, expectedLevels.second);
+
+    // The worker computes spectra at its own pace: while the GUI thread is busy they pile up,
+    // to be published once at the next frame
+    QVector<float> magnitudes;
+    int sampleRate = 0;
+    quint64 firstSerial = 0;
+    service.latestSpectrum()->latest(magnitudes, sampleRate, firstSerial);
+    const int firstTotal = totalSpectra + spectrumSignals;
+    for (int i = 0; i < 10; ++i) {
+        service.processBuffer(toneBuffer(0.1 * (i % 5 + 1)));
+        QThread::msleep(40);
+    }
+
+    // Until the worker goes idle and the last spectrum is on screen
+    QTest::qWait(1000);
+    QCOMPARE(spectrumSignals, 0);
+    quint64 lastSerial = firstSerial;
+    service.latestSpectrum()->latest(magnitudes, sampleRate, lastSerial);
+    QVERIFY(frames > 0);
+    QCOMPARE(maxSpectraPerFrame, 1);
+    QCOMPARE(maxLevelsPerFrame, 1);
+    QVERIFY(totalSpectra > firstTotal);
+    QVERIFY2(quint64(totalSpectra - firstTotal) < lastSerial - firstSerial,
+             qPrintable(QStringLiteral("%1 spectra published for %2 computed").arg(totalSpectra - firstTotal).arg(lastSerial - firstSerial)));
+    QCOMPARE(publishedSpectrum, service.spectrum());
+}
+
+QTEST_MAIN(MediaServiceTest);
+
+#include "mediaservicetest.moc"
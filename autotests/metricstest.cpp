@@ -0,0 +1,216 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include "../import/metricsregistry.h"
+#include "../import/metricsserver.h"
+
+class IncrementThread : public QThread
+{
+public:
+    IncrementThread(MetricCounter *counter, MetricHistogram *histogram)
+        : m_counter(counter),
+          m_histogram(histogram)
+    {}
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < 100000; ++i) {
+            m_counter->increment();
+            m_histogram->observe(1000000);
+        }
+    }
+
+private:
+    MetricCounter *m_counter;
+    MetricHistogram *m_histogram;
+};
+
+class MetricsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRegistration();
+    void testExposition();
+    void testHistogram();
+    void testConcurrentUpdates();
+    void testHttpEndpoint();
+    void testUnixEndpoint();
+    void testUnixEndpointOverFile();
+
+private:
+    QByteArray scrape(QIODevice *socket);
+};
+
+void MetricsTest::testRegistration()
+{
+    MetricsRegistry *registry = MetricsRegistry::instance();
+
+    MetricCounter *counter = registry->counter(QStringLiteral("test_registration_total"), QStringLiteral("Help"),
+                                               {{QStringLiteral("kind"), QStringLiteral("a")}});
+    QVERIFY(counter);
+    QCOMPARE(registry->counter(QStringLiteral("test_registration_total"), QStringLiteral("Help"),
+                               {{QStringLiteral("kind"), QStringLiteral("a")}}), counter);
+    QVERIFY(registry->counter(QStringLiteral("test_registration_total"), QStringLiteral("Help"),
+                              {{QStringLiteral("kind"), QStringLiteral("b")}}) != counter);
+
+    // Same name, different type
+    QVERIFY(!registry->gauge(QStringLiteral("test_registration_total"), QStringLiteral("Help")));
+}
+
+void MetricsTest::testExposition()
+{
+    MetricsRegistry *registry = MetricsRegistry::instance();
+
+    registry->counter(QStringLiteral("test_messages_total"), QStringLiteral("Messages"),
+                      {{QStringLiteral("type"), QStringLiteral("mycroft.session.set")}})->increment(3);
+    registry->counter(QStringLiteral("test_messages_total"), QStringLiteral("Messages"),
+                      {{QStringLiteral("type"), QStringLiteral("say \"hi\"")}})->increment();
+    MetricGauge *gauge = registry->gauge(QStringLiteral("test_delegates"), QStringLiteral("Delegates"));
+    gauge->add(5);
+    gauge->add(-2);
+
+    const QByteArray text = registry->exposition();
+    QVERIFY(text.contains("# HELP test_messages_total Messages\n"));
+    QVERIFY(text.contains("# TYPE test_messages_total counter\n"));
+    QVERIFY(text.contains("test_messages_total{type=\"mycroft.session.set\"} 3\n"));
+    QVERIFY(text.contains("test_messages_total{type=\"say \\\"hi\\\"\"} 1\n"));
+    QVERIFY(text.contains("# TYPE test_delegates gauge\n"));
+    QVERIFY(text.contains("test_delegates 3\n"));
+}
+
+void MetricsTest::testHistogram()
+{
+    MetricHistogram *histogram = MetricsRegistry::instance()->histogram(QStringLiteral("test_apply_seconds"), QStringLiteral("Apply"));
+
+    histogram->observe(300000);      // 0.3ms
+    histogram->observe(3000000);     // 3ms
+    histogram->observe(3000000000);  // 3s
+
+    QCOMPARE(histogram->count(), quint64(3));
+    QCOMPARE(histogram->sum(), qint64(3003300000));
+
+    const QByteArray text = MetricsRegistry::instance()->exposition();
+    QVERIFY(text.contains("# TYPE test_apply_seconds histogram\n"));
+    QVERIFY(text.contains("test_apply_seconds_bucket{le=\"0.0005\"} 1\n"));
+    QVERIFY(text.contains("test_apply_seconds_bucket{le=\"0.0025\"} 1\n"));
+    QVERIFY(text.contains("test_apply_seconds_bucket{le=\"0.005\"} 2\n"));
+    QVERIFY(text.contains("test_apply_seconds_bucket{le=\"2.5\"} 2\n"));
+    QVERIFY(text.contains("test_apply_seconds_bucket{le=\"+Inf\"} 3\n"));
+    QVERIFY(text.contains("test_apply_seconds_sum 3.0033\n"));
+    QVERIFY(text.contains("test_apply_seconds_count 3\n"));
+}
+
+void MetricsTest::testConcurrentUpdates()
+{
+    MetricCounter *counter = MetricsRegistry::instance()->counter(QStringLiteral("test_concurrent_total"), QStringLiteral("Concurrent"));
+    MetricHistogram *histogram = MetricsRegistry::instance()->histogram(QStringLiteral("test_concurrent_seconds"), QStringLiteral("Concurrent"));
+
+    QVector<IncrementThread *> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads << new IncrementThread(counter, histogram);
+        threads.last()->start();
+    }
+    for (auto *thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    QCOMPARE(counter->value(), quint64(400000));
+    QCOMPARE(histogram->count(), quint64(400000));
+    QCOMPARE(histogram->buckets()[1], quint64(400000));
+}
+
+QByteArray MetricsTest::scrape(QIODevice *socket)
+{
+    QSignalSpy disconnectedSpy(socket, SIGNAL(disconnected()));
+    socket->write("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    disconnectedSpy.wait(5000);
+    return socket->readAll();
+}
+
+void MetricsTest::testHttpEndpoint()
+{
+    MetricsRegistry::instance()->counter(QStringLiteral("test_http_total"), QStringLiteral("Http"))->increment();
+
+    QVERIFY(!MetricsServer::instance()->listen(QStringLiteral("notaport")));
+    QVERIFY(MetricsServer::instance()->listen(QStringLiteral("0")));
+    const QString address = MetricsServer::instance()->address();
+    QVERIFY(address.startsWith(QLatin1String("127.0.0.1:")));
+
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, address.section(QLatin1Char(':'), 1).toUShort());
+    QVERIFY(socket.waitForConnected(5000));
+    const QByteArray reply = scrape(&socket);
+    QVERIFY(reply.startsWith("HTTP/1.0 200 OK\r\n"));
+    QVERIFY(reply.contains("Content-Type: text/plain; version=0.0.4"));
+    QVERIFY(reply.contains("\r\n\r\n# HELP"));
+    QVERIFY(reply.contains("test_http_total 1\n"));
+
+    QTcpSocket notFound;
+    notFound.connectToHost(QHostAddress::LocalHost, address.section(QLatin1Char(':'), 1).toUShort());
+    QVERIFY(notFound.waitForConnected(5000));
+    QSignalSpy disconnectedSpy(&notFound, &QTcpSocket::disconnected);
+    notFound.write("GET /other HTTP/1.1\r\n\r\n");
+    disconnectedSpy.wait(5000);
+    QVERIFY(notFound.readAll().startsWith("HTTP/1.0 404"));
+
+    MetricsServer::instance()->close();
+    QVERIFY(!MetricsServer::instance()->isListening());
+}
+
+void MetricsTest::testUnixEndpoint()
+{
+    QTemporaryDir dir;
+    const QString path = dir.path() + QStringLiteral("/metrics.sock");
+
+    QVERIFY(MetricsServer::instance()->listen(QStringLiteral("unix:") + path));
+    QCOMPARE(MetricsServer::instance()->address(), QStringLiteral("unix:") + path);
+
+    QLocalSocket socket;
+    socket.connectToServer(path);
+    QVERIFY(socket.waitForConnected(5000));
+    const QByteArray reply = scrape(&socket);
+    QVERIFY(reply.startsWith("HTTP/1.0 200 OK\r\n"));
+    QVERIFY(reply.contains("# TYPE test_http_total counter\n"));
+
+    MetricsServer::instance()->close();
+}
+
+void MetricsTest::testUnixEndpointOverFile()
+{
+    QTemporaryDir dir;
+    const QString path = dir.path() + QStringLiteral("/metrics.conf");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("keep me");
+    file.close();
+
+    //a mistyped endpoint must not delete the file
+    QVERIFY(!MetricsServer::instance()->listen(QStringLiteral("unix:") + path));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), QByteArray("keep me"));
+}
+
+QTEST_MAIN(MetricsTest);
+
+#include "metricstest.moc"
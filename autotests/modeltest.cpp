@@ -42,6 +42,7 @@ public Q_SLOTS:
 private Q_SLOTS:
     void testActiveSkillsModel();
     void testDelegatesModel();
+    void testSuspendDelegatesModel();
     void testSessionDataModel();
 
 private:
@@ -87,6 +88,24 @@ void ModelTest::testDelegatesModel()
     m_delegatesModel->insertDelegateLoaders(0, {new DelegateLoader(m_view)});
 }
 
+void ModelTest::testSuspendDelegatesModel()
+{
+    DelegatesModel *delegatesModel = new DelegatesModel(this);
+    new QAbstractItemModelTester(delegatesModel, QAbstractItemModelTester::FailureReportingMode::QtTest, this);
+    delegatesModel->insertDelegateLoaders(0, {new DelegateLoader(m_view), new DelegateLoader(m_view), new DelegateLoader(m_view)});
+    delegatesModel->setCurrentIndex(2);
+
+    delegatesModel->suspend();
+    QVERIFY(delegatesModel->isSuspended());
+    QCOMPARE(delegatesModel->rowCount(), 0);
+    QCOMPARE(delegatesModel->suspendedUrls().count(), 3);
+    QCOMPARE(delegatesModel->suspendedCurrentIndex(), 2);
+
+    delegatesModel->resume();
+    QVERIFY(!delegatesModel->isSuspended());
+    QVERIFY(delegatesModel->suspendedUrls().isEmpty());
+}
+
 void ModelTest::testSessionDataModel()
 {
     m_sessionDataModel->insertData(0, QList<QVariantMap> ({{{QStringLiteral("prop"), QStringLiteral("value1")}}, {{QStringLiteral("prop"), QStringLiteral("value2")}},  {{QStringLiteral("prop"), QStringLiteral("value3")}}, {{QStringLiteral("prop"), QStringLiteral("value4")}}}));
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QQuickWindow>
+#include "../import/performancehud.h"
+#include "../import/metricsregistry.h"
+
+class PerformanceHudTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSampling();
+    void testHidden();
+};
+
+void PerformanceHudTest::testSampling()
+{
+    MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_socket_backlog"), QStringLiteral("Backlog"))->set(7);
+    MetricsRegistry::instance()->histogram(QStringLiteral("mycroft_gui_message_apply_seconds"), QStringLiteral("Apply"))->observe(1500000);
+
+    QQuickWindow window;
+    window.resize(400, 300);
+    PerformanceHud hud(window.contentItem());
+    QSignalSpy statsSpy(&hud, &PerformanceHud::statsChanged);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // The first refresh happens right away, the next ones count the frames in between
+    while (statsSpy.count() < 3) {
+        QVERIFY(statsSpy.wait(2000));
+    }
+
+    QVERIFY(hud.framesPerSecond() > 0);
+    QVERIFY(hud.frameTime() > 0);
+    QCOMPARE(hud.socketBacklog(), 7);
+    QCOMPARE(hud.lastApplyTime(), 1.5);
+#ifdef Q_OS_LINUX
+    QVERIFY(hud.residentMemory() > 0);
+#endif
+    QVERIFY(hud.implicitWidth() > 0);
+    QVERIFY(hud.implicitHeight() > 0);
+}
+
+void PerformanceHudTest::testHidden()
+{
+    QQuickWindow window;
+    window.resize(400, 300);
+    PerformanceHud hud(window.contentItem());
+    hud.setVisible(false);
+    QSignalSpy statsSpy(&hud, &PerformanceHud::statsChanged);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // Nothing gets sampled while hidden
+    QVERIFY(!statsSpy.wait(1000));
+
+    hud.setVisible(true);
+    QVERIFY(statsSpy.count() > 0 || statsSpy.wait(1000));
+}
+
+QTEST_MAIN(PerformanceHudTest);
+
+#include "performancehudtest.moc"
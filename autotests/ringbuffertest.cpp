@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QThread>
+#include <QVector>
+#include "../import/sampleringbuffer.h"
+
+class RingBufferTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testWrapAround();
+    void testDropOldest();
+    void testConcurrentReads();
+};
+
+// Every sample holds its own position, so a read can be checked for tearing
+static QVector<float> positions(quint64 begin, int count)
+{
+    QVector<float> samples(count);
+    for (int i = 0; i < count; ++i) {
+        samples[i] = float(begin + i);
+    }
+    return samples;
+}
+
+static bool isContiguous(const QVector<float> &samples, quint64 end)
+{
+    for (int i = 0; i < samples.size(); ++i) {
+        if (samples[i] != float(end - samples.size() + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class ProducerThread : public QThread
+{
+public:
+    ProducerThread(SampleRingBuffer *ring, quint64 total)
+        : m_ring(ring),
+          m_total(total)
+    {}
+
+protected:
+    void run() override
+    {
+        quint64 position = 0;
+        while (position < m_total) {
+            m_ring->write(positions(position, 300).constData(), 300);
+            position += 300;
+        }
+    }
+
+private:
+    SampleRingBuffer *m_ring;
+    quint64 m_total;
+};
+
+void RingBufferTest::testWrapAround()
+{
+    SampleRingBuffer ring(100);
+    QCOMPARE(ring.capacity(), 128);
+
+    QVector<float> out(40);
+    QVERIFY(!ring.read(40, out.data(), 40));
+
+    quint64 position = 0;
+    for (int i = 0; i < 10; ++i) {
+        ring.write(positions(position, 50).constData(), 50);
+        position += 50;
+        QCOMPARE(ring.writePosition(), position);
+        QVERIFY(ring.read(position, out.data(), out.size()));
+        QVERIFY(isContiguous(out, position));
+    }
+
+    // Not written yet
+    QVERIFY(!ring.read(position + 1, out.data(), out.size()));
+}
+
+void RingBufferTest::testDropOldest()
+{
+    SampleRingBuffer ring(128);
+    QVector<float> out(32);
+
+    ring.write(positions(0, 100).constData(), 100);
+    ring.write(positions(100, 100).constData(), 100);
+
+    // Overwritten by the second write
+    QVERIFY(!ring.read(50, out.data(), 32));
+    QVERIFY(ring.read(200, out.data(), 32));
+    QVERIFY(isContiguous(out, 200));
+
+    // A burst bigger than the ring keeps only its newest samples
+    ring.write(positions(200, 1000).constData(), 1000);
+    QCOMPARE(ring.writePosition(), quint64(1200));
+    QVERIFY(!ring.read(1200 - 128, out.data(), 32));
+    QVERIFY(ring.read(1200, out.data(), 32));
+    QVERIFY(isContiguous(out, 1200));
+}
+
+void RingBufferTest::testConcurrentReads()
+{
+    SampleRingBuffer ring(1024);
+    const quint64 total = 1 << 22;
+
+    ProducerThread producer(&ring, total);
+    producer.start();
+
+    QVector<float> out(512);
+    int reads = 0;
+    while (!producer.isFinished()) {
+        const quint64 end = ring.writePosition();
+        if (ring.read(end, out.data(), out.size())) {
+            // A read that succeeded is never torn, even if the producer wrapped around meanwhile
+            QVERIFY(isContiguous(out, end));
+            ++reads;
+        }
+    }
+    producer.wait();
+
+    QVERIFY(reads > 0);
+}
+
+QTEST_GUILESS_MAIN(RingBufferTest);
+
+#include "ringbuffertest.moc"
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QVector>
+#include <cstring>
+#include <limits>
+#include "../import/sampleconversion.h"
+
+// Not a multiple of the vector width, to exercise the scalar tail too
+static const int s_frames = 4099;
+
+// Deterministic noise covering the whole range of every format
+static quint32 nextRandom(quint32 &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state;
+}
+
+class SampleConversionTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testInt8() { compareWithReference<qint8>(); }
+    void testUInt8() { compareWithReference<quint8>(); }
+    void testInt16() { compareWithReference<qint16>(); }
+    void testUInt16() { compareWithReference<quint16>(); }
+    void testInt32() { compareWithReference<qint32>(); }
+    void testUInt32() { compareWithReference<quint32>(); }
+    void testFloat() { compareWithReference<float>(); }
+    void testNormalization();
+
+    void benchmarkInt16() { benchmark<qint16>(); }
+    void benchmarkInt16Scalar() { benchmarkScalar<qint16>(); }
+    void benchmarkInt32() { benchmark<qint32>(); }
+    void benchmarkInt32Scalar() { benchmarkScalar<qint32>(); }
+    void benchmarkFloat() { benchmark<float>(); }
+    void benchmarkFloatScalar() { benchmarkScalar<float>(); }
+
+private:
+    template<typename T> QVector<T> randomFrames() const;
+    template<typename T> void compareWithReference();
+    template<typename T> void benchmark();
+    template<typename T> void benchmarkScalar();
+};
+
+template<typename T>
+QVector<T> SampleConversionTest::randomFrames() const
+{
+    QVector<T> data(s_frames * 2);
+    quint32 state = 42;
+    for (auto &value : data) {
+        //the high bits of a LCG are the most random ones
+        const quint32 bits = nextRandom(state) >> (32 - 8 * sizeof(T));
+        memcpy(&value, &bits, sizeof(T));
+    }
+    return data;
+}
+
+template<>
+QVector<float> SampleConversionTest::randomFrames<float>() const
+{
+    QVector<float> data(s_frames * 2);
+    quint32 state = 42;
+    for (auto &value : data) {
+        value = nextRandom(state) / 2147483648.0 - 1;
+    }
+    // Both the vector path and the scalar tail have to drop NaN
+    data[6] = std::numeric_limits<float>::quiet_NaN();
+    data[data.size() - 1] = std::numeric_limits<float>::quiet_NaN();
+    return data;
+}
+
+template<typename T>
+void SampleConversionTest::compareWithReference()
+{
+    const QVector<T> data = randomFrames<T>();
+
+    QVector<float> mono(s_frames);
+    StereoLevels levels;
+    convertSamples(data.constData(), s_frames, mono.data(), levels);
+
+    QVector<float> referenceMono(s_frames);
+    StereoLevels referenceLevels;
+    convertSamplesScalar(data.constData(), s_frames, referenceMono.data(), referenceLevels);
+
+    for (int i = 0; i < s_frames; ++i) {
+        QCOMPARE(mono[i], referenceMono[i]);
+        QVERIFY(mono[i] >= -1 && mono[i] <= 1);
+    }
+
+    // Only the order of the additions differs
+    QVERIFY(qAbs(levels.left - referenceLevels.left) < referenceLevels.left * 1e-4);
+    QVERIFY(qAbs(levels.right - referenceLevels.right) < referenceLevels.right * 1e-4);
+    QVERIFY(referenceLevels.left > 0);
+    QVERIFY(referenceLevels.right > 0);
+}
+
+void SampleConversionTest::testNormalization()
+{
+    float mono[4];
+
+    const qint16 int16Frames[] = {-32768, 0, 16384, -16384, 0, 32767, 0, 0};
+    StereoLevels levels;
+    convertSamples(int16Frames, 4, mono, levels);
+    QCOMPARE(mono[0], -1.0f);
+    QCOMPARE(mono[1], 0.5f);
+    QCOMPARE(mono[2], 0.0f);
+    QCOMPARE(levels.right, 0.5f + 32767.0f / 32768);
+
+    // Unsigned formats are centered on half their range
+    const quint8 uint8Frames[] = {128, 0, 0, 255, 192, 128, 64, 128};
+    levels = StereoLevels();
+    convertSamples(uint8Frames, 4, mono, levels);
+    QCOMPARE(mono[0], 0.0f);
+    QCOMPARE(mono[1], -1.0f);
+    QCOMPARE(mono[2], 0.5f);
+    QCOMPARE(mono[3], -0.5f);
+    QCOMPARE(levels.right, 1.0f + 127.0f / 128);
+
+    const quint32 uint32Frames[] = {0x80000000u, 0, 0, 0xffffffffu, 0x80000000u, 0x80000000u, 0xc0000000u, 0x80000000u};
+    levels = StereoLevels();
+    convertSamples(uint32Frames, 4, mono, levels);
+    QCOMPARE(mono[0], 0.0f);
+    QCOMPARE(mono[1], -1.0f);
+    QCOMPARE(mono[3], 0.5f);
+}
+
+template<typename T>
+void SampleConversionTest::benchmark()
+{
+    const QVector<T> data = randomFrames<T>();
+    QVector<float> mono(s_frames);
+    StereoLevels levels;
+
+    QBENCHMARK {
+        convertSamples(data.constData(), s_frames, mono.data(), levels);
+    }
+}
+
+template<typename T>
+void SampleConversionTest::benchmarkScalar()
+{
+    const QVector<T> data = randomFrames<T>();
+    QVector<float> mono(s_frames);
+    StereoLevels levels;
+
+    QBENCHMARK {
+        convertSamplesScalar(data.constData(), s_frames, mono.data(), levels);
+    }
+}
+
+QTEST_GUILESS_MAIN(SampleConversionTest);
+
+#include "sampleconversiontest.moc"
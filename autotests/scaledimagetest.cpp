@@ -0,0 +1,309 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include "../import/scaledimageprovider.h"
+#include "../import/metricsregistry.h"
+
+class ScaledImageTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void testDownscale_data();
+    void testDownscale();
+    void testMemoryCache();
+    void testDiskCache();
+    void testDiskBudget();
+    void testModifiedSource();
+    void testModifiedRemoteSource();
+    void testMissingSource();
+    void testResponse();
+    void testProvider();
+
+private:
+    QUrl writeImage(const QString &name, const QSize &size, const QColor &color);
+    quint64 lookups(const QString &result) const;
+    int diskFiles() const;
+
+    QTemporaryDir m_sourceDir;
+    QTemporaryDir m_cacheDir;
+};
+
+void ScaledImageTest::initTestCase()
+{
+    QVERIFY(m_sourceDir.isValid());
+    QVERIFY(m_cacheDir.isValid());
+    ScaledImageCache::instance()->setCacheDirectory(m_cacheDir.path());
+}
+
+void ScaledImageTest::init()
+{
+    ScaledImageCache::instance()->clearMemory();
+}
+
+QUrl ScaledImageTest::writeImage(const QString &name, const QSize &size, const QColor &color)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    const QString path = QDir(m_sourceDir.path()).filePath(name);
+    image.save(path, "PNG");
+    return QUrl::fromLocalFile(path);
+}
+
+quint64 ScaledImageTest::lookups(const QString &result) const
+{
+    return MetricsRegistry::instance()->counter(QStringLiteral("mycroft_gui_image_cache_lookups_total"), QString(),
+                                                {{QStringLiteral("result"), result}})->value();
+}
+
+int ScaledImageTest::diskFiles() const
+{
+    return QDir(m_cacheDir.path()).entryList(QDir::Files).count();
+}
+
+void ScaledImageTest::testDownscale_data()
+{
+    QTest::addColumn<QSize>("requestedSize");
+    QTest::addColumn<QSize>("expectedSize");
+
+    QTest::newRow("no size") << QSize() << QSize(400, 200);
+    QTest::newRow("covering a square") << QSize(100, 100) << QSize(200, 100);
+    QTest::newRow("width only") << QSize(100, 0) << QSize(100, 50);
+    QTest::newRow("height only") << QSize(0, 20) << QSize(40, 20);
+    QTest::newRow("larger than the image") << QSize(800, 800) << QSize(400, 200);
+}
+
+void ScaledImageTest::testDownscale()
+{
+    QFETCH(QSize, requestedSize);
+    QFETCH(QSize, expectedSize);
+
+    const QUrl source = writeImage(QStringLiteral("wallpaper.png"), QSize(400, 200), Qt::red);
+    const QImage image = ScaledImageCache::instance()->image(source, requestedSize);
+    QCOMPARE(image.size(), expectedSize);
+    QCOMPARE(image.pixel(expectedSize.width() / 2, expectedSize.height() / 2), QColor(Qt::red).rgb());
+}
+
+void ScaledImageTest::testMemoryCache()
+{
+    const QUrl source = writeImage(QStringLiteral("thumbnail.png"), QSize(300, 300), Qt::blue);
+    const quint64 memoryHits = lookups(QStringLiteral("memory"));
+
+    const QImage first = ScaledImageCache::instance()->image(source, QSize(100, 100));
+    const QImage second = ScaledImageCache::instance()->image(source, QSize(100, 100));
+    QCOMPARE(lookups(QStringLiteral("memory")), memoryHits + 1);
+    // Shared, not copied
+    QCOMPARE(first.constBits(), second.constBits());
+    QCOMPARE(ScaledImageCache::instance()->memoryUsage(), first.bytesPerLine() * first.height());
+
+    // Another size is another image
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(50, 50)).size(), QSize(50, 50));
+    QCOMPARE(lookups(QStringLiteral("memory")), memoryHits + 1);
+
+    // Least recently used images go first when over budget
+    const int budget = ScaledImageCache::instance()->memoryBudget();
+    ScaledImageCache::instance()->setMemoryBudget(first.bytesPerLine() * first.height());
+    QVERIFY(ScaledImageCache::instance()->memoryUsage() <= ScaledImageCache::instance()->memoryBudget());
+    ScaledImageCache::instance()->setMemoryBudget(budget);
+}
+
+void ScaledImageTest::testDiskCache()
+{
+    const QUrl source = writeImage(QStringLiteral("background.png"), QSize(1000, 500), Qt::green);
+    const int files = diskFiles();
+    const quint64 diskHits = lookups(QStringLiteral("disk"));
+
+    const QImage decoded = ScaledImageCache::instance()->image(source, QSize(100, 100));
+    QCOMPARE(decoded.size(), QSize(200, 100));
+    QCOMPARE(diskFiles(), files + 1);
+
+    // Read back at its scaled size, as at the next start
+    ScaledImageCache::instance()->clearMemory();
+    const QImage cached = ScaledImageCache::instance()->image(source, QSize(100, 100));
+    QCOMPARE(lookups(QStringLiteral("disk")), diskHits + 1);
+    QCOMPARE(cached.size(), QSize(200, 100));
+    // Saved as jpeg
+    QVERIFY(QColor(cached.pixel(100, 50)).green() > 250);
+
+    // Images not downscaled aren't worth a copy on disk
+    ScaledImageCache::instance()->image(writeImage(QStringLiteral("small.png"), QSize(10, 10), Qt::green), QSize(100, 100));
+    QCOMPARE(diskFiles(), files + 1);
+}
+
+void ScaledImageTest::testDiskBudget()
+{
+    QTemporaryDir cacheDir;
+    ScaledImageCache::instance()->setCacheDirectory(cacheDir.path());
+
+    const QUrl source = writeImage(QStringLiteral("pruned.png"), QSize(400, 400), Qt::yellow);
+    for (int i = 1; i <= 4; ++i) {
+        ScaledImageCache::instance()->image(source, QSize(10 * i, 10 * i));
+    }
+    QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 4);
+
+    ScaledImageCache::instance()->setDiskBudget(1);
+    QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 0);
+
+    ScaledImageCache::instance()->setDiskBudget(128 * 1024 * 1024);
+    ScaledImageCache::instance()->setCacheDirectory(m_cacheDir.path());
+}
+
+void ScaledImageTest::testModifiedSource()
+{
+    const QUrl source = writeImage(QStringLiteral("replaced.png"), QSize(400, 400), Qt::red);
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50), QColor(Qt::red).rgb());
+
+    // Make sure the modification time changes, whatever the file system
+    QTest::qWait(1100);
+    writeImage(QStringLiteral("replaced.png"), QSize(400, 400), Qt::blue);
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50), QColor(Qt::blue).rgb());
+}
+
+void ScaledImageTest::testModifiedRemoteSource()
+{
+    // Serves whatever image is in served, tagged by its hash
+    QByteArray served;
+    int transfers = 0;
+    int notModified = 0;
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    connect(&server, &QTcpServer::newConnection, &server, [&]() {
+        QTcpSocket *connection = server.nextPendingConnection();
+        connect(connection, &QTcpSocket::disconnected, connection, &QObject::deleteLater);
+        connect(connection, &QTcpSocket::readyRead, connection, [&, connection]() {
+            if (!connection->peek(connection->bytesAvailable()).contains("\r\n\r\n")) {
+                return;
+            }
+            const QByteArray request = connection->readAll();
+            const QByteArray etag = '"' + QCryptographicHash::hash(served, QCryptographicHash::Sha1).toHex() + '"';
+            if (request.contains(QByteArray("If-None-Match: " + etag + "\r\n"))) {
+                ++notModified;
+                connection->write(QByteArray("HTTP/1.1 304 Not Modified\r\nETag: " + etag + "\r\nConnection: close\r\n\r\n"));
+            } else {
+                ++transfers;
+                QByteArray reply = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nConnection: close\r\nETag: " + etag
+                                   + "\r\nContent-Length: " + QByteArray::number(served.size()) + "\r\n\r\n";
+                reply += served;
+                connection->write(reply);
+            }
+            connection->disconnectFromHost();
+        });
+    });
+    const QUrl source(QStringLiteral("http://127.0.0.1:%1/weather.png").arg(server.serverPort()));
+
+    auto serve = [&served](const QColor &color) {
+        QImage image(QSize(400, 400), QImage::Format_RGB32);
+        image.fill(color);
+        QBuffer buffer(&served);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "PNG");
+    };
+
+    serve(Qt::red);
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50), QColor(Qt::red).rgb());
+    QCOMPARE(transfers, 1);
+    const quint64 decoded = lookups(QStringLiteral("decoded"));
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50), QColor(Qt::red).rgb());
+    // Unchanged: only revalidated, not downloaded nor decoded again
+    QCOMPARE(transfers, 1);
+    QCOMPARE(notModified, 1);
+    QCOMPARE(lookups(QStringLiteral("decoded")), decoded);
+
+    // Same url, new content, neither the memory nor the disk cache may return the old one
+    served.clear();
+    serve(Qt::blue);
+    QCOMPARE(ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50), QColor(Qt::blue).rgb());
+    QCOMPARE(transfers, 2);
+    ScaledImageCache::instance()->clearMemory();
+    // Saved as jpeg
+    QColor cached = ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50);
+    QVERIFY(cached.blue() > 250 && cached.red() < 5);
+    QCOMPARE(transfers, 2);
+    QCOMPARE(notModified, 2);
+
+    // Not modified but in neither cache: downloaded again to be decoded
+    QTemporaryDir cacheDir;
+    ScaledImageCache::instance()->setCacheDirectory(cacheDir.path());
+    ScaledImageCache::instance()->clearMemory();
+    cached = ScaledImageCache::instance()->image(source, QSize(100, 100)).pixel(50, 50);
+    QCOMPARE(cached.rgb(), QColor(Qt::blue).rgb());
+    QCOMPARE(notModified, 3);
+    QCOMPARE(transfers, 3);
+    ScaledImageCache::instance()->setCacheDirectory(m_cacheDir.path());
+}
+
+void ScaledImageTest::testMissingSource()
+{
+    QString errorString;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Can't load image")));
+    const QImage image = ScaledImageCache::instance()->image(QUrl::fromLocalFile(QDir(m_sourceDir.path()).filePath(QStringLiteral("missing.png"))),
+                                                             QSize(100, 100), &errorString);
+    QVERIFY(image.isNull());
+    QVERIFY(!errorString.isEmpty());
+}
+
+void ScaledImageTest::testResponse()
+{
+    const QUrl source = writeImage(QStringLiteral("async.png"), QSize(640, 480), Qt::cyan);
+
+    ScaledImageResponse response(source, QSize(64, 48));
+    QSignalSpy finishedSpy(&response, &QQuickImageResponse::finished);
+    response.run();
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(response.errorString().isEmpty());
+
+    QScopedPointer<QQuickTextureFactory> factory(response.textureFactory());
+    QCOMPARE(factory->textureSize(), QSize(64, 48));
+    QCOMPARE(factory->image().pixel(32, 24), QColor(Qt::cyan).rgb());
+
+    // Canceled before its turn, still finishes but without decoding
+    const quint64 decoded = lookups(QStringLiteral("decoded"));
+    ScaledImageResponse canceled(source, QSize(32, 24));
+    QSignalSpy canceledSpy(&canceled, &QQuickImageResponse::finished);
+    canceled.cancel();
+    canceled.run();
+    QCOMPARE(canceledSpy.count(), 1);
+    QCOMPARE(lookups(QStringLiteral("decoded")), decoded);
+}
+
+void ScaledImageTest::testProvider()
+{
+    const QUrl source = writeImage(QStringLiteral("provider.png"), QSize(640, 480), Qt::magenta);
+
+    QScopedPointer<QQuickImageResponse> response;
+    {
+        ScaledImageProvider provider;
+        // The id is the percent encoded url, as from QML's encodeURIComponent
+        response.reset(provider.requestImageResponse(QString::fromLatin1(QUrl::toPercentEncoding(source.toString())), QSize(64, 48)));
+        // The provider waits for its threads when going away
+    }
+
+    QVERIFY(response->errorString().isEmpty());
+    QScopedPointer<QQuickTextureFactory> factory(response->textureFactory());
+    QCOMPARE(factory->textureSize(), QSize(64, 48));
+    QCOMPARE(factory->image().pixel(32, 24), QColor(Qt::magenta).rgb());
+}
+
+QTEST_MAIN(ScaledImageTest);
+
+#include "scaledimagetest.moc"
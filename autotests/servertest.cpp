@@ -21,6 +21,12 @@
 #include <QAbstractItemModel>
 #include <QQuickView>
 #include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlPropertyMap>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include "../import/mycroftcontroller.h"
 #include "../import/abstractdelegate.h"
 #include "../import/filereader.h"
@@ -28,6 +34,7 @@
 #include "../import/activeskillsmodel.h"
 #include "../import/delegatesmodel.h"
 #include "../import/abstractskillview.h"
+#include "../import/performancehud.h"
 #include "../import/sessiondatamap.h"
 #include "../import/sessiondatamodel.h"
 
@@ -51,10 +58,18 @@ private Q_SLOTS:
     void testMoveGuiPage();
     void testRemoveGuiPage();
     void testSwitchSkill();
+    void testTracedMessage();
+    void testLiveSkillsBudget();
+    void testSpeakingDebounce();
+    void testBundledPage();
+    void testDeduplicatedInsert();
+    void testPrefetch();
+    void testSharedConnection();
 
 private:
     AbstractDelegate *delegateForSkill(const QString &skill, const QUrl &url);
     QList <AbstractDelegate *>delegatesForSkill(const QString &skill);
+    QObject *qmlGlobalSettings();
 
     //Client
     MycroftController *m_controller;
@@ -81,10 +96,10 @@ static QObject *fileReaderSingletonProvider(QQmlEngine *engine, QJSEngine *scrip
 
 static QObject *globalSettingsSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
 {
-    Q_UNUSED(engine)
     Q_UNUSED(scriptEngine)
 
-    return new GlobalSettings;
+    engine->setObjectOwnership(GlobalSettings::instance(), QQmlEngine::CppOwnership);
+    return GlobalSettings::instance();
 }
 
 static QObject *mycroftControllerSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
@@ -122,8 +137,23 @@ QList <AbstractDelegate *>ServerTest::delegatesForSkill(const QString &skill)
     return delegatesModel->delegates();
 }
 
+//the GlobalSettings singleton as seen from qml, as the settings page changes it
+QObject *ServerTest::qmlGlobalSettings()
+{
+    QQmlComponent component(m_window->engine());
+    component.setData("import QtQml 2.0\nimport Mycroft 1.0\nQtObject { property QtObject settings: GlobalSettings }", QUrl());
+    QScopedPointer<QObject> settingsHolder(component.create());
+    if (!settingsHolder) {
+        return nullptr;
+    }
+    return settingsHolder->property("settings").value<QObject *>();
+}
+
 void ServerTest::initTestCase()
 {
+    //GlobalSettings must not touch the user configuration
+    QStandardPaths::setTestModeEnabled(true);
+
     m_mainServerSocket = new QWebSocketServer(QStringLiteral("core"),
                                             QWebSocketServer::NonSecureMode, this);
     m_mainServerSocket->listen(QHostAddress::Any, 8181);
@@ -149,6 +179,7 @@ void ServerTest::initTestCase()
         qmlRegisterSingletonType<FileReader>("Mycroft", 1, 0, "FileReader", fileReaderSingletonProvider);
         qmlRegisterType<AbstractSkillView>("Mycroft", 1, 0, "AbstractSkillView");
         qmlRegisterType<AbstractDelegate>("Mycroft", 1, 0, "AbstractDelegate");
+        qmlRegisterType<PerformanceHud>("Mycroft", 1, 0, "PerformanceHud");
 
         qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AudioPlayer.qml")), "Mycroft", 1, 0, "AudioPlayer");
         qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AutoFitLabel.qml")), "Mycroft", 1, 0, "AutoFitLabel");
@@ -697,6 +728,364 @@ void ServerTest::testSwitchSkill()
     QTest::qWait(3000);
 }
 
+void ServerTest::testTracedMessage()
+{
+    SessionDataMap *map = m_view->sessionDataForSkill(QStringLiteral("mycroft.wiki"));
+    QVERIFY(map);
+
+    QSignalSpy dataChangedSpy(map, &SessionDataMap::valueChanged);
+    QSignalSpy breakdownSpy(m_view, &AbstractSkillView::latencyBreakdownChanged);
+
+    //only messages carrying a trace id in their context get traced
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.set\", \"namespace\": \"mycroft.wiki\", \"context\": {\"trace_id\": \"t1\"}, \"data\": {\"title\": \"Traced\"}}"));
+    dataChangedSpy.wait();
+    QCOMPARE(map->value(QStringLiteral("title")), QVariant(QStringLiteral("Traced")));
+
+    //completed when the next frame is swapped
+    if (breakdownSpy.isEmpty()) {
+        QVERIFY(breakdownSpy.wait());
+    }
+
+    const QVariantMap entry = m_view->latencyBreakdown().value(QStringLiteral("mycroft.session.set")).toMap();
+    QCOMPARE(entry.value(QStringLiteral("count")).toInt(), 1);
+    const QVariantMap stages = entry.value(QStringLiteral("stages")).toMap();
+    QVERIFY(stages.contains(QStringLiteral("parse")));
+    QVERIFY(stages.contains(QStringLiteral("apply")));
+    QVERIFY(stages.contains(QStringLiteral("client")));
+    //no sent_at in the context
+    QVERIFY(!stages.contains(QStringLiteral("network")));
+}
+
+void ServerTest::testLiveSkillsBudget()
+{
+    QObject *settings = qmlGlobalSettings();
+    QVERIFY(settings);
+
+    ActiveSkillsModel *model = m_view->activeSkills();
+    const QStringList skills = model->activeSkills();
+    const int liveCount = qMax(1, model->activeIndex() + 1);
+    QVERIFY(skills.count() > liveCount);
+
+    auto suspendedSkills = [&]() {
+        QStringList suspended;
+        for (const QString &skill : skills) {
+            DelegatesModel *delegatesModel = model->delegatesModels().value(skill);
+            if (delegatesModel && delegatesModel->isSuspended()) {
+                suspended << skill;
+            }
+        }
+        return suspended;
+    };
+    QVERIFY(suspendedSkills().isEmpty());
+
+    QVERIFY(settings->setProperty("liveSkillsBudget", 1));
+    const QStringList suspended = suspendedSkills();
+    QVERIFY(!suspended.isEmpty());
+    for (int i = 0; i < skills.count(); ++i) {
+        QCOMPARE(suspended.contains(skills[i]), i >= liveCount && model->delegatesModels().contains(skills[i]));
+    }
+
+    QVERIFY(settings->setProperty("liveSkillsBudget", 0));
+    QVERIFY(suspendedSkills().isEmpty());
+}
+
+void ServerTest::testSpeakingDebounce()
+{
+    QObject *settings = qmlGlobalSettings();
+    QVERIFY(settings);
+    const QVariant defaultInterval = settings->property("speakingDebounceInterval");
+    QVERIFY(settings->setProperty("speakingDebounceInterval", 400));
+
+    QSignalSpy speakingSpy(m_controller, &MycroftController::isSpeakingChanged);
+    m_mainWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"recognizer_loop:audio_output_start\"}"));
+    QVERIFY(speakingSpy.wait());
+    QVERIFY(m_controller->isSpeaking());
+
+    QElapsedTimer timer;
+    timer.start();
+    m_mainWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"recognizer_loop:audio_output_end\"}"));
+    QVERIFY(speakingSpy.wait(2000));
+    QVERIFY(!m_controller->isSpeaking());
+    //coarse timers may fire a bit early
+    QVERIFY(timer.elapsed() >= 360);
+
+    QVERIFY(settings->setProperty("speakingDebounceInterval", defaultInterval));
+}
+
+void ServerTest::testBundledPage()
+{
+    QTemporaryDir skillDir;
+    QVERIFY(skillDir.isValid());
+    QVERIFY(QFile::copy(QStringLiteral(SKILL_BUNDLE_RCC), skillDir.path() + QStringLiteral("/ui.rcc")));
+
+    DelegatesModel *delegatesModel = m_view->activeSkills()->delegatesModelForSkill(QStringLiteral("aiix.food-wizard"));
+    QVERIFY(delegatesModel);
+    QCOMPARE(delegatesModel->rowCount(), 0);
+    QSignalSpy delegateInsertedSpy(delegatesModel, &DelegatesModel::rowsInserted);
+
+    //only the bundle exists, there are no loose files to fall back to
+    QUrl url = QUrl::fromLocalFile(skillDir.path() + QStringLiteral("/ui/BundledPage.qml"));
+    url.setScheme(QStringLiteral("bundle"));
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"aiix.food-wizard\", \"position\": 0, \"data\": [{\"url\": \"") + url.toString() + QStringLiteral("\"}]}"));
+    delegateInsertedSpy.wait();
+
+    QCOMPARE(delegatesModel->rowCount(), 1);
+    QTRY_VERIFY(delegatesModel->delegateLoader(0)->delegate());
+    AbstractDelegate *delegate = delegatesModel->delegateLoader(0)->delegate();
+    QCOMPARE(delegate->skillId(), QStringLiteral("aiix.food-wizard"));
+    QCOMPARE(delegate->qmlUrl().scheme(), QStringLiteral("qrc"));
+    QVERIFY(delegate->qmlUrl().path().startsWith(QLatin1String("/skills/aiix.food-wizard/")));
+
+    //the skill leaving the active skills releases its bundle
+    const QString resourcePath = QLatin1Char(':') + delegate->qmlUrl().path();
+    QVERIFY(QFile::exists(resourcePath));
+    QSignalSpy skillRemovedSpy(m_view->activeSkills(), &ActiveSkillsModel::rowsRemoved);
+    const int row = m_view->activeSkills()->activeSkills().indexOf(QStringLiteral("aiix.food-wizard"));
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.list.remove\", \"namespace\": \"mycroft.system.active_skills\", \"position\": %1, \"items_number\": 1}").arg(row));
+    skillRemovedSpy.wait();
+    QVERIFY(!m_view->activeSkills()->activeSkills().contains(QStringLiteral("aiix.food-wizard")));
+    QVERIFY(!QFile::exists(resourcePath));
+}
+
+void ServerTest::testDeduplicatedInsert()
+{
+    const QUrl currentUrl = QUrl::fromLocalFile(QFINDTESTDATA("currentweather.qml"));
+    const QUrl forecastUrl = QUrl::fromLocalFile(QFINDTESTDATA("forecast.qml"));
+
+    //a remote page is served only when allowed, so its loader stays loading until then
+    QTcpServer pageServer;
+    QVERIFY(pageServer.listen(QHostAddress::LocalHost));
+    const QUrl slowUrl(QStringLiteral("http://127.0.0.1:%1/SlowPage.qml").arg(pageServer.serverPort()));
+    QPointer<QTcpSocket> pageRequest;
+    connect(&pageServer, &QTcpServer::newConnection, this, [&pageServer, &pageRequest]() {
+        while (QTcpSocket *socket = pageServer.nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, socket, [socket, &pageRequest]() {
+                if (socket->readAll().startsWith("GET /SlowPage.qml ")) {
+                    pageRequest = socket;
+                } else {
+                    socket->write("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                    socket->disconnectFromHost();
+                }
+            });
+        }
+    });
+
+    DelegatesModel *delegatesModel = m_view->activeSkills()->delegatesModelForSkill(QStringLiteral("mycroft.weather"));
+    QVERIFY(delegatesModel);
+    QCOMPARE(delegatesModel->rowCount(), 1);
+    QCOMPARE(delegatesModel->delegateLoader(0)->url(), currentUrl);
+
+    QSignalSpy rowsInsertedSpy(delegatesModel, &DelegatesModel::rowsInserted);
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.weather\", \"position\": 1, \"data\": [{\"url\": \"%1\"}, {\"url\": \"%2\"}]}")
+                                    .arg(forecastUrl.toString(), slowUrl.toString()));
+    QVERIFY(rowsInsertedSpy.wait());
+    QCOMPARE(delegatesModel->rowCount(), 3);
+    QTRY_VERIFY(pageRequest);
+
+    DelegateLoader *currentLoader = delegatesModel->delegateLoader(0);
+    DelegateLoader *forecastLoader = delegatesModel->delegateLoader(1);
+    DelegateLoader *slowLoader = delegatesModel->delegateLoader(2);
+    QCOMPARE(slowLoader->url(), slowUrl);
+    QVERIFY(!slowLoader->delegate());
+    const int loadersCount = m_view->findChildren<DelegateLoader *>(QString(), Qt::FindDirectChildrenOnly).count();
+    delegatesModel->setCurrentIndex(2);
+
+    //both pages are already there: they get moved in front, nothing is instantiated again
+    rowsInsertedSpy.clear();
+    QSignalSpy rowsMovedSpy(delegatesModel, &DelegatesModel::rowsMoved);
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.weather\", \"position\": 0, \"deduplicate\": true, \"data\": [{\"url\": \"%1\"}, {\"url\": \"%2\"}]}")
+                                    .arg(slowUrl.toString(), forecastUrl.toString()));
+    QVERIFY(rowsMovedSpy.wait());
+    QTRY_COMPARE(rowsMovedSpy.count(), 2);
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+    QCOMPARE(delegatesModel->rowCount(), 3);
+    QCOMPARE(delegatesModel->delegateLoader(0), slowLoader);
+    QCOMPARE(delegatesModel->delegateLoader(1), forecastLoader);
+    QCOMPARE(delegatesModel->delegateLoader(2), currentLoader);
+    QCOMPARE(m_view->findChildren<DelegateLoader *>(QString(), Qt::FindDirectChildrenOnly).count(), loadersCount);
+    QCOMPARE(delegatesModel->property("currentIndex").toInt(), 0);
+
+    //the page still loading gets the focus once created
+    const QByteArray page("import Mycroft 1.0 as Mycroft\nMycroft.Delegate {}\n");
+    QByteArray response("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nConnection: close\r\nContent-Length: ");
+    response += QByteArray::number(page.size()) + "\r\n\r\n" + page;
+    pageRequest->write(response);
+    QTRY_VERIFY(slowLoader->delegate());
+    QVERIFY(slowLoader->delegate()->hasFocus());
+    QCOMPARE(m_view->findChildren<DelegateLoader *>(QString(), Qt::FindDirectChildrenOnly).count(), loadersCount);
+
+    //without the flag duplicates are still inserted
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.weather\", \"position\": 3, \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(forecastUrl.toString()));
+    QVERIFY(rowsInsertedSpy.wait());
+    QCOMPARE(delegatesModel->rowCount(), 4);
+    QVERIFY(delegatesModel->delegateLoader(3) != forecastLoader);
+    QCOMPARE(delegatesModel->delegateLoader(3)->url(), forecastUrl);
+    QCOMPARE(m_view->findChildren<DelegateLoader *>(QString(), Qt::FindDirectChildrenOnly).count(), loadersCount + 1);
+
+    //back to the current weather page only
+    QSignalSpy rowsRemovedSpy(delegatesModel, &DelegatesModel::rowsRemoved);
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.remove\", \"namespace\": \"mycroft.weather\", \"position\": 0, \"items_number\": 2}"));
+    QVERIFY(rowsRemovedSpy.wait());
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.remove\", \"namespace\": \"mycroft.weather\", \"position\": 1, \"items_number\": 1}"));
+    QVERIFY(rowsRemovedSpy.wait());
+    QCOMPARE(delegatesModel->rowCount(), 1);
+    QCOMPARE(delegatesModel->delegateLoader(0), currentLoader);
+}
+
+void ServerTest::testPrefetch()
+{
+    QQmlPropertyMap *creationCounter = new QQmlPropertyMap(this);
+    creationCounter->insert(QStringLiteral("count"), 0);
+    m_window->rootContext()->setContextProperty(QStringLiteral("creationCounter"), creationCounter);
+
+    const QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("prefetchedpage.qml"));
+    const int hits = m_view->prefetchHits();
+    const int misses = m_view->prefetchMisses();
+
+    QSignalSpy skillInsertedSpy(m_view->activeSkills(), &ActiveSkillsModel::rowsInserted);
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.list.insert\", \"namespace\": \"mycroft.system.active_skills\", \"position\": %1, \"data\": [{\"skill_id\": \"mycroft.timer\"}]}")
+                                    .arg(m_view->activeSkills()->rowCount()));
+    QVERIFY(skillInsertedSpy.wait());
+    DelegatesModel *delegatesModel = m_view->activeSkills()->delegatesModelForSkill(QStringLiteral("mycroft.timer"));
+    QVERIFY(delegatesModel);
+    QSignalSpy rowsInsertedSpy(delegatesModel, &DelegatesModel::rowsInserted);
+    QSignalSpy rowsRemovedSpy(delegatesModel, &DelegatesModel::rowsRemoved);
+
+    //an incubated page gets created right away, but is not part of the model
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.prefetch\", \"namespace\": \"mycroft.timer\", \"incubate\": true, \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(url.toString()));
+    QTRY_COMPARE(creationCounter->value(QStringLiteral("count")).toInt(), 1);
+    QCOMPARE(delegatesModel->rowCount(), 0);
+
+    //the insert takes that very instance
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.timer\", \"position\": 0, \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(url.toString()));
+    QVERIFY(rowsInsertedSpy.wait());
+    QVERIFY(delegatesModel->delegateLoader(0)->delegate());
+    QCOMPARE(delegatesModel->delegateLoader(0)->delegate()->skillId(), QStringLiteral("mycroft.timer"));
+    QCOMPARE(creationCounter->value(QStringLiteral("count")).toInt(), 1);
+    QCOMPARE(m_view->prefetchHits(), hits + 1);
+    QCOMPARE(m_view->prefetchMisses(), misses);
+
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.remove\", \"namespace\": \"mycroft.timer\", \"position\": 0, \"items_number\": 1}"));
+    QVERIFY(rowsRemovedSpy.wait());
+
+    //without incubation the page is only compiled: it's created by the insert
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.prefetch\", \"namespace\": \"mycroft.timer\", \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(url.toString()));
+    QTest::qWait(500);
+    QCOMPARE(creationCounter->value(QStringLiteral("count")).toInt(), 1);
+    QCOMPARE(delegatesModel->rowCount(), 0);
+
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.timer\", \"position\": 0, \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(url.toString()));
+    QVERIFY(rowsInsertedSpy.wait());
+    QTRY_COMPARE(creationCounter->value(QStringLiteral("count")).toInt(), 2);
+    QCOMPARE(m_view->prefetchHits(), hits + 2);
+    QCOMPARE(m_view->prefetchMisses(), misses);
+
+    //a page nobody announced
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.list.insert\", \"namespace\": \"mycroft.timer\", \"position\": 1, \"data\": [{\"url\": \"%1\"}]}")
+                                    .arg(url.toString()));
+    QVERIFY(rowsInsertedSpy.wait());
+    QTRY_COMPARE(creationCounter->value(QStringLiteral("count")).toInt(), 3);
+    QCOMPARE(m_view->prefetchHits(), hits + 2);
+    QCOMPARE(m_view->prefetchMisses(), misses + 1);
+    QCOMPARE(m_view->prefetchHitRatio(), qreal(hits + 2) / (hits + 2 + misses + 1));
+
+    QSignalSpy skillRemovedSpy(m_view->activeSkills(), &ActiveSkillsModel::rowsRemoved);
+    m_guiWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.list.remove\", \"namespace\": \"mycroft.system.active_skills\", \"position\": %1, \"items_number\": 1}")
+                                    .arg(m_view->activeSkills()->activeSkills().indexOf(QStringLiteral("mycroft.timer"))));
+    QVERIFY(skillRemovedSpy.wait());
+}
+
+void ServerTest::testSharedConnection()
+{
+    QSignalSpy textFromMainSpy(m_mainWebSocket, &QWebSocket::textMessageReceived);
+
+    QQmlComponent component(m_window->engine());
+    component.setData("import Mycroft 1.0\nAbstractSkillView { connectionGroup: \"shared\" }", QUrl());
+    QScopedPointer<AbstractSkillView> allSkillsView(qobject_cast<AbstractSkillView *>(component.create()));
+    QScopedPointer<AbstractSkillView> wikiView(qobject_cast<AbstractSkillView *>(component.create()));
+    QVERIFY(allSkillsView);
+    QVERIFY(wikiView);
+    wikiView->activeSkills()->setWhiteList({QStringLiteral("mycroft.wiki")});
+
+    //a single gui id for the whole group
+    QVERIFY(!allSkillsView->id().isEmpty());
+    QCOMPARE(wikiView->id(), allSkillsView->id());
+    QVERIFY(allSkillsView->id() != m_view->id());
+
+    textFromMainSpy.wait();
+    QCOMPARE(textFromMainSpy.count(), 1);
+    auto doc = QJsonDocument::fromJson(textFromMainSpy.first().first().toString().toUtf8());
+    QCOMPARE(doc[QStringLiteral("type")].toString(), QStringLiteral("mycroft.gui.connected"));
+    QCOMPARE(doc[QStringLiteral("data")][QStringLiteral("gui_id")].toString(), allSkillsView->id());
+
+    QSignalSpy newGuiConnectionSpy(m_guiServerSocket, &QWebSocketServer::newConnection);
+    QSignalSpy statusSpy(wikiView.data(), &AbstractSkillView::statusChanged);
+    m_mainWebSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.gui.port\", \"data\": {\"gui_id\": \"%1\", \"port\": 1818}}").arg(allSkillsView->id()));
+    newGuiConnectionSpy.wait();
+    QCOMPARE(newGuiConnectionSpy.count(), 1);
+    QScopedPointer<QWebSocket> sharedSocket(m_guiServerSocket->nextPendingConnection());
+    QVERIFY(sharedSocket);
+    while (wikiView->status() != MycroftController::Open) {
+        QVERIFY(statusSpy.wait());
+    }
+    QCOMPARE(allSkillsView->status(), MycroftController::Open);
+
+    //both views get the whole active skills list
+    QSignalSpy insertedSpy(wikiView->activeSkills(), &ActiveSkillsModel::rowsInserted);
+    sharedSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.list.insert\", \"namespace\": \"mycroft.system.active_skills\", \"position\": 0, \"data\": [{\"skill_id\": \"mycroft.weather\"}, {\"skill_id\": \"mycroft.wiki\"}]}"));
+    insertedSpy.wait();
+    QCOMPARE(allSkillsView->activeSkills()->rowCount(), 2);
+    QCOMPARE(wikiView->activeSkills()->rowCount(), 2);
+
+    //skill data is routed only to the views showing the skill
+    SessionDataMap *weatherMap = allSkillsView->sessionDataForSkill(QStringLiteral("mycroft.weather"));
+    QVERIFY(weatherMap);
+    QSignalSpy weatherChangedSpy(weatherMap, &SessionDataMap::valueChanged);
+    sharedSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.set\", \"namespace\": \"mycroft.weather\", \"data\": {\"temperature\": \"28\"}}"));
+    weatherChangedSpy.wait();
+    QCOMPARE(weatherMap->value(QStringLiteral("temperature")), QVariant(QStringLiteral("28")));
+    QVERIFY(!wikiView->sessionDataForSkill(QStringLiteral("mycroft.weather"))->contains(QStringLiteral("temperature")));
+
+    SessionDataMap *wikiMap = wikiView->sessionDataForSkill(QStringLiteral("mycroft.wiki"));
+    QVERIFY(wikiMap);
+    QSignalSpy wikiChangedSpy(wikiMap, &SessionDataMap::valueChanged);
+    sharedSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.set\", \"namespace\": \"mycroft.wiki\", \"data\": {\"title\": \"Shared\"}}"));
+    wikiChangedSpy.wait();
+    QCOMPARE(wikiMap->value(QStringLiteral("title")), QVariant(QStringLiteral("Shared")));
+    QCOMPARE(allSkillsView->sessionDataForSkill(QStringLiteral("mycroft.wiki"))->value(QStringLiteral("title")), QVariant(QStringLiteral("Shared")));
+
+    //a view joining later gets the whole state, as the server sends it again on a new connection
+    newGuiConnectionSpy.clear();
+    QScopedPointer<AbstractSkillView> lateView(qobject_cast<AbstractSkillView *>(component.create()));
+    QVERIFY(lateView);
+    QCOMPARE(lateView->id(), allSkillsView->id());
+    QVERIFY(newGuiConnectionSpy.wait());
+    sharedSocket.reset(m_guiServerSocket->nextPendingConnection());
+    QVERIFY(sharedSocket);
+    QTRY_COMPARE(lateView->status(), MycroftController::Open);
+    //the views already there dropped their state to not get it twice
+    QCOMPARE(allSkillsView->activeSkills()->rowCount(), 0);
+    QCOMPARE(wikiView->activeSkills()->rowCount(), 0);
+
+    sharedSocket->sendTextMessage(QStringLiteral("{\"type\": \"mycroft.session.list.insert\", \"namespace\": \"mycroft.system.active_skills\", \"position\": 0, \"data\": [{\"skill_id\": \"mycroft.weather\"}, {\"skill_id\": \"mycroft.wiki\"}]}"));
+    QTRY_COMPARE(lateView->activeSkills()->rowCount(), 2);
+    QCOMPARE(allSkillsView->activeSkills()->rowCount(), 2);
+    QCOMPARE(wikiView->activeSkills()->rowCount(), 2);
+
+    //the connection stays open as long as a view of the group uses it
+    QSignalSpy disconnectedSpy(sharedSocket.data(), &QWebSocket::disconnected);
+    wikiView.reset();
+    lateView.reset();
+    QVERIFY(!disconnectedSpy.wait(200));
+    allSkillsView.reset();
+    QVERIFY(disconnectedSpy.wait());
+}
+
 QTEST_MAIN(ServerTest);
 
 #include "servertest.moc"
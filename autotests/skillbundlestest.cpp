@@ -0,0 +1,162 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include "../import/skillbundles.h"
+
+class SkillBundlesTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testResolve();
+    void testFallback();
+    void testRepack();
+
+private:
+    QString installSkill(const QString &name);
+    QUrl bundleUrl(const QString &skillPath, const QString &file) const;
+
+    QTemporaryDir m_skillsDir;
+};
+
+void SkillBundlesTest::initTestCase()
+{
+    QVERIFY(m_skillsDir.isValid());
+    QVERIFY(QFile::exists(QStringLiteral(SKILL_BUNDLE_RCC)));
+}
+
+// A skill directory with the fixture bundle as its ui.rcc, returns its path
+QString SkillBundlesTest::installSkill(const QString &name)
+{
+    const QString skillPath = m_skillsDir.path() + QLatin1Char('/') + name;
+    if (!QDir().mkpath(skillPath)) {
+        return QString();
+    }
+
+    // Like the pack tool, the new bundle gets renamed over the old one
+    const QString tempPath = skillPath + QStringLiteral("/ui.rcc.new");
+    QFile::remove(tempPath);
+    if (!QFile::copy(QStringLiteral(SKILL_BUNDLE_RCC), tempPath)) {
+        return QString();
+    }
+    QFile::remove(skillPath + QStringLiteral("/ui.rcc"));
+    if (!QFile::rename(tempPath, skillPath + QStringLiteral("/ui.rcc"))) {
+        return QString();
+    }
+    return skillPath;
+}
+
+QUrl SkillBundlesTest::bundleUrl(const QString &skillPath, const QString &file) const
+{
+    QUrl url = QUrl::fromLocalFile(skillPath + QStringLiteral("/ui/") + file);
+    url.setScheme(QStringLiteral("bundle"));
+    return url;
+}
+
+void SkillBundlesTest::testResolve()
+{
+    const QString skillPath = installSkill(QStringLiteral("skill-weather"));
+    QVERIFY(!skillPath.isEmpty());
+
+    SkillBundles *bundles = SkillBundles::instance();
+    bundles->acquire(QStringLiteral("mycroft.weather"));
+
+    const QUrl pageUrl = bundles->resolve(QStringLiteral("mycroft.weather"), bundleUrl(skillPath, QStringLiteral("BundledPage.qml")));
+    QCOMPARE(pageUrl.scheme(), QStringLiteral("qrc"));
+    QVERIFY(pageUrl.path().startsWith(QLatin1String("/skills/mycroft.weather/")));
+    QVERIFY(pageUrl.path().endsWith(QLatin1String("/ui/BundledPage.qml")));
+    QVERIFY(QFile::exists(QLatin1Char(':') + pageUrl.path()));
+
+    //files in subdirectories are mapped under the same root
+    const QUrl imageUrl = bundles->resolve(QStringLiteral("mycroft.weather"), bundleUrl(skillPath, QStringLiteral("images/dot.svg")));
+    QCOMPARE(imageUrl.scheme(), QStringLiteral("qrc"));
+    QCOMPARE(imageUrl.path(), pageUrl.path().replace(QStringLiteral("BundledPage.qml"), QStringLiteral("images/dot.svg")));
+
+    bundles->release(QStringLiteral("mycroft.weather"));
+    QVERIFY(!QFile::exists(QLatin1Char(':') + pageUrl.path()));
+}
+
+void SkillBundlesTest::testFallback()
+{
+    SkillBundles *bundles = SkillBundles::instance();
+
+    //no ui.rcc next to the ui directory
+    const QString loosePath = m_skillsDir.path() + QStringLiteral("/skill-loose");
+    QVERIFY(QDir().mkpath(loosePath));
+    bundles->acquire(QStringLiteral("mycroft.loose"));
+    QCOMPARE(bundles->resolve(QStringLiteral("mycroft.loose"), bundleUrl(loosePath, QStringLiteral("BundledPage.qml"))),
+             QUrl::fromLocalFile(loosePath + QStringLiteral("/ui/BundledPage.qml")));
+    bundles->release(QStringLiteral("mycroft.loose"));
+
+    //a file the bundle doesn't have
+    const QString skillPath = installSkill(QStringLiteral("skill-missing"));
+    QVERIFY(!skillPath.isEmpty());
+    bundles->acquire(QStringLiteral("mycroft.missing"));
+    QCOMPARE(bundles->resolve(QStringLiteral("mycroft.missing"), bundleUrl(skillPath, QStringLiteral("Missing.qml"))),
+             QUrl::fromLocalFile(skillPath + QStringLiteral("/ui/Missing.qml")));
+
+    //not inside a ui directory
+    QUrl outsideUrl = QUrl::fromLocalFile(skillPath + QStringLiteral("/BundledPage.qml"));
+    outsideUrl.setScheme(QStringLiteral("bundle"));
+    QCOMPARE(bundles->resolve(QStringLiteral("mycroft.missing"), outsideUrl), QUrl::fromLocalFile(skillPath + QStringLiteral("/BundledPage.qml")));
+    bundles->release(QStringLiteral("mycroft.missing"));
+
+    //other schemes are left alone
+    const QUrl fileUrl = QUrl::fromLocalFile(skillPath + QStringLiteral("/ui/BundledPage.qml"));
+    QCOMPARE(bundles->resolve(QStringLiteral("mycroft.missing"), fileUrl), fileUrl);
+}
+
+void SkillBundlesTest::testRepack()
+{
+    const QString skillPath = installSkill(QStringLiteral("skill-news"));
+    QVERIFY(!skillPath.isEmpty());
+
+    SkillBundles *bundles = SkillBundles::instance();
+    bundles->acquire(QStringLiteral("mycroft.news"));
+    const QUrl oldUrl = bundles->resolve(QStringLiteral("mycroft.news"), bundleUrl(skillPath, QStringLiteral("BundledPage.qml")));
+    QCOMPARE(oldUrl.scheme(), QStringLiteral("qrc"));
+
+    //make sure the modification time changes
+    QTest::qWait(50);
+    QVERIFY(!installSkill(QStringLiteral("skill-news")).isEmpty());
+
+    const QUrl newUrl = bundles->resolve(QStringLiteral("mycroft.news"), bundleUrl(skillPath, QStringLiteral("BundledPage.qml")));
+    QCOMPARE(newUrl.scheme(), QStringLiteral("qrc"));
+    QVERIFY(newUrl != oldUrl);
+    //the pages already loaded keep reading the previous bundle
+    QVERIFY(QFile::exists(QLatin1Char(':') + oldUrl.path()));
+    QVERIFY(QFile::exists(QLatin1Char(':') + newUrl.path()));
+
+    //an unchanged bundle is not registered again
+    QCOMPARE(bundles->resolve(QStringLiteral("mycroft.news"), bundleUrl(skillPath, QStringLiteral("BundledPage.qml"))), newUrl);
+
+    //references are counted, the skill is gone only with the last one
+    bundles->acquire(QStringLiteral("mycroft.news"));
+    bundles->release(QStringLiteral("mycroft.news"));
+    QVERIFY(QFile::exists(QLatin1Char(':') + newUrl.path()));
+
+    bundles->release(QStringLiteral("mycroft.news"));
+    QVERIFY(!QFile::exists(QLatin1Char(':') + oldUrl.path()));
+    QVERIFY(!QFile::exists(QLatin1Char(':') + newUrl.path()));
+}
+
+QTEST_GUILESS_MAIN(SkillBundlesTest);
+
+#include "skillbundlestest.moc"
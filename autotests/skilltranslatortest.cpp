@@ -0,0 +1,193 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <algorithm>
+#include <QTemporaryDir>
+#include "../import/skilltranslator.h"
+
+// Same hash as QTranslator uses to look up the messages of a .qm file
+static quint32 elfHash(const QByteArray &text)
+{
+    quint32 h = 0;
+    for (const char c : text) {
+        h = (h << 4) + quint8(c);
+        const quint32 g = h & 0xf0000000;
+        if (g) {
+            h ^= g >> 24;
+        }
+        h &= ~g;
+    }
+    return h ? h : 1;
+}
+
+// A minimal .qm file, as lrelease would write it, with all the messages in one context
+static bool writeCatalog(const QString &fileName, const QByteArray &context, const QList<QPair<QByteArray, QString>> &messages)
+{
+    QByteArray messagesBlock;
+    //hash and offset of each message, sorted by hash
+    QVector<QPair<quint32, quint32>> offsets;
+    {
+        QDataStream stream(&messagesBlock, QIODevice::WriteOnly);
+        for (const auto &message : messages) {
+            offsets << qMakePair(elfHash(message.first), quint32(messagesBlock.size()));
+            stream << quint8(0x03) << quint32(message.second.size() * 2);
+            for (const QChar c : message.second) {
+                stream << quint16(c.unicode());
+            }
+            stream << quint8(0x06) << quint32(message.first.size());
+            stream.writeRawData(message.first.constData(), message.first.size());
+            stream << quint8(0x07) << quint32(context.size());
+            stream.writeRawData(context.constData(), context.size());
+            stream << quint8(0x01);
+        }
+    }
+
+    std::sort(offsets.begin(), offsets.end());
+
+    QByteArray hashesBlock;
+    {
+        QDataStream stream(&hashesBlock, QIODevice::WriteOnly);
+        for (const auto &offset : offsets) {
+            stream << offset.first << offset.second;
+        }
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    static const quint8 magic[16] = {0x3c, 0xb8, 0x64, 0x18, 0xca, 0xef, 0x9c, 0x95,
+                                     0xcd, 0x21, 0x1c, 0xbf, 0x60, 0xa1, 0xbd, 0xdd};
+    stream.writeRawData(reinterpret_cast<const char *>(magic), sizeof(magic));
+    stream << quint8(0x42) << quint32(hashesBlock.size());
+    stream.writeRawData(hashesBlock.constData(), hashesBlock.size());
+    stream << quint8(0x69) << quint32(messagesBlock.size());
+    stream.writeRawData(messagesBlock.constData(), messagesBlock.size());
+    return true;
+}
+
+class SkillTranslatorTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testRouting();
+    void testSharedFileName();
+
+private:
+    QString createSkill(const QString &skillId, const QList<QPair<QByteArray, QString>> &messages);
+    void acquire(const QString &skillId, const QString &translationsPath);
+
+    QTemporaryDir m_skillsDir;
+};
+
+void SkillTranslatorTest::initTestCase()
+{
+    QVERIFY(m_skillsDir.isValid());
+    QLocale::setDefault(QLocale(QLocale::Italian, QLocale::Italy));
+}
+
+// A skill with a single Main.qml page, returns its translations directory
+QString SkillTranslatorTest::createSkill(const QString &skillId, const QList<QPair<QByteArray, QString>> &messages)
+{
+    const QString uiPath = m_skillsDir.path() + QLatin1Char('/') + skillId + QStringLiteral("/ui");
+    const QString translationsPath = uiPath + QStringLiteral("/translations");
+    if (!QDir().mkpath(translationsPath)) {
+        return QString();
+    }
+
+    QFile page(uiPath + QStringLiteral("/Main.qml"));
+    if (!page.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    page.write("import QtQuick 2.9\nItem {}\n");
+    page.close();
+
+    if (!writeCatalog(translationsPath + QLatin1Char('/') + skillId + QStringLiteral("_it.qm"), "Main", messages)) {
+        return QString();
+    }
+    return translationsPath;
+}
+
+static QStringList loadedSkills(const QSignalSpy &spy)
+{
+    QStringList skills;
+    for (const auto &arguments : spy) {
+        skills << arguments.first().toString();
+    }
+    return skills;
+}
+
+void SkillTranslatorTest::acquire(const QString &skillId, const QString &translationsPath)
+{
+    QSignalSpy loadedSpy(SkillTranslator::instance(), &SkillTranslator::catalogLoaded);
+    SkillTranslator::instance()->acquire(skillId, translationsPath);
+    QTRY_VERIFY(loadedSkills(loadedSpy).contains(skillId));
+}
+
+void SkillTranslatorTest::testRouting()
+{
+    const QString translationsPath = createSkill(QStringLiteral("mycroft.weather"), {{"Today", QStringLiteral("Oggi")}});
+    QVERIFY(!translationsPath.isEmpty());
+
+    QCOMPARE(QCoreApplication::translate("Main", "Today"), QStringLiteral("Today"));
+
+    acquire(QStringLiteral("mycroft.weather"), translationsPath);
+    QCOMPARE(QCoreApplication::translate("Main", "Today"), QStringLiteral("Oggi"));
+    //only the contexts of the skill files are routed to its catalog
+    QCOMPARE(QCoreApplication::translate("SettingsPage", "Today"), QStringLiteral("Today"));
+
+    SkillTranslator::instance()->release(QStringLiteral("mycroft.weather"));
+    QCOMPARE(QCoreApplication::translate("Main", "Today"), QStringLiteral("Today"));
+    QVERIFY(SkillTranslator::instance()->isEmpty());
+}
+
+void SkillTranslatorTest::testSharedFileName()
+{
+    const QString newsPath = createSkill(QStringLiteral("mycroft.news"), {{"Play", QStringLiteral("Riproduci notizie")},
+                                                                           {"Stop", QStringLiteral("Ferma")}});
+    const QString musicPath = createSkill(QStringLiteral("mycroft.music"), {{"Play", QStringLiteral("Riproduci musica")},
+                                                                             {"Stop", QStringLiteral("Ferma")}});
+    QVERIFY(!newsPath.isEmpty());
+    QVERIFY(!musicPath.isEmpty());
+
+    acquire(QStringLiteral("mycroft.news"), newsPath);
+    QCOMPARE(QCoreApplication::translate("Main", "Play"), QStringLiteral("Riproduci notizie"));
+
+    //both skills have a Main.qml: neither gets the translations of the other
+    QSignalSpy loadedSpy(SkillTranslator::instance(), &SkillTranslator::catalogLoaded);
+    acquire(QStringLiteral("mycroft.music"), musicPath);
+    QCOMPARE(QCoreApplication::translate("Main", "Play"), QStringLiteral("Play"));
+    QCOMPARE(QCoreApplication::translate("Main", "Stop"), QStringLiteral("Ferma"));
+    //the pages already shown by the other skill need to be retranslated
+    QVERIFY(loadedSkills(loadedSpy).contains(QStringLiteral("mycroft.news")));
+
+    loadedSpy.clear();
+    SkillTranslator::instance()->release(QStringLiteral("mycroft.news"));
+    QCOMPARE(QCoreApplication::translate("Main", "Play"), QStringLiteral("Riproduci musica"));
+    QCOMPARE(loadedSkills(loadedSpy), QStringList{QStringLiteral("mycroft.music")});
+
+    SkillTranslator::instance()->release(QStringLiteral("mycroft.music"));
+    QCOMPARE(QCoreApplication::translate("Main", "Play"), QStringLiteral("Play"));
+}
+
+QTEST_MAIN(SkillTranslatorTest);
+
+#include "skilltranslatortest.moc"
@@ -0,0 +1,265 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <QtTest>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <cmath>
+#include <functional>
+#include "wavfile.h"
+#include "../import/mediaservice.h"
+#include "../import/spectrumbuffer.h"
+#include "../import/spectrumitem.h"
+
+static const int s_sampleRate = 8000;
+static const int s_bins = 256;
+
+// Keeps what the item sent to the scene graph in its last frame
+class RecordingSpectrumItem : public SpectrumItem
+{
+public:
+    explicit RecordingSpectrumItem(QQuickItem *parent)
+        : SpectrumItem(parent)
+    {}
+
+    // Highest bar and peak marker, as fractions of the height
+    float highestBar()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_highestBar;
+    }
+    float highestPeak()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_highestPeak;
+    }
+    int barVertices()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_barVertices;
+    }
+
+protected:
+    // Called in the render thread while the GUI thread is blocked
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override
+    {
+        QSGGeometryNode *node = static_cast<QSGGeometryNode *>(SpectrumItem::updatePaintNode(oldNode, data));
+        QSGGeometry *bars = node->geometry();
+        QSGGeometry *peaks = static_cast<QSGGeometryNode *>(node->firstChild())->geometry();
+        const float h = height();
+
+        QMutexLocker locker(&m_mutex);
+        m_barVertices = bars->vertexCount();
+        m_highestBar = 0;
+        for (int i = 0; i < bars->vertexCount(); ++i) {
+            m_highestBar = qMax(m_highestBar, 1 - bars->vertexDataAsPoint2D()[i].y / h);
+        }
+        // The bottom edge of each marker is at the peak level
+        m_highestPeak = 0;
+        for (int i = 5; i < peaks->vertexCount(); i += 6) {
+            m_highestPeak = qMax(m_highestPeak, 1 - peaks->vertexDataAsPoint2D()[i].y / h);
+        }
+        return node;
+    }
+
+private:
+    QMutex m_mutex;
+    float m_highestBar = 0;
+    float m_highestPeak = 0;
+    int m_barVertices = 0;
+};
+
+class SpectrumTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSingleBin();
+    void testFlatSpectrum();
+    void testNarrowBands();
+    void testFrequencyClamping();
+    void testSpectrumItem();
+    void testTopBins();
+
+private:
+    QAudioBuffer toneBuffer(qreal frequency, qreal amplitude) const;
+};
+
+// A buffer of 16 bit stereo samples as the probe delivers it
+QAudioBuffer SpectrumTest::toneBuffer(qreal frequency, qreal amplitude) const
+{
+    QAudioFormat format;
+    format.setSampleRate(44100);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    // Without the WAV header
+    return QAudioBuffer(WavFile::sine(44100, 2, 1024, frequency, amplitude).mid(44), format);
+}
+
+void SpectrumTest::testSingleBin()
+{
+    const float minFrequency = 50;
+    const float maxFrequency = 4000;
+    QVector<float> bands(10);
+
+    // Bin k is centered on k * 8000 / 512 Hz, 64 is 1000 Hz
+    QVector<float> magnitudes(s_bins, 0);
+    magnitudes[64] = 1;
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, minFrequency, maxFrequency, bands);
+
+    const int expectedBand = int(bands.size() * std::log(1000.0f / minFrequency) / std::log(maxFrequency / minFrequency));
+    for (int i = 0; i < bands.size(); ++i) {
+        if (i == expectedBand) {
+            QVERIFY(bands[i] > 0);
+        } else {
+            QCOMPARE(bands[i], 0.0f);
+        }
+    }
+}
+
+void SpectrumTest::testFlatSpectrum()
+{
+    // Low bands are narrower than a bin, high ones span many
+    const QVector<float> magnitudes(s_bins, 0.5f);
+    QVector<float> bands(40);
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, 20, 4000, bands);
+
+    for (const float band : bands) {
+        QCOMPARE(band, 0.5f);
+    }
+}
+
+void SpectrumTest::testNarrowBands()
+{
+    // A ramp: interpolating between two bins gives the position between them
+    QVector<float> magnitudes(s_bins);
+    for (int k = 0; k < s_bins; ++k) {
+        magnitudes[k] = k;
+    }
+
+    const float minFrequency = 100;
+    const float maxFrequency = 200;
+    QVector<float> bands(50);
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, minFrequency, maxFrequency, bands);
+
+    const float binsPerHz = 2.0f * s_bins / s_sampleRate;
+    for (int i = 0; i < bands.size(); ++i) {
+        const float low = minFrequency * std::pow(maxFrequency / minFrequency, float(i) / bands.size()) * binsPerHz;
+        const float high = minFrequency * std::pow(maxFrequency / minFrequency, float(i + 1) / bands.size()) * binsPerHz;
+        // A band containing a bin takes its value, which is within the band as well
+        QVERIFY2(qAbs(bands[i] - (low + high) / 2) <= (high - low) / 2 + 1e-3,
+                 qPrintable(QStringLiteral("band %1: %2").arg(i).arg(bands[i])));
+    }
+}
+
+void SpectrumTest::testFrequencyClamping()
+{
+    QVector<float> magnitudes(s_bins);
+    for (int k = 0; k < s_bins; ++k) {
+        magnitudes[k] = k;
+    }
+
+    // Out of range frequencies are clamped between 1 Hz and Nyquist
+    QVector<float> clamped(16);
+    QVector<float> expected(16);
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, -100, 100000, clamped);
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, 1, s_sampleRate / 2, expected);
+    QCOMPARE(clamped, expected);
+
+    // A maximum below the minimum collapses every band on the minimum
+    SpectrumBuffer::aggregateBands(magnitudes, s_sampleRate, 1000, 500, clamped);
+    for (const float band : clamped) {
+        QVERIFY(qAbs(band - 1000 * 2.0f * s_bins / s_sampleRate) < 1e-3);
+    }
+
+    // Nothing to aggregate
+    SpectrumBuffer::aggregateBands(QVector<float>(), s_sampleRate, 50, 4000, clamped);
+    QCOMPARE(clamped, QVector<float>(16, 0));
+}
+
+void SpectrumTest::testSpectrumItem()
+{
+    MediaService service;
+    // Creates the spectrum worker without playing anything
+    service.setupProbeSource();
+
+    QQuickWindow window;
+    window.resize(200, 100);
+    RecordingSpectrumItem item(window.contentItem());
+    item.setSize(QSizeF(200, 100));
+    item.setBands(8);
+    // The whole height in a second
+    item.setPeakDecay(1);
+    item.setSource(&service);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    const QAudioBuffer tone = toneBuffer(1000, 0.5);
+    const QAudioBuffer silence = toneBuffer(1000, 0);
+    auto play = [&](const QAudioBuffer &buffer, std::function<bool()> until) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!until() && timer.elapsed() < 5000) {
+            service.processBuffer(buffer);
+            QTest::qWait(20);
+        }
+        return until();
+    };
+
+    QVERIFY(play(tone, [&]() { return item.highestBar() > 0.2f; }));
+    QCOMPARE(item.barVertices(), 8 * 6);
+    QVERIFY(item.highestPeak() >= item.highestBar());
+
+    // On silence the bars drop right away, the peaks fall down over a few frames
+    QVERIFY(play(silence, [&]() { return item.highestBar() == 0; }));
+    const float peak = item.highestPeak();
+    QVERIFY(peak > 0);
+    QTRY_VERIFY(item.highestPeak() < peak);
+    QTRY_COMPARE_WITH_TIMEOUT(item.highestPeak(), 0.0f, 2000);
+}
+
+void SpectrumTest::testTopBins()
+{
+    MediaService service;
+    service.setupProbeSource();
+
+    // The highest frequencies end up in the last bins of the worker spectrum,
+    // which don't make a group of their own when the groups are sized by truncation
+    const QAudioBuffer tone = toneBuffer(20000, 0.5);
+    QVector<double> spectrum;
+    connect(&service, &MediaService::spectrumChanged, this, [&]() {
+        spectrum = service.spectrum();
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    while ((spectrum.isEmpty() || spectrum.last() == 0) && timer.elapsed() < 5000) {
+        service.processBuffer(tone);
+        QTest::qWait(20);
+    }
+    QCOMPARE(spectrum.size(), 20);
+    QVERIFY(spectrum.last() > 0);
+}
+
+QTEST_MAIN(SpectrumTest);
+
+#include "spectrumtest.moc"
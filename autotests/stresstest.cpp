@@ -28,6 +28,7 @@
 #include "../import/activeskillsmodel.h"
 #include "../import/delegatesmodel.h"
 #include "../import/abstractskillview.h"
+#include "../import/performancehud.h"
 #include "../import/sessiondatamap.h"
 #include "../import/sessiondatamodel.h"
 
@@ -75,10 +76,10 @@ static QObject *fileReaderSingletonProvider(QQmlEngine *engine, QJSEngine *scrip
 
 static QObject *globalSettingsSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
 {
-    Q_UNUSED(engine)
     Q_UNUSED(scriptEngine)
 
-    return new GlobalSettings;
+    engine->setObjectOwnership(GlobalSettings::instance(), QQmlEngine::CppOwnership);
+    return GlobalSettings::instance();
 }
 
 static QObject *mycroftControllerSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
@@ -144,6 +145,7 @@ void ServerTest::initTestCase()
         qmlRegisterSingletonType<FileReader>("Mycroft", 1, 0, "FileReader", fileReaderSingletonProvider);
         qmlRegisterType<AbstractSkillView>("Mycroft", 1, 0, "AbstractSkillView");
         qmlRegisterType<AbstractDelegate>("Mycroft", 1, 0, "AbstractDelegate");
+        qmlRegisterType<PerformanceHud>("Mycroft", 1, 0, "PerformanceHud");
 
         qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AudioPlayer.qml")), "Mycroft", 1, 0, "AudioPlayer");
         qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AutoFitLabel.qml")), "Mycroft", 1, 0, "AutoFitLabel");
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QtEndian>
+#include <cmath>
+
+/**
+ * Test audio files, written by the autotests which play or analyze sound
+ */
+namespace WavFile
+{
+
+inline void appendLE32(QByteArray &data, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, reinterpret_cast<uchar *>(bytes));
+    data.append(bytes, 4);
+}
+
+inline void appendLE16(QByteArray &data, quint16 value)
+{
+    char bytes[2];
+    qToLittleEndian(value, reinterpret_cast<uchar *>(bytes));
+    data.append(bytes, 2);
+}
+
+/**
+ * A 16 bit PCM WAV of frames frames with a sine of the given frequency on every channel,
+ * amplitude is a fraction of the full scale
+ */
+inline QByteArray sine(int sampleRate, int channels, int frames, qreal frequency, qreal amplitude)
+{
+    const int frameSize = channels * 2;
+
+    QByteArray wav;
+    wav.append("RIFF");
+    appendLE32(wav, 36 + frames * frameSize);
+    wav.append("WAVE");
+    wav.append("fmt ");
+    appendLE32(wav, 16);
+    appendLE16(wav, 1); //PCM
+    appendLE16(wav, channels);
+    appendLE32(wav, sampleRate);
+    appendLE32(wav, sampleRate * frameSize);
+    appendLE16(wav, frameSize);
+    appendLE16(wav, 16);
+    wav.append("data");
+    appendLE32(wav, frames * frameSize);
+    for (int i = 0; i < frames; ++i) {
+        const quint16 value = quint16(qint16(32767 * amplitude * std::sin(2 * M_PI * frequency * i / sampleRate)));
+        for (int channel = 0; channel < channels; ++channel) {
+            appendLE16(wav, value);
+        }
+    }
+    return wav;
+}
+
+}
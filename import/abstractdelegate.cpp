@@ -17,10 +17,25 @@
 
 #include "abstractdelegate.h"
 #include "mycroftcontroller.h"
+#include "metricsregistry.h"
 
 #include <QQmlEngine>
 #include <QQmlContext>
+#include <QElapsedTimer>
 
+static MetricGauge *liveDelegates()
+{
+    static MetricGauge *s_gauge = MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_delegates"),
+                                                                     QStringLiteral("Skill delegates currently instantiated"));
+    return s_gauge;
+}
+
+static MetricGauge *pendingDelegates()
+{
+    static MetricGauge *s_gauge = MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_delegates_pending"),
+                                                                     QStringLiteral("Skill delegates waiting for their QML file to load"));
+    return s_gauge;
+}
 
 DelegateLoader::DelegateLoader(AbstractSkillView *parent)
     : QObject(parent),
@@ -29,12 +44,15 @@ DelegateLoader::DelegateLoader(AbstractSkillView *parent)
 
 DelegateLoader::~DelegateLoader()
 {
+    if (m_pending) {
+        pendingDelegates()->add(-1);
+    }
     if (m_delegate) {
         m_delegate->deleteLater();
     }
 }
 
-void DelegateLoader::init(const QString skillId, const QUrl &delegateUrl)
+void DelegateLoader::init(const QString skillId, const QUrl &delegateUrl, AbstractDelegate *incubatedDelegate)
 {
     if (!m_skillId.isEmpty()) {
         qWarning() << "Init already called";
@@ -42,6 +60,13 @@ void DelegateLoader::init(const QString skillId, const QUrl &delegateUrl)
 
     m_skillId = skillId;
     m_delegateUrl = delegateUrl;
+
+    if (incubatedDelegate) {
+        m_delegate = incubatedDelegate;
+        connect(m_delegate, &QObject::destroyed, this, &QObject::deleteLater);
+        return;
+    }
+
     QQmlEngine *engine = qmlEngine(m_view);
     //This class should be *ALWAYS* created from QML
     Q_ASSERT(engine);
@@ -59,6 +84,8 @@ void DelegateLoader::init(const QString skillId, const QUrl &delegateUrl)
         createObject();
         break;
     case QQmlComponent::Loading:
+        m_pending = true;
+        pendingDelegates()->add(1);
         connect(m_component, &QQmlComponent::statusChanged, this, &DelegateLoader::createObject);
         break;
     default:
@@ -76,10 +103,20 @@ QUrl DelegateLoader::translationsUrl() const
 
 void DelegateLoader::createObject()
 {
+    if (m_pending) {
+        m_pending = false;
+        pendingDelegates()->add(-1);
+    }
+
     QQmlContext *context = QQmlEngine::contextForObject(m_view);
     //This class should be *ALWAYS* created from QML
     Q_ASSERT(context);
 
+    static MetricHistogram *s_creationTime = MetricsRegistry::instance()->histogram(QStringLiteral("mycroft_gui_delegate_creation_seconds"),
+                                                                                   QStringLiteral("Time spent instantiating skill delegates"));
+    QElapsedTimer creationTimer;
+    creationTimer.start();
+
     QObject *guiObject = m_component->beginCreate(context);
     m_delegate = qobject_cast<AbstractDelegate *>(guiObject);
     if (m_component->isError()) {
@@ -103,6 +140,7 @@ void DelegateLoader::createObject()
     m_delegate->setSkillView(m_view);
     m_delegate->setSessionData(m_view->sessionDataForSkill(m_skillId));
     m_component->completeCreate();
+    s_creationTime->observe(creationTimer.nsecsElapsed());
 
     emit delegateCreated();
 
@@ -116,6 +154,11 @@ AbstractDelegate *DelegateLoader::delegate()
     return m_delegate;
 }
 
+QUrl DelegateLoader::url() const
+{
+    return m_delegateUrl;
+}
+
 void DelegateLoader::setFocus(bool focus)
 {
     m_focus = focus;
@@ -135,10 +178,12 @@ AbstractDelegate::AbstractDelegate(QQuickItem *parent)
     setFiltersChildMouseEvents(true);
     setFlags(QQuickItem::ItemIsFocusScope);
     setAcceptedMouseButtons(Qt::LeftButton);
+    liveDelegates()->add(1);
 }
 
 AbstractDelegate::~AbstractDelegate()
 {
+    liveDelegates()->add(-1);
 }
 
 void AbstractDelegate::triggerGuiEvent(const QString &eventName, const QVariantMap &parameters)
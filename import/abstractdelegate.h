@@ -33,9 +33,18 @@ public:
     DelegateLoader(AbstractSkillView *parent);
     ~DelegateLoader();
 
-    void init(const QString skillId, const QUrl &url);
+    /**
+     * Starts loading the delegate. If incubatedDelegate is given, it's an instance
+     * already created for this skill and url by the PagePrefetcher and gets used as is
+     */
+    void init(const QString skillId, const QUrl &url, AbstractDelegate *incubatedDelegate = nullptr);
     AbstractDelegate *delegate();
 
+    /**
+     * Url of the qml file this loader instantiates, available as soon as init() has been called
+     */
+    QUrl url() const;
+
     void setFocus(bool focus);
 
     QUrl translationsUrl() const;
@@ -49,6 +58,8 @@ private:
     QString m_skillId;
     QUrl m_delegateUrl;
     bool m_focus = false;
+    //accounted in the pending delegates metric
+    bool m_pending = false;
     QQmlComponent *m_component = nullptr;
     AbstractSkillView *m_view;
     QPointer <AbstractDelegate> m_delegate;
@@ -19,81 +19,58 @@
 #include "abstractskillview.h"
 #include "activeskillsmodel.h"
 #include "abstractdelegate.h"
+#include "blobstore.h"
 #include "sessiondatamap.h"
 #include "sessiondatamodel.h"
 #include "delegatesmodel.h"
+#include "globalsettings.h"
+#include "skilltranslator.h"
+#include "pageprefetcher.h"
+#include "skillbundles.h"
+#include "guiconnection.h"
+#include "latencyprobe.h"
+#include "messagetracer.h"
+#include "metricsregistry.h"
 
-#include <QWebSocket>
-#include <QUuid>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QQmlContext>
 #include <QQmlEngine>
-#include <QTranslator>
+#include <QQmlFile>
 
 AbstractSkillView::AbstractSkillView(QQuickItem *parent)
     : QQuickItem(parent),
-      m_id(QUuid::createUuid().toString()),
-      m_controller(MycroftController::instance())
+      m_controller(MycroftController::instance()),
+      m_settings(GlobalSettings::instance())
 {
     m_activeSkillsModel = new ActiveSkillsModel(this);
-
-    m_guiWebSocket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
-    m_controller->registerView(this);
-
-    connect(m_guiWebSocket, &QWebSocket::connected, this,
-            [this] () {
-                m_reconnectTimer.stop();
-                emit statusChanged();
-            });
-
-    connect(m_guiWebSocket, &QWebSocket::disconnected, this, &AbstractSkillView::closed);
-
-    connect(m_guiWebSocket, &QWebSocket::disconnected, this, [this]() {
-        m_activeSkillsModel->removeRows(0, m_activeSkillsModel->rowCount());
-    });
-
-    connect(m_guiWebSocket, &QWebSocket::stateChanged, this,
-            [this] (QAbstractSocket::SocketState state) {
-                emit statusChanged();
-            });
-
-    connect(m_guiWebSocket, &QWebSocket::textMessageReceived, this, &AbstractSkillView::onGuiSocketMessageReceived);
-
-    connect(m_guiWebSocket, &QWebSocket::stateChanged, this,
-            [this](QAbstractSocket::SocketState socketState) {
-                //TODO: when the connection closes, all session data and guis should be destroyed
-                //qWarning()<<"GUI SOCKET STATE:"<<socketState;
-                //Try to reconnect if our connection died but the main server connection is still alive
-                if (socketState == QAbstractSocket::UnconnectedState && m_url.isValid() && m_controller->status() == MycroftController::Open) {
-                    m_reconnectTimer.start();
-                }
-            });
-
-    connect(m_guiWebSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error), this,
-            [this](QAbstractSocket::SocketError error) {
-                qWarning() << "Gui socket Connection Error:" << error;
-                m_reconnectTimer.start();
-            });
-
-
-    connect(m_controller, &MycroftController::socketStatusChanged, this,
-            [this]() {
-                if (m_controller->status() != MycroftController::Open) {
-                    m_guiWebSocket->close();
-                    //don't assume the url will be still valid
-                    m_url = QUrl();
+    m_prefetcher = new PagePrefetcher(this);
+    connect(m_prefetcher, &PagePrefetcher::statsChanged, this, &AbstractSkillView::prefetchStatsChanged);
+
+    connect(m_activeSkillsModel, &ActiveSkillsModel::rowsInserted, this, &AbstractSkillView::syncLiveSkills);
+    connect(m_activeSkillsModel, &ActiveSkillsModel::rowsMoved, this, &AbstractSkillView::syncLiveSkills);
+    connect(m_activeSkillsModel, &ActiveSkillsModel::rowsRemoved, this, &AbstractSkillView::syncLiveSkills);
+    connect(m_activeSkillsModel, &ActiveSkillsModel::activeIndexChanged, this, &AbstractSkillView::syncLiveSkills);
+    connect(m_settings, &GlobalSettings::liveSkillsBudgetChanged, this, &AbstractSkillView::syncLiveSkills);
+
+    m_tracer = new MessageTracer(this);
+    connect(m_tracer, &MessageTracer::breakdownChanged, this, &AbstractSkillView::latencyBreakdownChanged);
+    connect(this, &QQuickItem::windowChanged, m_tracer, &MessageTracer::setWindow);
+
+    // Pages created before their skill catalog finished loading need to pick up the translations
+    connect(SkillTranslator::instance(), &SkillTranslator::catalogLoaded, this,
+            [this](const QString &skillId) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+                QQmlEngine *engine = qmlEngine(this);
+                if (engine && m_translatedSkills.contains(skillId)) {
+                    engine->retranslate();
                 }
+#else
+                Q_UNUSED(skillId)
+#endif
             });
 
-    // Reconnect timer
-    m_reconnectTimer.setInterval(1000);
-    connect(&m_reconnectTimer, &QTimer::timeout, this, [this]() {
-        m_guiWebSocket->close();
-        m_guiWebSocket->open(m_url);
-    });
-
     // Trim components cache timer
     m_trimComponentsTimer.setInterval(100);
     m_trimComponentsTimer.setSingleShot(true);
@@ -112,37 +89,83 @@ AbstractSkillView::AbstractSkillView(QQuickItem *parent)
 
 AbstractSkillView::~AbstractSkillView()
 {
+    for (const auto &skillId : m_skillBlobs.keys()) {
+        releaseSkillBlobs(skillId);
+    }
+    if (m_connection) {
+        m_connection->release(this);
+    }
+    for (const auto &skillId : m_translatedSkills) {
+        SkillTranslator::instance()->release(skillId);
+    }
+    for (const auto &skillId : m_bundledSkills) {
+        SkillBundles::instance()->release(skillId);
+    }
+}
+
+void AbstractSkillView::componentComplete()
+{
+    QQuickItem::componentComplete();
+
+    // The connection group is known only once all the properties are set
+    m_connection = GuiConnection::acquire(m_connectionGroup, this);
+
+    connect(m_connection, &GuiConnection::statusChanged, this, &AbstractSkillView::statusChanged);
+    connect(m_connection, &GuiConnection::closed, this, &AbstractSkillView::onConnectionClosed);
+    connect(m_connection, &GuiConnection::closed, this, &AbstractSkillView::closed);
+    connect(m_connection, &GuiConnection::messageReceived, this, &AbstractSkillView::onGuiMessageReceived);
+
+    emit statusChanged();
+    emit latencyChanged();
 }
 
+void AbstractSkillView::onConnectionClosed()
+{
+    for (const auto &skillId : m_activeSkillsModel->activeSkills()) {
+        m_prefetcher->discardSkill(skillId);
+    }
+    m_activeSkillsModel->removeRows(0, m_activeSkillsModel->rowCount());
+    for (const auto &skillId : m_skillBlobs.keys()) {
+        releaseSkillBlobs(skillId);
+    }
+    for (const auto &skillId : m_translatedSkills) {
+        SkillTranslator::instance()->release(skillId);
+    }
+    m_translatedSkills.clear();
+    for (const auto &skillId : m_bundledSkills) {
+        SkillBundles::instance()->release(skillId);
+    }
+    m_bundledSkills.clear();
+}
 
-QUrl AbstractSkillView::url() const
+QString AbstractSkillView::connectionGroup() const
 {
-    return m_url;
+    return m_connectionGroup;
 }
 
-void AbstractSkillView::setUrl(const QUrl &url)
+void AbstractSkillView::setConnectionGroup(const QString &group)
 {
-    if (m_url == url) {
+    if (m_connectionGroup == group) {
         return;
     }
 
-    m_url = url;
-
-    //don't connect if the controller is offline
-    if (m_controller->status() == MycroftController::Open) {
-        m_guiWebSocket->close();
-        m_guiWebSocket->open(url);
+    if (m_connection) {
+        qWarning() << "The connection group of a view can't be changed after its creation";
+        return;
     }
+
+    m_connectionGroup = group;
+    emit connectionGroupChanged();
 }
 
 QString AbstractSkillView::id() const
 {
-    return m_id;
+    return m_connection ? m_connection->id() : QString();
 }
 
 void AbstractSkillView::triggerEvent(const QString &skillId, const QString &eventName, const QVariantMap &parameters)
 {
-    if (m_guiWebSocket->state() != QAbstractSocket::ConnectedState) {
+    if (!m_connection) {
         qWarning() << "Error: Mycroft gui connection not open!";
         return;
     }
@@ -153,13 +176,12 @@ void AbstractSkillView::triggerEvent(const QString &skillId, const QString &even
     root[QStringLiteral("event_name")] = eventName;
     root[QStringLiteral("parameters")] = QJsonObject::fromVariantMap(parameters);
 
-    QJsonDocument doc(root);
-    m_guiWebSocket->sendTextMessage(QString::fromUtf8(doc.toJson()));
+    m_connection->sendMessage(QJsonDocument(root));
 }
 
 void AbstractSkillView::writeProperties(const QString &skillId, const QVariantMap &data)
 {
-    if (m_guiWebSocket->state() != QAbstractSocket::ConnectedState) {
+    if (!m_connection) {
         qWarning() << "Error: Mycroft gui connection not open!";
         return;
     }
@@ -169,13 +191,12 @@ void AbstractSkillView::writeProperties(const QString &skillId, const QVariantMa
     root[QStringLiteral("namespace")] = skillId;
     root[QStringLiteral("data")] = QJsonObject::fromVariantMap(data);
 
-    QJsonDocument doc(root);
-    m_guiWebSocket->sendTextMessage(QString::fromUtf8(doc.toJson()));
+    m_connection->sendMessage(QJsonDocument(root));
 }
 
 void AbstractSkillView::deleteProperty(const QString &skillId, const QString &property)
 {
-    if (m_guiWebSocket->state() != QAbstractSocket::ConnectedState) {
+    if (!m_connection) {
         qWarning() << "Error: Mycroft gui connection not open!";
         return;
     }
@@ -185,31 +206,16 @@ void AbstractSkillView::deleteProperty(const QString &skillId, const QString &pr
     root[QStringLiteral("namespace")] = skillId;
     root[QStringLiteral("property")] = property;
 
-    QJsonDocument doc(root);
-    m_guiWebSocket->sendTextMessage(QString::fromUtf8(doc.toJson()));
+    m_connection->sendMessage(QJsonDocument(root));
 }
 
 MycroftController::Status AbstractSkillView::status() const
 {
-    if (m_reconnectTimer.isActive()) {
-        return MycroftController::Connecting;
-    }
-
-    switch(m_guiWebSocket->state())
-    {
-    case QAbstractSocket::ConnectingState:
-    case QAbstractSocket::BoundState:
-    case QAbstractSocket::HostLookupState:
-        return MycroftController::Connecting;
-    case QAbstractSocket::UnconnectedState:
+    if (!m_connection) {
         return MycroftController::Closed;
-    case QAbstractSocket::ConnectedState:
-        return MycroftController::Open;
-    case QAbstractSocket::ClosingState:
-        return MycroftController::Closing;
-    default:
-        return MycroftController::Connecting;
     }
+
+    return m_connection->status();
 }
 
 ActiveSkillsModel *AbstractSkillView::activeSkills() const
@@ -217,6 +223,35 @@ ActiveSkillsModel *AbstractSkillView::activeSkills() const
     return m_activeSkillsModel;
 }
 
+int AbstractSkillView::prefetchHits() const
+{
+    return m_prefetcher->hits();
+}
+
+int AbstractSkillView::prefetchMisses() const
+{
+    return m_prefetcher->misses();
+}
+
+qreal AbstractSkillView::prefetchHitRatio() const
+{
+    const int total = m_prefetcher->hits() + m_prefetcher->misses();
+    if (total == 0) {
+        return 0;
+    }
+    return qreal(m_prefetcher->hits()) / total;
+}
+
+LatencyProbe *AbstractSkillView::latency() const
+{
+    return m_connection ? m_connection->latency() : nullptr;
+}
+
+QVariantMap AbstractSkillView::latencyBreakdown() const
+{
+    return m_tracer->breakdown();
+}
+
 SessionDataMap *AbstractSkillView::sessionDataForSkill(const QString &skillId)
 {
     SessionDataMap *map = nullptr;
@@ -231,6 +266,154 @@ SessionDataMap *AbstractSkillView::sessionDataForSkill(const QString &skillId)
     return map;
 }
 
+QList<DelegateLoader *> AbstractSkillView::createDelegateLoaders(const QString &skillId, const QList<QUrl> &urls, bool usePrefetched)
+{
+    QList <DelegateLoader *> delegateLoaders;
+    for (const auto &delegateUrl : urls) {
+        if (!delegateUrl.isValid()) {
+            continue;
+        }
+
+        DelegateLoader *loader = new DelegateLoader(this);
+        loader->init(skillId, delegateUrl, usePrefetched ? m_prefetcher->take(skillId, delegateUrl) : nullptr);
+        m_tracer->waitForDelegate(loader);
+
+        qWarning() << "Created a new DelegateLoader" << loader << "which will load" << delegateUrl << "for the skill" << skillId;
+
+        if (!m_translatedSkills.contains(skillId)) {
+            SkillTranslator::instance()->acquire(skillId, QQmlFile::urlToLocalFileOrQrc(loader->translationsUrl()));
+            m_translatedSkills.insert(skillId);
+        }
+
+        connect(loader, &QObject::destroyed, &m_trimComponentsTimer, QOverload<>::of(&QTimer::start));
+
+        delegateLoaders << loader;
+    }
+
+    return delegateLoaders;
+}
+
+void AbstractSkillView::syncLiveSkills()
+{
+    const QStringList skills = m_activeSkillsModel->activeSkills();
+    const QHash<QString, DelegatesModel*> delegatesModels = m_activeSkillsModel->delegatesModels();
+    const int budget = m_settings->liveSkillsBudget();
+
+    //the skill currently shown is always kept alive, even if it is not within the budget
+    const int liveCount = budget > 0 ? qMax(budget, m_activeSkillsModel->activeIndex() + 1) : skills.count();
+
+    for (int i = 0; i < skills.count(); ++i) {
+        DelegatesModel *delegatesModel = delegatesModels.value(skills[i]);
+        if (!delegatesModel) {
+            continue;
+        }
+
+        if (i < liveCount && delegatesModel->isSuspended()) {
+            resumeDelegates(skills[i], delegatesModel);
+        } else if (i >= liveCount && !delegatesModel->isSuspended()) {
+            qWarning() << "Suspending the delegates of skill" << skills[i];
+            delegatesModel->suspend();
+        }
+    }
+}
+
+void AbstractSkillView::resumeDelegates(const QString &skillId, DelegatesModel *delegatesModel)
+{
+    const QList<QUrl> urls = delegatesModel->suspendedUrls();
+    const int currentIndex = delegatesModel->suspendedCurrentIndex();
+    delegatesModel->resume();
+
+    //not a server insert, so it doesn't count for the prefetch statistics
+    const QList<DelegateLoader *> delegateLoaders = createDelegateLoaders(skillId, urls, false);
+    if (delegateLoaders.isEmpty()) {
+        return;
+    }
+
+    delegatesModel->insertDelegateLoaders(0, delegateLoaders);
+    delegatesModel->setCurrentIndex(qBound(0, currentIndex, delegateLoaders.count() - 1));
+}
+
+void AbstractSkillView::insertDeduplicatedDelegates(const QString &skillId, DelegatesModel *delegatesModel, int position, const QList<QUrl> &urls)
+{
+    int insertAt = position;
+    DelegateLoader *focusLoader = nullptr;
+
+    for (const auto &url : urls) {
+        if (!url.isValid()) {
+            continue;
+        }
+
+        DelegateLoader *loader = nullptr;
+        const int row = delegatesModel->rowForUrl(url);
+
+        if (row >= 0) {
+            // Already present or still loading: reuse it, moving it where it was asked to be inserted.
+            // Pages already before the insertion point are left where they are
+            loader = delegatesModel->delegateLoader(row);
+            if (row > insertAt) {
+                delegatesModel->moveRows(QModelIndex(), row, 1, QModelIndex(), insertAt);
+            }
+            if (row >= insertAt) {
+                ++insertAt;
+            }
+            qWarning() << "Reusing the DelegateLoader" << loader << "of" << url << "for the skill" << skillId;
+        } else {
+            const QList<DelegateLoader *> loaders = createDelegateLoaders(skillId, {url});
+            if (loaders.isEmpty()) {
+                continue;
+            }
+            loader = loaders.first();
+            delegatesModel->insertDelegateLoaders(insertAt, loaders);
+            ++insertAt;
+        }
+
+        if (!focusLoader) {
+            focusLoader = loader;
+        }
+    }
+
+    if (focusLoader) {
+        //give the focus to the first
+        delegatesModel->setCurrentIndex(delegatesModel->rowForUrl(focusLoader->url()));
+        focusLoader->setFocus(true);
+    }
+}
+
+void AbstractSkillView::releaseBlob(const QString &skillId, const QString &property)
+{
+    auto it = m_skillBlobs.find(skillId);
+    if (it == m_skillBlobs.end()) {
+        return;
+    }
+
+    const QString name = it.value().take(property);
+    if (it.value().isEmpty()) {
+        m_skillBlobs.erase(it);
+    }
+    if (!name.isEmpty()) {
+        BlobStore::instance()->release(name);
+    }
+}
+
+void AbstractSkillView::releaseSkillBlobs(const QString &skillId)
+{
+    const QHash<QString, QString> blobs = m_skillBlobs.take(skillId);
+    for (const auto &name : blobs) {
+        BlobStore::instance()->release(name);
+    }
+}
+
+QUrl AbstractSkillView::resolveBundleUrl(const QString &skillId, const QString &urlString)
+{
+    const QUrl url = QUrl::fromUserInput(urlString);
+    if (url.scheme() == QLatin1String("bundle") && !m_bundledSkills.contains(skillId)) {
+        SkillBundles::instance()->acquire(skillId);
+        m_bundledSkills.insert(skillId);
+    }
+
+    return SkillBundles::instance()->resolve(skillId, url);
+}
+
 QList<QVariantMap> variantListToOrderedMap(const QVariantList &data)
 {
     QList<QVariantMap> ordMap;
@@ -281,22 +464,22 @@ QStringList jsonModelToStringList(const QString &key, const QJsonValue &data)
     return items;
 }
 
-void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
+void AbstractSkillView::onGuiMessageReceived(const QString &type, const QJsonDocument &doc, qint64 received)
 {
-    QJsonParseError parseError;
-    auto doc = QJsonDocument::fromJson(message.toUtf8(), &parseError);
-
-    if (doc.isEmpty()) {
-        qWarning() << "Empty or invalid JSON message arrived on the gui socket:" << message << "Error:" << parseError.errorString();
+    static MetricHistogram *s_applyTime = MetricsRegistry::instance()->histogram(QStringLiteral("mycroft_gui_message_apply_seconds"),
+                                                                                QStringLiteral("Time spent applying GUI messages to the models"));
+
+    // Views sharing a connection get every message: skip the skills this one doesn't show.
+    // The active skills list is kept whole in every view, so that the server positions stay valid
+    const QString messageNamespace = doc[QStringLiteral("namespace")].toString();
+    if (!messageNamespace.isEmpty() && messageNamespace != QLatin1String("mycroft.system.active_skills")
+        && messageNamespace != QLatin1String("system") && !m_activeSkillsModel->skillAllowed(messageNamespace)) {
         return;
     }
 
-    auto type = doc[QStringLiteral("type")].toString();
-
-    if (type.isEmpty()) {
-        qWarning() << "Empty type in the JSON message on the gui socket";
-        return;
-    }
+    // Messages with a trace id in their context get timed until they are on screen
+    MessageTracer::Scope traceScope(m_tracer, type, doc[QStringLiteral("context")], received);
+    MetricTimer applyTimer(s_applyTime);
 
     //qDebug() << "gui message type" << type;
 
@@ -326,6 +509,7 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
         }
         QVariantMap::const_iterator i;
         for (i = data.constBegin(); i != data.constEnd(); ++i) {
+            releaseBlob(skillId, i.key());
             //insert it as a model
             QList<QVariantMap> list = variantListToOrderedMap(i.value().value<QVariantList>());
             SessionDataModel *dm = map->value(i.key()).value<SessionDataModel *>();
@@ -369,10 +553,45 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
         SessionDataMap *map = sessionDataForSkill(skillId);
         SessionDataModel *dm = map->value(property).value<SessionDataModel *>();
         map->clearAndNotify(property);
+        releaseBlob(skillId, property);
         //a model will need to be manually deleted
         if (dm) {
             dm->deleteLater();
         }
+
+    // A large binary value in shared memory: the session data gets the url to show it
+    } else if (type == QLatin1String("mycroft.session.blob")) {
+        const QString skillId = doc[QStringLiteral("namespace")].toString();
+        const QString property = doc[QStringLiteral("property")].toString();
+        const QVariantMap descriptor = doc[QStringLiteral("data")].toVariant().toMap();
+        if (skillId.isEmpty()) {
+            qWarning() << "No skill_id provided in mycroft.session.blob";
+            return;
+        }
+        if (!m_activeSkillsModel->skillIndex(skillId).isValid()) {
+            qWarning() << "Invalid skill_id in mycroft.session.blob:" << skillId;
+            return;
+        }
+        if (property.isEmpty()) {
+            qWarning() << "No property provided in mycroft.session.blob";
+            return;
+        }
+
+        const QString name = descriptor.value(QStringLiteral("name")).toString();
+        const QUrl url = BlobStore::instance()->acquire(name, descriptor);
+        if (url.isEmpty()) {
+            qWarning() << "Invalid blob in mycroft.session.blob:" << name;
+            return;
+        }
+
+        SessionDataMap *map = sessionDataForSkill(skillId);
+        SessionDataModel *dm = map->value(property).value<SessionDataModel *>();
+        if (dm) {
+            dm->deleteLater();
+        }
+        releaseBlob(skillId, property);
+        m_skillBlobs[skillId][property] = name;
+        map->insertAndNotify(property, url.toString());
 //END SKILLDATA
 
 
@@ -414,12 +633,14 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
 
             const QString skillId = m_activeSkillsModel->data(m_activeSkillsModel->index(position+i, 0)).toString();
 
-            if (!m_translatorsForSkill.contains(skillId)) {
-                QTranslator *translator = m_translatorsForSkill[skillId];
-                QCoreApplication::removeTranslator(translator);
-                m_translatorsForSkill.remove(skillId);
-                delete translator;
+            if (m_translatedSkills.remove(skillId)) {
+                SkillTranslator::instance()->release(skillId);
+            }
+            m_prefetcher->discardSkill(skillId);
+            if (m_bundledSkills.remove(skillId)) {
+                SkillBundles::instance()->release(skillId);
             }
+            releaseSkillBlobs(skillId);
             //TODO: do this after an animation
             {
                 auto i = m_skillData.find(skillId);
@@ -471,6 +692,10 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
             qWarning() << "Error: no delegates model for skill" << skillId;
             return;
         }
+        //positions sent by the server refer to the full page list
+        if (delegatesModel->isSuspended()) {
+            resumeDelegates(skillId, delegatesModel);
+        }
         if (position < 0 || position > delegatesModel->rowCount()) {
             qWarning() << "Error: Invalid position in mycroft.gui.list.insert";
             return;
@@ -485,34 +710,18 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
 
         qWarning() << "Arrived mycroft.gui.list.insert, delegateUrls are" << delegateUrls;
 
-        QList <DelegateLoader *> delegateLoaders;
+        QList<QUrl> urls;
         for (const auto &urlString : delegateUrls) {
-            const QUrl delegateUrl = QUrl::fromUserInput(urlString);
-
-            if (!delegateUrl.isValid()) {
-                continue;
-            }
-
-            DelegateLoader *loader = new DelegateLoader(this);
-            loader->init(skillId, delegateUrl);
-
-            qWarning() << "Created a new DelegateLoader" << loader << "which will load" << delegateUrl << "for the skill" << skillId;
-
-            if (!m_translatorsForSkill.contains(skillId)) {
-                QTranslator *translator = new QTranslator(this);
-                if (translator->load(QLocale(), skillId, QLatin1String("_"), loader->translationsUrl().path())) {
-                    QCoreApplication::installTranslator(translator);
-                    m_translatorsForSkill[skillId] = translator;
-                } else {
-                    translator->deleteLater();
-                }
-            }
-
-            connect(loader, &QObject::destroyed, &m_trimComponentsTimer, QOverload<>::of(&QTimer::start));
+            urls << resolveBundleUrl(skillId, urlString);
+        }
 
-            delegateLoaders << loader;
+        if (doc[QStringLiteral("deduplicate")].toBool()) {
+            insertDeduplicatedDelegates(skillId, delegatesModel, position, urls);
+            return;
         }
 
+        const QList<DelegateLoader *> delegateLoaders = createDelegateLoaders(skillId, urls);
+
         if (delegateLoaders.count() > 0) {
             delegatesModel->insertDelegateLoaders(position, delegateLoaders);
             //give the focus to the first
@@ -520,6 +729,24 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
         }
 
 
+    // Pages likely to be inserted soon: compile them ahead of time
+    } else if (type == QLatin1String("mycroft.gui.prefetch")) {
+        const QString skillId = doc[QStringLiteral("namespace")].toString();
+        if (skillId.isEmpty()) {
+            qWarning() << "No skill_id provided in mycroft.gui.prefetch";
+            return;
+        }
+
+        const QStringList delegateUrls = jsonModelToStringList(QStringLiteral("url"), doc[QStringLiteral("data")]);
+        const bool incubate = doc[QStringLiteral("incubate")].toBool();
+
+        for (const auto &urlString : delegateUrls) {
+            const QUrl delegateUrl = resolveBundleUrl(skillId, urlString);
+            if (delegateUrl.isValid()) {
+                m_prefetcher->prefetch(skillId, delegateUrl, incubate);
+            }
+        }
+
     // Gui delegates removed
     } else if (type == QLatin1String("mycroft.gui.list.remove")) {
         const QString skillId = doc[QStringLiteral("namespace")].toString();
@@ -537,6 +764,9 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
             qWarning() << "Error: no delegates model for skill" << skillId;
             return;
         }
+        if (delegatesModel->isSuspended()) {
+            resumeDelegates(skillId, delegatesModel);
+        }
 
         if (position < 0 || position > delegatesModel->rowCount() - 1) {
             qWarning() << "Error: Invalid position in mycroft.gui.list.remove";
@@ -569,6 +799,9 @@ void AbstractSkillView::onGuiSocketMessageReceived(const QString &message)
             qWarning() << "Error: no delegates model for skill" << skillId;
             return;
         }
+        if (delegatesModel->isSuspended()) {
+            resumeDelegates(skillId, delegatesModel);
+        }
 
         if (from < 0 || from > delegatesModel->rowCount() - 1) {
             qWarning() << "Error: Invalid from position in mycroft.gui.list.move";
@@ -22,12 +22,20 @@
 
 #include <QQuickItem>
 #include <QPointer>
+#include <QSet>
 
+class QJsonDocument;
 class ActiveSkillsModel;
 class AbstractSkillView;
 class AbstractDelegate;
+class DelegateLoader;
+class DelegatesModel;
+class GlobalSettings;
+class GuiConnection;
+class PagePrefetcher;
+class LatencyProbe;
+class MessageTracer;
 class SessionDataMap;
-class QTranslator;
 
 class AbstractSkillView: public QQuickItem
 {
@@ -36,6 +44,32 @@ class AbstractSkillView: public QQuickItem
 
     Q_PROPERTY(ActiveSkillsModel *activeSkills READ activeSkills CONSTANT)
 
+    /**
+     * Views with the same connection group share a single GUI connection to the server,
+     * each one showing only the skills allowed by the whiteList and blackList of its activeSkills.
+     * Empty by default: the view has a connection of its own.
+     * Only taken into account when the view is created
+     */
+    Q_PROPERTY(QString connectionGroup READ connectionGroup WRITE setConnectionGroup NOTIFY connectionGroupChanged)
+
+    /**
+     * How many of the inserted pages had been announced by mycroft.gui.prefetch, and how many not
+     */
+    Q_PROPERTY(int prefetchHits READ prefetchHits NOTIFY prefetchStatsChanged)
+    Q_PROPERTY(int prefetchMisses READ prefetchMisses NOTIFY prefetchStatsChanged)
+    Q_PROPERTY(qreal prefetchHitRatio READ prefetchHitRatio NOTIFY prefetchStatsChanged)
+
+    /**
+     * Round trip times of the GUI connection
+     */
+    Q_PROPERTY(LatencyProbe *latency READ latency NOTIFY latencyChanged)
+
+    /**
+     * Time from the reception of traced messages to their first frame on screen, per message type
+     * and per stage: network, parse, apply, delegate, frame and the client total, in milliseconds
+     */
+    Q_PROPERTY(QVariantMap latencyBreakdown READ latencyBreakdown NOTIFY latencyBreakdownChanged)
+
 public:
     enum CustomFocusReasons {
         ServerEventFocusReason = Qt::OtherFocusReason
@@ -48,20 +82,18 @@ public:
 
     ActiveSkillsModel *activeSkills() const;
 
+    QString connectionGroup() const;
+    void setConnectionGroup(const QString &group);
 
-    //API for MycroftController, NOT QML
-    /**
-     * Url of the Web socket
-     */
-    QUrl url() const;
+    int prefetchHits() const;
+    int prefetchMisses() const;
+    qreal prefetchHitRatio() const;
 
-    /**
-     * Sets the url for the web socket
-     */
-    void setUrl(const QUrl &url);
+    LatencyProbe *latency() const;
+    QVariantMap latencyBreakdown() const;
 
     /**
-     * Unique identifier for this GUI
+     * Unique identifier of the GUI connection of this view, shared within its connection group
      */
     QString id() const;
 
@@ -88,19 +120,59 @@ Q_SIGNALS:
     //socket stuff
     void statusChanged();
     void closed();
+    void connectionGroupChanged();
+    void latencyChanged();
+    void prefetchStatsChanged();
+    void latencyBreakdownChanged();
+
+protected:
+    void componentComplete() override;
 
 private:
-    void onGuiSocketMessageReceived(const QString &message);
+    void onGuiMessageReceived(const QString &type, const QJsonDocument &doc, qint64 received);
+    void onConnectionClosed();
+
+    /**
+     * Creates and initializes a loader for each url, loading the skill translations if needed.
+     * If usePrefetched is true, pages prefetched by mycroft.gui.prefetch are used when available
+     */
+    QList<DelegateLoader *> createDelegateLoaders(const QString &skillId, const QList<QUrl> &urls, bool usePrefetched = true);
+
+    /**
+     * Suspends the delegates of the skills beyond the live skills budget and
+     * instantiates again the ones that got promoted inside it
+     */
+    void syncLiveSkills();
+
+    /**
+     * Inserts pages for a mycroft.gui.list.insert with the deduplicate flag set:
+     * urls already present in the model are moved and focused instead of instantiated again
+     */
+    void insertDeduplicatedDelegates(const QString &skillId, DelegatesModel *delegatesModel, int position, const QList<QUrl> &urls);
+    void resumeDelegates(const QString &skillId, DelegatesModel *delegatesModel);
+
+    /**
+     * Drops the reference of the session value on its blob, if it is one
+     */
+    void releaseBlob(const QString &skillId, const QString &property);
+    void releaseSkillBlobs(const QString &skillId);
+    QUrl resolveBundleUrl(const QString &skillId, const QString &urlString);
 
-    QTimer m_reconnectTimer;
     QTimer m_trimComponentsTimer;
-    QString m_id;
-    QUrl m_url;
+    QString m_connectionGroup;
     QHash<QString, SessionDataMap *> m_skillData;
-    QHash<QString, QTranslator *> m_translatorsForSkill;
+    //names of the BlobStore blobs in the session data, by skill and property
+    QHash<QString, QHash<QString, QString>> m_skillBlobs;
+    //skills whose catalog was acquired from SkillTranslator by this view
+    QSet<QString> m_translatedSkills;
+    //skills whose bundles are kept registered in SkillBundles by this view
+    QSet<QString> m_bundledSkills;
 
     MycroftController *m_controller;
-    QWebSocket *m_guiWebSocket;
+    GlobalSettings *m_settings;
+    GuiConnection *m_connection = nullptr;
     ActiveSkillsModel *m_activeSkillsModel;
+    PagePrefetcher *m_prefetcher;
+    MessageTracer *m_tracer;
 };
 
@@ -0,0 +1,247 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "blobstore.h"
+#include "metricsregistry.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QDebug>
+
+static MetricGauge *mappedBytes()
+{
+    static MetricGauge *s_gauge = MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_blob_bytes"),
+                                                                     QStringLiteral("Bytes of shared memory blobs mapped"));
+    return s_gauge;
+}
+
+static QImage::Format pixelFormat(const QByteArray &format)
+{
+    if (format == "rgba8888") {
+        return QImage::Format_RGBA8888;
+    } else if (format == "argb32") {
+        return QImage::Format_ARGB32;
+    } else if (format == "rgb888") {
+        return QImage::Format_RGB888;
+    } else if (format == "grayscale8") {
+        return QImage::Format_Grayscale8;
+    }
+    return QImage::Format_Invalid;
+}
+
+BlobStore *BlobStore::instance()
+{
+    // Images can be released from the render thread until the very end
+    static BlobStore s_self;
+    return &s_self;
+}
+
+BlobStore::BlobStore(QObject *parent)
+    : QObject(parent),
+      m_segmentDirectory(QStringLiteral("/dev/shm"))
+{
+}
+
+BlobStore::~BlobStore()
+{
+    for (Blob *blob : m_blobs) {
+        delete blob->file;
+        delete blob;
+    }
+}
+
+QString BlobStore::segmentDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_segmentDirectory;
+}
+
+void BlobStore::setSegmentDirectory(const QString &directory)
+{
+    QMutexLocker locker(&m_mutex);
+    m_segmentDirectory = directory;
+}
+
+BlobStore::Blob *BlobStore::map(const QString &name, const QVariantMap &descriptor)
+{
+    // Segments are only looked up in their directory
+    if (name.isEmpty() || name.contains(QLatin1Char('/')) || name.startsWith(QLatin1Char('.'))) {
+        qWarning() << "Invalid blob name" << name;
+        return nullptr;
+    }
+
+    const qint64 size = descriptor.value(QStringLiteral("size")).toLongLong();
+    const QByteArray format = descriptor.value(QStringLiteral("format")).toString().toLatin1();
+    const QImage::Format rawFormat = pixelFormat(format);
+    const int width = descriptor.value(QStringLiteral("width")).toInt();
+    const int height = descriptor.value(QStringLiteral("height")).toInt();
+    const int bytesPerLine = descriptor.value(QStringLiteral("bytes_per_line")).toInt();
+
+    if (size <= 0) {
+        qWarning() << "Invalid size for blob" << name;
+        return nullptr;
+    }
+    if (rawFormat != QImage::Format_Invalid) {
+        const int minBytesPerLine = (width * QImage::toPixelFormat(rawFormat).bitsPerPixel() + 7) / 8;
+        if (width <= 0 || height <= 0 || bytesPerLine < minBytesPerLine || qint64(bytesPerLine) * height > size) {
+            qWarning() << "Invalid geometry for raw blob" << name;
+            return nullptr;
+        }
+    }
+
+    QFile *file = new QFile(QDir(m_segmentDirectory).filePath(name));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < size) {
+        qWarning() << "Can't open the shared memory segment of blob" << name << file->errorString();
+        delete file;
+        return nullptr;
+    }
+
+    const uchar *data = file->map(0, size);
+    if (!data) {
+        qWarning() << "Can't map the shared memory segment of blob" << name << file->errorString();
+        delete file;
+        return nullptr;
+    }
+
+    Blob *blob = new Blob;
+    blob->file = file;
+    blob->data = data;
+    blob->size = size;
+    blob->format = format;
+    blob->pixelFormat = rawFormat;
+    blob->width = width;
+    blob->height = height;
+    blob->bytesPerLine = bytesPerLine;
+    mappedBytes()->add(size);
+    return blob;
+}
+
+QUrl BlobStore::acquire(const QString &name, const QVariantMap &descriptor)
+{
+    QMutexLocker locker(&m_mutex);
+
+    Blob *blob = m_blobs.value(name);
+    if (!blob) {
+        blob = map(name, descriptor);
+        if (!blob) {
+            return QUrl();
+        }
+        m_blobs[name] = blob;
+    }
+
+    ++blob->refs;
+    return QUrl(QStringLiteral("image://mycroftblob/") + name);
+}
+
+void BlobStore::release(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_blobs.find(name);
+    if (it == m_blobs.end()) {
+        return;
+    }
+
+    Blob *blob = it.value();
+    if (--blob->refs > 0) {
+        return;
+    }
+
+    m_blobs.erase(it);
+    mappedBytes()->add(-blob->size);
+    delete blob->file;
+    delete blob;
+    locker.unlock();
+
+    emit blobReleased(name);
+}
+
+int BlobStore::refCount(const QString &name) const
+{
+    QMutexLocker locker(&m_mutex);
+    Blob *blob = m_blobs.value(name);
+    return blob ? blob->refs : 0;
+}
+
+void BlobStore::releaseImage(void *info)
+{
+    QString *name = static_cast<QString *>(info);
+    BlobStore::instance()->release(*name);
+    delete name;
+}
+
+QImage BlobStore::image(const QString &name, QSize *size, const QSize &requestedSize)
+{
+    QMutexLocker locker(&m_mutex);
+
+    Blob *blob = m_blobs.value(name);
+    if (!blob) {
+        return QImage();
+    }
+
+    QImage image;
+    if (blob->pixelFormat != QImage::Format_Invalid) {
+        // No copy: the image keeps the mapping alive until it goes away
+        ++blob->refs;
+        image = QImage(blob->data, blob->width, blob->height, blob->bytesPerLine, blob->pixelFormat,
+                       &BlobStore::releaseImage, new QString(name));
+    } else {
+        // Decoded without holding the lock, the reference keeps the mapping meanwhile
+        ++blob->refs;
+        const QByteArray format = blob->format;
+        QByteArray encoded = QByteArray::fromRawData(reinterpret_cast<const char *>(blob->data), int(blob->size));
+        locker.unlock();
+
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer, format);
+        // Only downscaled, a requested dimension of 0 follows the other one
+        const QSize imageSize = reader.size();
+        if (imageSize.isValid() && (requestedSize.width() > 0 || requestedSize.height() > 0)) {
+            const QSize bounds(requestedSize.width() > 0 ? requestedSize.width() : imageSize.width(),
+                               requestedSize.height() > 0 ? requestedSize.height() : imageSize.height());
+            const QSize scaledSize = imageSize.scaled(bounds, Qt::KeepAspectRatio);
+            if (scaledSize.width() < imageSize.width()) {
+                reader.setScaledSize(scaledSize);
+            }
+        }
+        image = reader.read();
+        if (image.isNull()) {
+            qWarning() << "Can't decode blob" << name << reader.errorString();
+        }
+        release(name);
+    }
+
+    if (size) {
+        *size = image.size();
+    }
+    return image;
+}
+
+BlobImageProvider::BlobImageProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image)
+{
+}
+
+QImage BlobImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    return BlobStore::instance()->image(id, size, requestedSize);
+}
+
+#include "moc_blobstore.cpp"
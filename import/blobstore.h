@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <QUrl>
+#include <QVariantMap>
+
+class QFile;
+
+/**
+ * Large binary session values written by the server in shared memory segments,
+ * announced with mycroft.session.blob. Segments are mapped read only and shown
+ * by QML images through image://mycroftblob/<name>: raw pixels are used in place,
+ * encoded images are decoded straight from the mapping.
+ *
+ * Every session value, message being handled and image alive holds a reference:
+ * when the last one goes the segment is unmapped and blobReleased emitted, for the
+ * server to free it. Thread safe, images are released from any thread.
+ */
+class BlobStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static BlobStore *instance();
+
+    /**
+     * Maps the segment described by descriptor, or takes one more reference on it if mapped already.
+     * The descriptor has its size and format: an image format readable by QImageReader
+     * (e.g. "png", "jpeg") or raw pixels ("rgba8888", "argb32", "rgb888", "grayscale8")
+     * with width, height and bytes_per_line
+     * @returns the url of the blob for QML images, empty if it couldn't be mapped
+     */
+    QUrl acquire(const QString &name, const QVariantMap &descriptor);
+    void release(const QString &name);
+
+    /**
+     * References on the blob, 0 if not mapped
+     */
+    int refCount(const QString &name) const;
+
+    /**
+     * The blob as an image: raw pixels reference the mapping and keep it alive as long as the image,
+     * encoded images are decoded to requestedSize if valid
+     */
+    QImage image(const QString &name, QSize *size, const QSize &requestedSize);
+
+    /**
+     * @internal where the segments are, /dev/shm by default. For the autotests
+     */
+    QString segmentDirectory() const;
+    void setSegmentDirectory(const QString &directory);
+
+Q_SIGNALS:
+    /**
+     * The blob isn't used anymore and was unmapped. May be emitted from any thread
+     */
+    void blobReleased(const QString &name);
+
+private:
+    struct Blob {
+        QFile *file = nullptr;
+        const uchar *data = nullptr;
+        qint64 size = 0;
+        QByteArray format;
+        QImage::Format pixelFormat = QImage::Format_Invalid;
+        int width = 0;
+        int height = 0;
+        int bytesPerLine = 0;
+        int refs = 0;
+    };
+
+    explicit BlobStore(QObject *parent = nullptr);
+    ~BlobStore() override;
+
+    Blob *map(const QString &name, const QVariantMap &descriptor);
+    static void releaseImage(void *info);
+
+    mutable QMutex m_mutex;
+    QHash<QString, Blob *> m_blobs;
+    QString m_segmentDirectory;
+};
+
+/**
+ * Serves the blobs of BlobStore to QML, as image://mycroftblob/<name>
+ */
+class BlobImageProvider : public QQuickImageProvider
+{
+public:
+    BlobImageProvider();
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+};
+
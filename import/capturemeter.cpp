@@ -0,0 +1,353 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "capturemeter.h"
+#include "globalsettings.h"
+#include "mycroftcontroller.h"
+#include "sampleconversion.h"
+#include "spectrumbuffer.h"
+
+#include <QAudioDeviceInfo>
+#include <QAudioInput>
+#include <QtEndian>
+#include <QDebug>
+#include <cmath>
+#include <cstring>
+
+// Analysis rate: at most one frame every s_minInterval ms, slowed down up to
+// s_maxInterval ms if the analysis takes more than s_cpuBudget of the time
+static const int s_minInterval = 40;
+static const int s_maxInterval = 320;
+static const qreal s_cpuBudget = 0.02;
+
+// Voice range covered by the bands
+static const float s_minFrequency = 100;
+static const float s_maxFrequency = 4000;
+static const float s_dynamicRange = 60;
+
+CaptureMeter::CaptureMeter(QObject *parent)
+    : QObject(parent),
+      m_controller(MycroftController::instance()),
+      m_settings(GlobalSettings::instance()),
+      m_fft(s_frameSize),
+      m_interval(s_minInterval)
+{
+    m_frame.resize(s_frameSize);
+    m_magnitudes.resize(s_frameSize / 2);
+    m_bandBuffer.resize(s_bandCount);
+    m_bands.fill(0, s_bandCount);
+    m_window.resize(s_frameSize);
+    for (int i = 0; i < s_frameSize; ++i) {
+        m_window[i] = 0.5 * (1 - std::cos(2 * PI * i / s_frameSize));
+    }
+
+    connect(m_controller, &MycroftController::isListeningChanged, this, &CaptureMeter::syncWithListening);
+    connect(m_settings, &GlobalSettings::captureMeteringChanged, this, &CaptureMeter::syncWithListening);
+    connect(&m_fileTimer, &QTimer::timeout, this, &CaptureMeter::readFileFrame);
+}
+
+CaptureMeter::~CaptureMeter()
+{
+    stop();
+}
+
+bool CaptureMeter::isRunning() const
+{
+    return m_device != nullptr;
+}
+
+qreal CaptureMeter::level() const
+{
+    return m_level;
+}
+
+QVector<double> CaptureMeter::bands() const
+{
+    return m_bands;
+}
+
+QString CaptureMeter::inputFile() const
+{
+    return m_inputFile;
+}
+
+void CaptureMeter::setInputFile(const QString &inputFile)
+{
+    if (m_inputFile == inputFile) {
+        return;
+    }
+
+    const bool wasRunning = isRunning();
+    stop();
+    m_inputFile = inputFile;
+    if (wasRunning) {
+        start();
+    }
+    emit inputFileChanged();
+}
+
+int CaptureMeter::analyzedFrames() const
+{
+    return m_analyzedFrames;
+}
+
+void CaptureMeter::syncWithListening()
+{
+    if (m_settings->captureMetering() && m_controller->isListening()) {
+        start();
+    } else {
+        stop();
+    }
+}
+
+void CaptureMeter::start()
+{
+    if (isRunning()) {
+        return;
+    }
+
+    m_interval = s_minInterval;
+    m_sinceAnalysis.invalidate();
+    m_budgetWindow.start();
+    m_busyTime = 0;
+    m_analyzedFrames = 0;
+    m_filled = 0;
+
+    if (!m_inputFile.isEmpty()) {
+        if (!openInputFile()) {
+            return;
+        }
+        m_readBuffer.resize(s_frameSize * m_format.bytesPerFrame());
+        m_device = &m_file;
+        m_fileTimer.start(s_frameSize * 1000 / m_format.sampleRate());
+        emit runningChanged();
+        return;
+    }
+
+    QAudioFormat format;
+    format.setSampleRate(16000);
+    format.setChannelCount(1);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    const QAudioDeviceInfo info = QAudioDeviceInfo::defaultInputDevice();
+    if (!info.isFormatSupported(format)) {
+        format = info.nearestFormat(format);
+    }
+    if (format.sampleSize() != 16 || format.sampleType() != QAudioFormat::SignedInt
+        || format.byteOrder() != QAudioFormat::LittleEndian) {
+        qWarning() << "Capture metering: unsupported input format" << format;
+        return;
+    }
+    m_format = format;
+
+    // Room for a few frames: only the newest one is analyzed, the others are dropped
+    const int frameBytes = s_frameSize * m_format.bytesPerFrame();
+    m_readBuffer.resize(frameBytes * 4);
+
+    m_input = new QAudioInput(info, m_format, this);
+    m_input->setBufferSize(frameBytes * 2);
+    m_device = m_input->start();
+    if (!m_device) {
+        qWarning() << "Capture metering: can't open the microphone" << m_input->error();
+        delete m_input;
+        m_input = nullptr;
+        return;
+    }
+    connect(m_device, &QIODevice::readyRead, this, &CaptureMeter::readAvailable);
+
+    emit runningChanged();
+}
+
+void CaptureMeter::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    m_fileTimer.stop();
+    m_file.close();
+    if (m_input) {
+        m_input->stop();
+        m_input->deleteLater();
+        m_input = nullptr;
+    }
+    m_device = nullptr;
+
+    m_level = 0;
+    m_bands.fill(0);
+    emit levelsChanged();
+    emit runningChanged();
+}
+
+bool CaptureMeter::openInputFile()
+{
+    m_file.setFileName(m_inputFile);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Capture metering: can't open" << m_inputFile;
+        return false;
+    }
+
+    const QByteArray riff = m_file.read(12);
+    if (riff.size() != 12 || !riff.startsWith("RIFF") || riff.mid(8, 4) != "WAVE") {
+        qWarning() << "Capture metering: not a WAV file" << m_inputFile;
+        m_file.close();
+        return false;
+    }
+
+    bool hasFormat = false;
+    while (!m_file.atEnd()) {
+        const QByteArray header = m_file.read(8);
+        if (header.size() != 8) {
+            break;
+        }
+        const QByteArray id = header.left(4);
+        const quint32 size = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(header.constData() + 4));
+
+        if (id == "fmt ") {
+            const QByteArray fmt = m_file.read(size);
+            const uchar *data = reinterpret_cast<const uchar *>(fmt.constData());
+            if (fmt.size() < 16 || qFromLittleEndian<quint16>(data) != 1 || qFromLittleEndian<quint16>(data + 14) != 16) {
+                qWarning() << "Capture metering: only 16 bit PCM WAV files are supported" << m_inputFile;
+                break;
+            }
+            m_format = QAudioFormat();
+            m_format.setChannelCount(qFromLittleEndian<quint16>(data + 2));
+            m_format.setSampleRate(qFromLittleEndian<quint32>(data + 4));
+            m_format.setSampleSize(16);
+            m_format.setSampleType(QAudioFormat::SignedInt);
+            m_format.setByteOrder(QAudioFormat::LittleEndian);
+            m_format.setCodec(QStringLiteral("audio/pcm"));
+            hasFormat = m_format.channelCount() > 0 && m_format.sampleRate() > 0;
+        } else if (id == "data") {
+            if (hasFormat) {
+                m_fileDataStart = m_file.pos();
+                return true;
+            }
+            break;
+        } else {
+            // Chunks are padded to an even size
+            m_file.seek(m_file.pos() + size + (size & 1));
+            continue;
+        }
+
+        if (size & 1) {
+            m_file.seek(m_file.pos() + 1);
+        }
+    }
+
+    qWarning() << "Capture metering: invalid WAV file" << m_inputFile;
+    m_file.close();
+    return false;
+}
+
+void CaptureMeter::readFileFrame()
+{
+    // One frame per tick, so the file is consumed at the pace of a microphone
+    char *data = m_readBuffer.data();
+    const int frameBytes = m_readBuffer.size();
+    int read = qMax<qint64>(0, m_file.read(data, frameBytes));
+    if (read < frameBytes) {
+        m_file.seek(m_fileDataStart);
+        read += qMax<qint64>(0, m_file.read(data + read, frameBytes - read));
+    }
+    if (read < frameBytes) {
+        return;
+    }
+
+    if (!m_sinceAnalysis.isValid() || m_sinceAnalysis.elapsed() >= m_interval) {
+        analyzeFrame(reinterpret_cast<const qint16 *>(data));
+    }
+}
+
+void CaptureMeter::readAvailable()
+{
+    const int frameBytes = s_frameSize * m_format.bytesPerFrame();
+    char *data = m_readBuffer.data();
+
+    qint64 read;
+    while ((read = m_device->read(data + m_filled, m_readBuffer.size() - m_filled)) > 0) {
+        m_filled += read;
+        if (m_filled == m_readBuffer.size()) {
+            // Only the newest frame matters
+            memmove(data, data + m_filled - frameBytes, frameBytes);
+            m_filled = frameBytes;
+        }
+    }
+
+    if (m_filled < frameBytes) {
+        return;
+    }
+
+    if (m_sinceAnalysis.isValid() && m_sinceAnalysis.elapsed() < m_interval) {
+        return;
+    }
+
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    const int start = (m_filled - frameBytes) / bytesPerFrame * bytesPerFrame;
+    analyzeFrame(reinterpret_cast<const qint16 *>(data + start));
+    m_filled = 0;
+}
+
+void CaptureMeter::analyzeFrame(const qint16 *samples)
+{
+    QElapsedTimer busy;
+    busy.start();
+    m_sinceAnalysis.start();
+
+    // The first channel only, like the playback spectrum
+    const int channels = m_format.channelCount();
+    float sum = 0;
+    for (int i = 0; i < s_frameSize; ++i) {
+        const float value = SampleFormat<qint16>::toFloat(qFromLittleEndian(samples[i * channels]));
+        sum += std::fabs(value);
+        m_frame[i] = value * m_window[i];
+    }
+    m_level = sum / s_frameSize;
+
+    m_fft.magnitudes(m_frame.constData(), m_magnitudes.data());
+    // A full scale sine through the Hann window peaks at s_frameSize / 4
+    for (auto &magnitude : m_magnitudes) {
+        magnitude *= 4.0f / s_frameSize;
+    }
+    SpectrumBuffer::aggregateBands(m_magnitudes, m_format.sampleRate(), s_minFrequency, s_maxFrequency, m_bandBuffer);
+    for (int i = 0; i < s_bandCount; ++i) {
+        const float band = m_bandBuffer[i];
+        m_bands[i] = band > 0 ? qBound(0.0f, 1 + 20 * std::log10(band) / s_dynamicRange, 1.0f) : 0;
+    }
+
+    ++m_analyzedFrames;
+    emit levelsChanged();
+
+    m_busyTime += busy.nsecsElapsed();
+    const qint64 window = m_budgetWindow.elapsed();
+    if (window >= 1000) {
+        const qreal load = qreal(m_busyTime) / (window * 1000000);
+        if (load > s_cpuBudget && m_interval < s_maxInterval) {
+            m_interval *= 2;
+            qWarning() << "Capture metering over its CPU budget, analyzing every" << m_interval << "ms";
+        } else if (load < s_cpuBudget / 4 && m_interval > s_minInterval) {
+            m_interval /= 2;
+        }
+        m_busyTime = 0;
+        m_budgetWindow.restart();
+    }
+}
+
+#include "moc_capturemeter.cpp"
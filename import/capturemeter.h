@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QAudioFormat>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+
+#include "thirdparty/fft.h"
+
+class QAudioInput;
+class QIODevice;
+class GlobalSettings;
+class MycroftController;
+
+/**
+ * Meters the microphone while Mycroft is listening, to give feedback on the user voice.
+ * Small fixed size frames go through the same conversion and FFT code as the playback
+ * spectrum; at most one frame is analyzed per interval, and the interval grows when the
+ * analysis takes more than its CPU budget.
+ * It runs only if GlobalSettings::captureMetering is enabled, and only while listening.
+ */
+class CaptureMeter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    /**
+     * Average level of the last analyzed frame, 0 to 1
+     */
+    Q_PROPERTY(qreal level READ level NOTIFY levelsChanged)
+    /**
+     * Energy of log spaced bands over the voice range, in dB mapped to 0 to 1
+     */
+    Q_PROPERTY(QVector<double> bands READ bands NOTIFY levelsChanged)
+    /**
+     * A 16 bit PCM WAV file read in real time in place of the microphone, looping at the end.
+     * Meant for testing
+     */
+    Q_PROPERTY(QString inputFile READ inputFile WRITE setInputFile NOTIFY inputFileChanged)
+
+public:
+    explicit CaptureMeter(QObject *parent = nullptr);
+    ~CaptureMeter() override;
+
+    static const int s_frameSize = 512;
+    static const int s_bandCount = 8;
+
+    bool isRunning() const;
+    qreal level() const;
+    QVector<double> bands() const;
+
+    QString inputFile() const;
+    void setInputFile(const QString &inputFile);
+
+    /**
+     * Number of frames analyzed since the last start()
+     */
+    int analyzedFrames() const;
+
+public Q_SLOTS:
+    /**
+     * Normally called when listening starts and stops, public for testing
+     */
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void runningChanged();
+    void levelsChanged();
+    void inputFileChanged();
+
+private:
+    void syncWithListening();
+    bool openInputFile();
+    void readAvailable();
+    void readFileFrame();
+    void analyzeFrame(const qint16 *samples);
+
+    MycroftController *m_controller;
+    GlobalSettings *m_settings;
+
+    QAudioInput *m_input = nullptr;
+    QIODevice *m_device = nullptr;
+    QString m_inputFile;
+    QFile m_file;
+    qint64 m_fileDataStart = 0;
+    QTimer m_fileTimer;
+    QAudioFormat m_format;
+
+    // Fixed size buffers, allocated once
+    QByteArray m_readBuffer;
+    int m_filled = 0;
+    QVector<float> m_frame;
+    QVector<float> m_window;
+    QVector<float> m_magnitudes;
+    QVector<float> m_bandBuffer;
+    RealFFT m_fft;
+
+    // CPU budget
+    int m_interval;
+    QElapsedTimer m_sinceAnalysis;
+    QElapsedTimer m_budgetWindow;
+    qint64 m_busyTime = 0;
+    int m_analyzedFrames = 0;
+
+    qreal m_level = 0;
+    QVector<double> m_bands;
+};
+
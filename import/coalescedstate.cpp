@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "coalescedstate.h"
+
+CoalescedState::CoalescedState(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &CoalescedState::commit);
+}
+
+bool CoalescedState::value() const
+{
+    return m_value;
+}
+
+void CoalescedState::setValue(bool value)
+{
+    m_pending = value;
+
+    // Back to the notified state before anybody saw the change
+    if (m_pending == m_value) {
+        m_timer.stop();
+        return;
+    }
+
+    const int interval = m_pending ? 0 : m_debounceInterval;
+    // Repeated requests don't push the deadline further
+    if (!m_timer.isActive() || m_timer.interval() != interval) {
+        m_timer.start(interval);
+    }
+}
+
+int CoalescedState::debounceInterval() const
+{
+    return m_debounceInterval;
+}
+
+void CoalescedState::setDebounceInterval(int interval)
+{
+    m_debounceInterval = qMax(0, interval);
+}
+
+void CoalescedState::commit()
+{
+    if (m_pending == m_value) {
+        return;
+    }
+
+    m_value = m_pending;
+    emit valueChanged();
+}
+
+#include "moc_coalescedstate.cpp"
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+/**
+ * A boolean state driven by bus events, e.g. speaking or listening, which notifies
+ * only of real transitions. Changes requested during one event loop iteration are
+ * collapsed: only the last one counts, and none is notified if it's back to where it was.
+ * Going back to false can also be debounced, so that a stop quickly followed by a start,
+ * as between the chunks of a spoken answer, doesn't notify at all.
+ */
+class CoalescedState : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CoalescedState(QObject *parent = nullptr);
+
+    /**
+     * The state last notified
+     */
+    bool value() const;
+
+    /**
+     * Requests the state, notified at the end of the event loop iteration if it differs,
+     * or after the debounce interval when going to false
+     */
+    void setValue(bool value);
+
+    /**
+     * How long a false state has to last before being notified, in milliseconds. 0 (default)
+     * notifies it at the end of the event loop iteration like true
+     */
+    int debounceInterval() const;
+    void setDebounceInterval(int interval);
+
+Q_SIGNALS:
+    void valueChanged();
+
+private:
+    void commit();
+
+    QTimer m_timer;
+    bool m_value = false;
+    bool m_pending = false;
+    int m_debounceInterval = 0;
+};
+
@@ -0,0 +1,335 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "connectionscheduler.h"
+#include "metricsregistry.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QSocketNotifier>
+#include <QVariantList>
+#include <QDebug>
+#include <random>
+
+#ifdef Q_OS_LINUX
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// How many events of each connection are kept for the metrics
+static const int s_timelineLength = 32;
+
+static int jittered(int delay)
+{
+    static std::mt19937 generator{std::random_device{}()};
+    // Equal jitter: never less than half of the delay, so backing off still backs off
+    std::uniform_int_distribution<int> distribution(delay / 2, delay);
+    return distribution(generator);
+}
+
+ReconnectBackoff::ReconnectBackoff(const QString &name, int baseDelay, int maxDelay, QObject *parent)
+    : QObject(parent),
+      m_name(name),
+      m_baseDelay(baseDelay),
+      m_maxDelay(maxDelay)
+{
+    // Labeled by kind of connection, not to have a series per GUI id
+    m_reconnects = MetricsRegistry::instance()->counter(QStringLiteral("mycroft_gui_reconnects_total"),
+                                                        QStringLiteral("Reconnection attempts"),
+                                                        {{QStringLiteral("connection"), name.section(QLatin1Char(' '), 0, 0)}});
+
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, [this]() {
+        ++m_attempts;
+        m_reconnects->increment();
+        record(QStringLiteral("retry"));
+        emit retry();
+    });
+
+    m_stableTimer.setSingleShot(true);
+    m_stableTimer.setInterval(5000);
+    connect(&m_stableTimer, &QTimer::timeout, this, [this]() {
+        m_attempts = 0;
+    });
+}
+
+ReconnectBackoff::~ReconnectBackoff()
+{
+}
+
+QString ReconnectBackoff::name() const
+{
+    return m_name;
+}
+
+int ReconnectBackoff::nextDelay() const
+{
+    if (m_attempts == 0) {
+        return 0;
+    }
+    // Shifting past the cap would overflow
+    const int exponent = qMin(m_attempts - 1, 20);
+    return int(qMin<qint64>(m_maxDelay, qint64(m_baseDelay) << exponent));
+}
+
+void ReconnectBackoff::schedule()
+{
+    if (m_timer.isActive()) {
+        return;
+    }
+
+    // Dropped before being stable: keep backing off
+    m_stableTimer.stop();
+
+    if (!m_down) {
+        m_down = true;
+        ++m_outages;
+        m_outageClock.start();
+        record(QStringLiteral("down"));
+    }
+
+    const int delay = nextDelay();
+    m_timer.start(delay > 0 ? jittered(delay) : 0);
+}
+
+void ReconnectBackoff::retryNow()
+{
+    if (!m_timer.isActive()) {
+        return;
+    }
+
+    m_timer.stop();
+    ++m_attempts;
+    m_reconnects->increment();
+    record(QStringLiteral("fast retry"));
+    emit retry();
+}
+
+void ReconnectBackoff::succeeded()
+{
+    m_timer.stop();
+    if (m_attempts > 0) {
+        m_stableTimer.start();
+    }
+
+    if (!m_down) {
+        return;
+    }
+
+    m_down = false;
+    m_lastOutage = m_outageClock.elapsed();
+    m_longestOutage = qMax(m_longestOutage, m_lastOutage);
+    record(QStringLiteral("up"));
+}
+
+int ReconnectBackoff::stableInterval() const
+{
+    return m_stableTimer.interval();
+}
+
+void ReconnectBackoff::setStableInterval(int msecs)
+{
+    m_stableTimer.setInterval(msecs);
+}
+
+void ReconnectBackoff::cancel()
+{
+    m_timer.stop();
+    m_stableTimer.stop();
+    m_attempts = 0;
+
+    if (!m_down) {
+        return;
+    }
+
+    m_down = false;
+    record(QStringLiteral("cancel"));
+}
+
+bool ReconnectBackoff::isPending() const
+{
+    return m_timer.isActive();
+}
+
+int ReconnectBackoff::attempts() const
+{
+    return m_attempts;
+}
+
+void ReconnectBackoff::record(const QString &event)
+{
+    if (m_timeline.size() == s_timelineLength) {
+        m_timeline.removeFirst();
+    }
+    m_timeline.append({QDateTime::currentMSecsSinceEpoch(), event});
+    emit metricsChanged();
+}
+
+QVariantMap ReconnectBackoff::metrics() const
+{
+    QVariantList timeline;
+    for (const auto &event : m_timeline) {
+        timeline << QVariantMap({{QStringLiteral("time"), event.time}, {QStringLiteral("event"), event.event}});
+    }
+
+    return QVariantMap({
+        {QStringLiteral("connected"), !m_down},
+        {QStringLiteral("attempts"), m_attempts},
+        {QStringLiteral("outages"), m_outages},
+        {QStringLiteral("currentOutage"), m_down ? m_outageClock.elapsed() : qint64(-1)},
+        {QStringLiteral("lastOutage"), m_lastOutage},
+        {QStringLiteral("longestOutage"), m_longestOutage},
+        {QStringLiteral("timeline"), timeline}
+    });
+}
+
+ConnectionScheduler *ConnectionScheduler::instance()
+{
+    static ConnectionScheduler* s_self = nullptr;
+    if (!s_self) {
+        s_self = new ConnectionScheduler(QCoreApplication::instance());
+    }
+    return s_self;
+}
+
+ConnectionScheduler::ConnectionScheduler(QObject *parent)
+    : QObject(parent)
+{
+    // A local core restart is usually back within a few hundred milliseconds
+    m_bus = new ReconnectBackoff(QStringLiteral("bus"), 250, 30000, this);
+    // The server needs the skills loaded before answering with a port
+    m_announce = new ReconnectBackoff(QStringLiteral("announce"), 2000, 30000, this);
+    track(m_bus);
+    track(m_announce);
+
+    watchNetwork();
+}
+
+ConnectionScheduler::~ConnectionScheduler()
+{
+#ifdef Q_OS_LINUX
+    if (m_netlinkSocket >= 0) {
+        ::close(m_netlinkSocket);
+    }
+#endif
+}
+
+void ConnectionScheduler::watchNetwork()
+{
+#ifdef Q_OS_LINUX
+    // Notified by the kernel, nothing is polled
+    m_netlinkSocket = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (m_netlinkSocket < 0) {
+        qWarning() << "Can't watch the network, retries won't be fired when it comes up";
+        return;
+    }
+
+    sockaddr_nl address = {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+    if (::bind(m_netlinkSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        qWarning() << "Can't watch the network, retries won't be fired when it comes up";
+        ::close(m_netlinkSocket);
+        m_netlinkSocket = -1;
+        return;
+    }
+
+    auto *notifier = new QSocketNotifier(m_netlinkSocket, QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, &ConnectionScheduler::readNetworkEvents);
+#endif
+}
+
+void ConnectionScheduler::readNetworkEvents()
+{
+#ifdef Q_OS_LINUX
+    bool up = false;
+    alignas(nlmsghdr) char buffer[8192];
+    ssize_t size;
+    while ((size = ::recv(m_netlinkSocket, buffer, sizeof(buffer), 0)) > 0) {
+        for (auto *header = reinterpret_cast<nlmsghdr *>(buffer); NLMSG_OK(header, size); header = NLMSG_NEXT(header, size)) {
+            // An address assigned, or a link with its address back up
+            if (header->nlmsg_type == RTM_NEWADDR) {
+                up = true;
+            } else if (header->nlmsg_type == RTM_NEWLINK) {
+                const auto *link = static_cast<const ifinfomsg *>(NLMSG_DATA(header));
+                up |= (link->ifi_flags & IFF_RUNNING) && !(link->ifi_flags & IFF_LOOPBACK);
+            }
+        }
+    }
+
+    if (up) {
+        networkAvailable();
+    }
+#endif
+}
+
+void ConnectionScheduler::track(ReconnectBackoff *backoff)
+{
+    connect(backoff, &ReconnectBackoff::metricsChanged, this, &ConnectionScheduler::metricsChanged);
+}
+
+ReconnectBackoff *ConnectionScheduler::bus() const
+{
+    return m_bus;
+}
+
+ReconnectBackoff *ConnectionScheduler::announce() const
+{
+    return m_announce;
+}
+
+ReconnectBackoff *ConnectionScheduler::createGuiBackoff(const QString &guiId, QObject *parent)
+{
+    auto *backoff = new ReconnectBackoff(QStringLiteral("gui ") + guiId, 250, 10000, parent);
+    track(backoff);
+    m_guis.removeAll(QPointer<ReconnectBackoff>());
+    m_guis << backoff;
+    return backoff;
+}
+
+void ConnectionScheduler::networkAvailable()
+{
+    // The GUI sockets need the bus, whose connection triggers the announcement by itself
+    if (m_bus->isPending()) {
+        m_bus->retryNow();
+        return;
+    }
+    m_announce->retryNow();
+    for (const auto &gui : m_guis) {
+        if (gui) {
+            gui->retryNow();
+        }
+    }
+}
+
+QVariantMap ConnectionScheduler::metrics() const
+{
+    QVariantMap metrics;
+    metrics[m_bus->name()] = m_bus->metrics();
+    metrics[m_announce->name()] = m_announce->metrics();
+    for (const auto &gui : m_guis) {
+        if (gui) {
+            metrics[gui->name()] = gui->metrics();
+        }
+    }
+    return metrics;
+}
+
+#include "moc_connectionscheduler.cpp"
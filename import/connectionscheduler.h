@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <QVector>
+#include <QPointer>
+
+class MetricCounter;
+
+/**
+ * Retry timing of one connection: the first retry after a failure is immediate,
+ * the following ones back off exponentially up to a cap, with a random jitter
+ * so that many clients of a restarting server don't retry in lockstep.
+ * A connection counts as healthy again only once it stayed up for a while, so that
+ * a server accepting connections and dropping them right away is still backed off
+ */
+class ReconnectBackoff : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReconnectBackoff(const QString &name, int baseDelay, int maxDelay, QObject *parent = nullptr);
+    ~ReconnectBackoff();
+
+    QString name() const;
+
+    /**
+     * Schedules the next attempt, unless one is pending already
+     */
+    void schedule();
+
+    /**
+     * Fires a pending attempt right away, used when there is reason to believe it will succeed
+     */
+    void retryNow();
+
+    /**
+     * The connection is up: once it stayed up for stableInterval the next failure
+     * is retried immediately again
+     */
+    void succeeded();
+
+    /**
+     * How long a connection must stay up before the attempts are reset, 5 seconds by default
+     */
+    int stableInterval() const;
+    void setStableInterval(int msecs);
+
+    /**
+     * Stops retrying, without accounting a success
+     */
+    void cancel();
+
+    bool isPending() const;
+
+    /**
+     * Attempts made since the last success
+     */
+    int attempts() const;
+
+    /**
+     * The delay range of the next schedule() call, before jitter
+     */
+    int nextDelay() const;
+
+    /**
+     * Counters and the most recent events of this connection, times in milliseconds
+     */
+    QVariantMap metrics() const;
+
+Q_SIGNALS:
+    /**
+     * Time to try connecting again
+     */
+    void retry();
+    void metricsChanged();
+
+private:
+    void record(const QString &event);
+
+    struct Event {
+        qint64 time;
+        QString event;
+    };
+
+    QString m_name;
+    int m_baseDelay;
+    int m_maxDelay;
+    QTimer m_timer;
+    QTimer m_stableTimer;
+    int m_attempts = 0;
+    bool m_down = false;
+    int m_outages = 0;
+    qint64 m_lastOutage = -1;
+    qint64 m_longestOutage = -1;
+    QElapsedTimer m_outageClock;
+    QVector<Event> m_timeline;
+    MetricCounter *m_reconnects;
+};
+
+/**
+ * Owns the retry timing of the bus connection and of the GUI announcement, and
+ * knows the backoff of every GUI socket: the bus gets connected first, then the
+ * GUIs are announced, then each GUI socket connects to the port it got.
+ * When the network comes up, every pending retry is fired right away: on Linux
+ * address and link changes are notified by the kernel through a netlink socket.
+ */
+class ConnectionScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ConnectionScheduler *instance();
+
+    ReconnectBackoff *bus() const;
+    ReconnectBackoff *announce() const;
+
+    /**
+     * Creates the backoff of a GUI socket, owned by the caller
+     */
+    ReconnectBackoff *createGuiBackoff(const QString &guiId, QObject *parent);
+
+    /**
+     * The reconnect timeline of every connection, keyed by name
+     */
+    QVariantMap metrics() const;
+
+public Q_SLOTS:
+    /**
+     * Fast path: fires all the pending retries, in connection order
+     */
+    void networkAvailable();
+
+Q_SIGNALS:
+    void metricsChanged();
+
+private:
+    explicit ConnectionScheduler(QObject *parent = nullptr);
+    ~ConnectionScheduler() override;
+    void track(ReconnectBackoff *backoff);
+    void watchNetwork();
+    void readNetworkEvents();
+
+    ReconnectBackoff *m_bus;
+    ReconnectBackoff *m_announce;
+    QVector<QPointer<ReconnectBackoff>> m_guis;
+    int m_netlinkSocket = -1;
+};
+
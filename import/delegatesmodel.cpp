@@ -103,6 +103,78 @@ QList<AbstractDelegate *> DelegatesModel::delegates() const
     return delegates;
 }
 
+int DelegatesModel::rowForUrl(const QUrl &url) const
+{
+    for (int i = 0; i < m_delegateLoaders.count(); ++i) {
+        if (m_delegateLoaders[i]->url() == url) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+DelegateLoader *DelegatesModel::delegateLoader(int row) const
+{
+    return m_delegateLoaders.value(row);
+}
+
+void DelegatesModel::suspend()
+{
+    if (m_suspended) {
+        return;
+    }
+
+    m_suspendedUrls.clear();
+    for (auto c : m_delegateLoaders) {
+        m_suspendedUrls << c->url();
+    }
+    m_suspendedCurrentIndex = m_currentIndex;
+    m_suspended = true;
+
+    if (!m_delegateLoaders.isEmpty()) {
+        removeRows(0, m_delegateLoaders.count());
+    }
+
+    emit suspendedChanged();
+}
+
+void DelegatesModel::resume()
+{
+    if (!m_suspended) {
+        return;
+    }
+
+    m_suspendedUrls.clear();
+    m_suspended = false;
+    emit suspendedChanged();
+}
+
+bool DelegatesModel::isSuspended() const
+{
+    return m_suspended;
+}
+
+QList<QUrl> DelegatesModel::suspendedUrls() const
+{
+    return m_suspendedUrls;
+}
+
+int DelegatesModel::suspendedCurrentIndex() const
+{
+    return m_suspendedCurrentIndex;
+}
+
+void DelegatesModel::setCurrentIndex(int index)
+{
+    if (m_currentIndex == index) {
+        return;
+    }
+
+    m_currentIndex = index;
+    emit currentIndexChanged();
+}
+
 bool DelegatesModel::moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild)
 {
     if (sourceParent.isValid() || destinationParent.isValid()) {
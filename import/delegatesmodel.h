@@ -30,6 +30,7 @@ class DelegatesModel : public QAbstractListModel
 {
     Q_OBJECT
     Q_PROPERTY(int currentIndex MEMBER m_currentIndex NOTIFY currentIndexChanged)
+    Q_PROPERTY(bool suspended READ isSuspended NOTIFY suspendedChanged)
 
 public:
     enum Roles {
@@ -54,6 +55,30 @@ public:
      */
     QList<AbstractDelegate *> delegates() const;
 
+    /**
+     * @returns the row of the loader for url, either loaded or still loading, -1 if not present
+     */
+    int rowForUrl(const QUrl &url) const;
+    DelegateLoader *delegateLoader(int row) const;
+
+    /**
+     * Destroys all the delegates, only remembering their urls and the current index,
+     * so they can be instantiated again once the skill gets promoted
+     */
+    void suspend();
+
+    /**
+     * Leaves the suspended state: the model is still empty, the caller is
+     * responsible to recreate the loaders from suspendedUrls()
+     */
+    void resume();
+
+    bool isSuspended() const;
+    QList<QUrl> suspendedUrls() const;
+    int suspendedCurrentIndex() const;
+
+    void setCurrentIndex(int index);
+
     bool moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild) override;
     bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -62,10 +87,16 @@ public:
 
 Q_SIGNALS:
     void currentIndexChanged();
+    void suspendedChanged();
 
 private:
     QList<DelegateLoader *> m_delegateLoaders;
     QList<DelegateLoader *> m_delegateLoadersToDelete;
     QTimer *m_deleteTimer;
     int m_currentIndex = 0;
+
+    //Lightweight descriptor of the delegates while suspended
+    QList<QUrl> m_suspendedUrls;
+    int m_suspendedCurrentIndex = 0;
+    bool m_suspended = false;
 };
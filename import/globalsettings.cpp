@@ -16,10 +16,20 @@
  */
 
 #include <QDebug>
+#include <QDir>
 #include <QFile>
 #include "globalsettings.h"
 #include "controllerconfig.h"
 
+GlobalSettings *GlobalSettings::instance()
+{
+    static GlobalSettings *s_self = nullptr;
+    if (!s_self) {
+        s_self = new GlobalSettings;
+    }
+    return s_self;
+}
+
 GlobalSettings::GlobalSettings(QObject *parent) :
     QObject(parent)
 {
@@ -98,4 +108,98 @@ void GlobalSettings::setUseDelegateAnimation(bool useDelegateAnimation)
 
     m_settings.setValue(QStringLiteral("useDelegateAnimation"), useDelegateAnimation);
     emit useDelegateAnimationChanged();
-}
\ No newline at end of file
+}
+
+int GlobalSettings::liveSkillsBudget() const
+{
+    return m_settings.value(QStringLiteral("liveSkillsBudget"), 0).toInt();
+}
+
+void GlobalSettings::setLiveSkillsBudget(int liveSkillsBudget)
+{
+    if (GlobalSettings::liveSkillsBudget() == liveSkillsBudget) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("liveSkillsBudget"), liveSkillsBudget);
+    emit liveSkillsBudgetChanged();
+}
+
+bool GlobalSettings::captureMetering() const
+{
+    return m_settings.value(QStringLiteral("captureMetering"), false).toBool();
+}
+
+void GlobalSettings::setCaptureMetering(bool captureMetering)
+{
+    if (GlobalSettings::captureMetering() == captureMetering) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("captureMetering"), captureMetering);
+    emit captureMeteringChanged();
+}
+
+QString GlobalSettings::metricsEndpoint() const
+{
+    return m_settings.value(QStringLiteral("metricsEndpoint"), QString()).toString();
+}
+
+void GlobalSettings::setMetricsEndpoint(const QString &metricsEndpoint)
+{
+    if (GlobalSettings::metricsEndpoint() == metricsEndpoint) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("metricsEndpoint"), metricsEndpoint);
+    emit metricsEndpointChanged();
+}
+
+bool GlobalSettings::showPerformanceHud() const
+{
+    return m_settings.value(QStringLiteral("showPerformanceHud"), false).toBool();
+}
+
+void GlobalSettings::setShowPerformanceHud(bool showPerformanceHud)
+{
+    if (GlobalSettings::showPerformanceHud() == showPerformanceHud) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("showPerformanceHud"), showPerformanceHud);
+    emit showPerformanceHudChanged();
+}
+
+QString GlobalSettings::localSocketDirectory() const
+{
+    QString runtimeDirectory = QString::fromLocal8Bit(qgetenv("XDG_RUNTIME_DIR"));
+    if (runtimeDirectory.isEmpty()) {
+        runtimeDirectory = QDir::tempPath();
+    }
+    return m_settings.value(QStringLiteral("localSocketDirectory"), runtimeDirectory + QStringLiteral("/ovos")).toString();
+}
+
+void GlobalSettings::setLocalSocketDirectory(const QString &localSocketDirectory)
+{
+    if (GlobalSettings::localSocketDirectory() == localSocketDirectory) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("localSocketDirectory"), localSocketDirectory);
+    emit localSocketDirectoryChanged();
+}
+
+int GlobalSettings::speakingDebounceInterval() const
+{
+    return m_settings.value(QStringLiteral("speakingDebounceInterval"), 250).toInt();
+}
+
+void GlobalSettings::setSpeakingDebounceInterval(int speakingDebounceInterval)
+{
+    if (GlobalSettings::speakingDebounceInterval() == speakingDebounceInterval) {
+        return;
+    }
+
+    m_settings.setValue(QStringLiteral("speakingDebounceInterval"), speakingDebounceInterval);
+    emit speakingDebounceIntervalChanged();
+}
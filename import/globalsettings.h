@@ -36,10 +36,22 @@ class GlobalSettings : public QObject
     Q_PROPERTY(bool useExitNameSpaceAnimation READ useExitNameSpaceAnimation WRITE setUseExitNameSpaceAnimation NOTIFY useExitNameSpaceAnimationChanged)
     Q_PROPERTY(bool useFocusAnimation READ useFocusAnimation WRITE setUseFocusAnimation NOTIFY useFocusAnimationChanged)
     Q_PROPERTY(bool useDelegateAnimation READ useDelegateAnimation WRITE setUseDelegateAnimation NOTIFY useDelegateAnimationChanged)
+    Q_PROPERTY(int liveSkillsBudget READ liveSkillsBudget WRITE setLiveSkillsBudget NOTIFY liveSkillsBudgetChanged)
+    Q_PROPERTY(bool captureMetering READ captureMetering WRITE setCaptureMetering NOTIFY captureMeteringChanged)
+    Q_PROPERTY(QString metricsEndpoint READ metricsEndpoint WRITE setMetricsEndpoint NOTIFY metricsEndpointChanged)
+    Q_PROPERTY(bool showPerformanceHud READ showPerformanceHud WRITE setShowPerformanceHud NOTIFY showPerformanceHudChanged)
+    Q_PROPERTY(QString localSocketDirectory READ localSocketDirectory WRITE setLocalSocketDirectory NOTIFY localSocketDirectoryChanged)
+    Q_PROPERTY(int speakingDebounceInterval READ speakingDebounceInterval WRITE setSpeakingDebounceInterval NOTIFY speakingDebounceIntervalChanged)
 
 public:
     explicit GlobalSettings(QObject *parent=0);
 
+    /**
+     * The instance shared by C++ and the QML singleton: change signals are emitted
+     * only by the instance whose setter was called, so watchers must use this one
+     */
+    static GlobalSettings *instance();
+
     SettingPropertyKey(QString, webSocketAddress, setWebSocketAddress, webSocketChanged, QStringLiteral("webSocketAddress"), QStringLiteral("ws://0.0.0.0"))
 
     bool autoConnect() const;
@@ -53,6 +65,47 @@ public:
     bool useDelegateAnimation() const;
     void setUseDelegateAnimation(bool useDelegateAnimation);
 
+    /**
+     * How many of the most recent skills keep their delegates instantiated,
+     * deeper skills get suspended until promoted again. 0 means no limit.
+     */
+    int liveSkillsBudget() const;
+    void setLiveSkillsBudget(int liveSkillsBudget);
+
+    /**
+     * Whether the microphone is metered while listening, for CaptureMeter
+     */
+    bool captureMetering() const;
+    void setCaptureMetering(bool captureMetering);
+
+    /**
+     * Where the metrics are served for scraping: "unix:/path" for a Unix socket,
+     * a port for the loopback interface. Empty (default) disables it
+     */
+    QString metricsEndpoint() const;
+    void setMetricsEndpoint(const QString &metricsEndpoint);
+
+    /**
+     * Whether SkillView shows the PerformanceHud overlay
+     */
+    bool showPerformanceHud() const;
+    void setShowPerformanceHud(bool showPerformanceHud);
+
+    /**
+     * Where a server on the same host exposes its Unix sockets, used instead of the
+     * loopback websockets when present. Defaults to ovos in the runtime directory,
+     * empty disables the local transport
+     */
+    QString localSocketDirectory() const;
+    void setLocalSocketDirectory(const QString &localSocketDirectory);
+
+    /**
+     * How long the end of speech has to last before speaking turns false, in milliseconds,
+     * so that the short gaps between the chunks of an answer don't restart animations
+     */
+    int speakingDebounceInterval() const;
+    void setSpeakingDebounceInterval(int speakingDebounceInterval);
+
 Q_SIGNALS:
     void webSocketChanged();
     void autoConnectChanged();
@@ -60,6 +113,12 @@ Q_SIGNALS:
     void useExitNameSpaceAnimationChanged();
     void useFocusAnimationChanged();
     void useDelegateAnimationChanged();
+    void liveSkillsBudgetChanged();
+    void captureMeteringChanged();
+    void metricsEndpointChanged();
+    void showPerformanceHudChanged();
+    void localSocketDirectoryChanged();
+    void speakingDebounceIntervalChanged();
 
 private:
     QSettings m_settings;
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "guiconnection.h"
+#include "blobstore.h"
+#include "connectionscheduler.h"
+#include "globalsettings.h"
+#include "latencyprobe.h"
+#include "messagesocket.h"
+#include "messagetracer.h"
+#include "metricsregistry.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QUuid>
+#include <QDebug>
+
+// Failed attempts on the same port before asking the server for a new one
+static const int s_maxAttemptsPerPort = 4;
+
+// Connections shared by views, by group
+static QHash<QString, GuiConnection *> s_groups;
+
+GuiConnection *GuiConnection::acquire(const QString &group, AbstractSkillView *view)
+{
+    GuiConnection *connection = group.isEmpty() ? nullptr : s_groups.value(group);
+    if (!connection) {
+        connection = new GuiConnection(group);
+    }
+
+    connection->m_views << view;
+    if (connection->m_views.count() > 1 && connection->m_socket->state() == QAbstractSocket::ConnectedState) {
+        connection->resync();
+    }
+    return connection;
+}
+
+void GuiConnection::release(AbstractSkillView *view)
+{
+    m_views.removeAll(view);
+    if (!m_views.isEmpty()) {
+        return;
+    }
+
+    if (!m_group.isEmpty()) {
+        s_groups.remove(m_group);
+    }
+    // Not announced anymore from now on
+    m_controller->unregisterConnection(this);
+    m_reconnectBackoff->cancel();
+    m_socket->close();
+    deleteLater();
+}
+
+GuiConnection::GuiConnection(const QString &group)
+    : QObject(nullptr),
+      m_id(QUuid::createUuid().toString()),
+      m_group(group),
+      m_controller(MycroftController::instance())
+{
+    if (!m_group.isEmpty()) {
+        s_groups[m_group] = this;
+    }
+
+    m_socket = new MessageSocket(this);
+    m_socket->setLocalSocketDirectory(GlobalSettings::instance()->localSocketDirectory());
+    m_reconnectBackoff = ConnectionScheduler::instance()->createGuiBackoff(m_id, this);
+    m_latency = new LatencyProbe(m_socket, this);
+
+    connect(m_socket, &MessageSocket::connected, this,
+            [this] () {
+                m_reconnectBackoff->succeeded();
+                emit statusChanged();
+            });
+
+    connect(m_socket, &MessageSocket::disconnected, this, &GuiConnection::closed);
+
+    connect(m_socket, &MessageSocket::stateChanged, this,
+            [this](QAbstractSocket::SocketState socketState) {
+                emit statusChanged();
+                //Try to reconnect if our connection died but the main server connection is still alive
+                if (socketState == QAbstractSocket::UnconnectedState && m_url.isValid() && m_controller->status() == MycroftController::Open) {
+                    m_reconnectBackoff->schedule();
+                }
+            });
+
+    connect(m_socket, &MessageSocket::textMessageReceived, this, &GuiConnection::onTextMessageReceived);
+
+    connect(m_socket, &MessageSocket::error, this,
+            [this](QAbstractSocket::SocketError error) {
+                qWarning() << "Gui socket Connection Error:" << error;
+                //the GUI socket comes after the bus connection, which will announce this connection again
+                if (m_url.isValid() && m_controller->status() == MycroftController::Open) {
+                    m_reconnectBackoff->schedule();
+                }
+            });
+
+    connect(m_controller, &MycroftController::socketStatusChanged, this,
+            [this]() {
+                if (m_controller->status() != MycroftController::Open) {
+                    m_reconnectBackoff->cancel();
+                    m_socket->close();
+                    //don't assume the url will be still valid
+                    m_url = QUrl();
+                }
+            });
+
+    // Reconnect backoff
+    connect(m_reconnectBackoff, &ReconnectBackoff::retry, this, [this]() {
+        //the port may be stale after a server side restart of the GUI service
+        if (m_reconnectBackoff->attempts() > s_maxAttemptsPerPort) {
+            m_reconnectBackoff->cancel();
+            m_socket->close();
+            m_url = QUrl();
+            m_controller->reannounceConnections();
+            return;
+        }
+        m_socket->close();
+        m_socket->open(m_url);
+    });
+
+    // QWebSocket doesn't expose its receive buffer: the messages it delivers without
+    // returning to the event loop are what was queued in the socket
+    m_backlogTimer.setInterval(0);
+    m_backlogTimer.setSingleShot(true);
+    connect(&m_backlogTimer, &QTimer::timeout, this, [this]() {
+        static MetricGauge *s_backlog = MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_socket_backlog"),
+                                                                           QStringLiteral("GUI messages received in the last burst from the socket"));
+        s_backlog->set(m_backlog);
+        m_backlog = 0;
+    });
+
+    connect(BlobStore::instance(), &BlobStore::blobReleased, this, &GuiConnection::onBlobReleased);
+
+    m_controller->registerConnection(this);
+}
+
+GuiConnection::~GuiConnection()
+{
+}
+
+QString GuiConnection::id() const
+{
+    return m_id;
+}
+
+QString GuiConnection::group() const
+{
+    return m_group;
+}
+
+QUrl GuiConnection::url() const
+{
+    return m_url;
+}
+
+void GuiConnection::setUrl(const QUrl &url)
+{
+    if (m_url == url) {
+        return;
+    }
+
+    m_url = url;
+
+    //don't connect if the controller is offline
+    if (m_controller->status() == MycroftController::Open) {
+        m_socket->close();
+        m_socket->open(url);
+    }
+}
+
+void GuiConnection::resync()
+{
+    m_reconnectBackoff->cancel();
+    m_socket->close();
+    // The disconnection of the old socket isn't notified anymore once it is opened again
+    emit closed();
+    m_socket->open(m_url);
+}
+
+MycroftController::Status GuiConnection::status() const
+{
+    if (m_reconnectBackoff->isPending()) {
+        return MycroftController::Connecting;
+    }
+
+    switch(m_socket->state())
+    {
+    case QAbstractSocket::ConnectingState:
+    case QAbstractSocket::BoundState:
+    case QAbstractSocket::HostLookupState:
+        return MycroftController::Connecting;
+    case QAbstractSocket::UnconnectedState:
+        return MycroftController::Closed;
+    case QAbstractSocket::ConnectedState:
+        return MycroftController::Open;
+    case QAbstractSocket::ClosingState:
+        return MycroftController::Closing;
+    default:
+        return MycroftController::Connecting;
+    }
+}
+
+LatencyProbe *GuiConnection::latency() const
+{
+    return m_latency;
+}
+
+QList<AbstractSkillView *> GuiConnection::views() const
+{
+    return m_views;
+}
+
+void GuiConnection::sendMessage(const QJsonDocument &doc)
+{
+    if (m_socket->state() != QAbstractSocket::ConnectedState) {
+        qWarning() << "Error: Mycroft gui connection not open!";
+        return;
+    }
+
+    m_socket->sendTextMessage(QString::fromUtf8(doc.toJson()));
+}
+
+void GuiConnection::onTextMessageReceived(const QString &message)
+{
+    static MetricCounter *s_sessionBytes = MetricsRegistry::instance()->counter(QStringLiteral("mycroft_gui_session_bytes_total"),
+                                                                               QStringLiteral("Bytes received on the GUI sockets"));
+    static MetricHistogram *s_parseTime = MetricsRegistry::instance()->histogram(QStringLiteral("mycroft_gui_message_parse_seconds"),
+                                                                                QStringLiteral("Time spent parsing GUI messages"));
+
+    const qint64 received = MessageTracer::now();
+    const QByteArray payload = message.toUtf8();
+    s_sessionBytes->increment(payload.size());
+    if (m_backlog++ == 0) {
+        m_backlogTimer.start();
+    }
+    QJsonParseError parseError;
+    auto doc = QJsonDocument::fromJson(payload, &parseError);
+
+    if (doc.isEmpty()) {
+        qWarning() << "Empty or invalid JSON message arrived on the gui socket:" << message << "Error:" << parseError.errorString();
+        return;
+    }
+
+    auto type = doc[QStringLiteral("type")].toString();
+
+    if (type.isEmpty()) {
+        qWarning() << "Empty type in the JSON message on the gui socket";
+        return;
+    }
+
+    s_parseTime->observe(MessageTracer::now() - received);
+
+    MetricCounter *&messageCounter = m_messageCounters[type];
+    if (!messageCounter) {
+        messageCounter = MetricsRegistry::instance()->counter(QStringLiteral("mycroft_gui_messages_total"),
+                                                              QStringLiteral("GUI messages received, by type"),
+                                                              {{QStringLiteral("type"), type}});
+    }
+    messageCounter->increment();
+
+    // The message holds the blob while the views take their references: a blob no view shows is released right away
+    QString blobName;
+    if (type == QLatin1String("mycroft.session.blob")) {
+        const QVariantMap descriptor = doc[QStringLiteral("data")].toVariant().toMap();
+        if (!BlobStore::instance()->acquire(descriptor.value(QStringLiteral("name")).toString(), descriptor).isEmpty()) {
+            blobName = descriptor.value(QStringLiteral("name")).toString();
+            m_blobs.insert(blobName);
+        }
+    }
+
+    emit messageReceived(type, doc, received);
+
+    if (!blobName.isEmpty()) {
+        BlobStore::instance()->release(blobName);
+    }
+}
+
+void GuiConnection::onBlobReleased(const QString &name)
+{
+    if (!m_blobs.remove(name)) {
+        return;
+    }
+
+    QJsonObject root;
+    root[QStringLiteral("type")] = QStringLiteral("mycroft.session.blob.released");
+    root[QStringLiteral("data")] = QJsonObject({{QStringLiteral("name"), name}});
+    sendMessage(QJsonDocument(root));
+}
+
+#include "moc_guiconnection.cpp"
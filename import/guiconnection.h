@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "mycroftcontroller.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QJsonDocument>
+#include <QTimer>
+#include <QUrl>
+
+class MessageSocket;
+class AbstractSkillView;
+class ReconnectBackoff;
+class LatencyProbe;
+class MetricCounter;
+
+/**
+ * The GUI socket of one gui id, announced to the server by MycroftController.
+ * Every AbstractSkillView has one of its own, unless it is in a connection group:
+ * views of the same group share a single gui id and socket, each message is received
+ * and parsed once and then handed to all of them.
+ */
+class GuiConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * The connection of group, created for the first view that joins it.
+     * An empty group always creates a connection for view alone.
+     * A view joining an open connection makes it reconnect: the server sends its whole
+     * state only on connection, the views already there drop theirs and get it again as well
+     */
+    static GuiConnection *acquire(const QString &group, AbstractSkillView *view);
+
+    /**
+     * view stops using the connection, which goes away with its last view
+     */
+    void release(AbstractSkillView *view);
+
+    /**
+     * The gui id announced to the server
+     */
+    QString id() const;
+    QString group() const;
+
+    /**
+     * Url of the Web socket, given by the server in mycroft.gui.port
+     */
+    QUrl url() const;
+    void setUrl(const QUrl &url);
+
+    MycroftController::Status status() const;
+    LatencyProbe *latency() const;
+    QList<AbstractSkillView *> views() const;
+
+    /**
+     * Sends a message to the server, warns if the connection isn't open
+     */
+    void sendMessage(const QJsonDocument &doc);
+
+Q_SIGNALS:
+    void statusChanged();
+    void closed();
+
+    /**
+     * A valid message with a type arrived, received is the MessageTracer::now() of its reception
+     */
+    void messageReceived(const QString &type, const QJsonDocument &doc, qint64 received);
+
+private:
+    explicit GuiConnection(const QString &group);
+    ~GuiConnection() override;
+
+    void resync();
+    void onTextMessageReceived(const QString &message);
+    void onBlobReleased(const QString &name);
+
+    QString m_id;
+    QString m_group;
+    QUrl m_url;
+    QList<AbstractSkillView *> m_views;
+
+    MycroftController *m_controller;
+    MessageSocket *m_socket;
+    ReconnectBackoff *m_reconnectBackoff;
+    LatencyProbe *m_latency;
+
+    QHash<QString, MetricCounter *> m_messageCounters;
+    //blobs announced on this connection, the server is told when they are released
+    QSet<QString> m_blobs;
+    QTimer m_backlogTimer;
+    int m_backlog = 0;
+};
+
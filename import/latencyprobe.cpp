@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "latencyprobe.h"
+#include "messagesocket.h"
+
+#include <QtEndian>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+// About ten minutes of history at the default interval
+static const int s_windowSize = 120;
+static const qreal s_histogramBounds[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+static const int s_bucketCount = sizeof(s_histogramBounds) / sizeof(s_histogramBounds[0]) + 1;
+// Below this many samples percentiles are too noisy to call the link degraded
+static const int s_minSamples = 5;
+// Recovery needs the latency to go this much under the threshold, not to flap around it
+static const qreal s_recoveryRatio = 0.8;
+
+LatencyProbe::LatencyProbe(MessageSocket *socket, QObject *parent)
+    : QObject(parent),
+      m_socket(socket),
+      m_histogram(s_bucketCount, 0)
+{
+    m_window.reserve(s_windowSize);
+
+    m_pingTimer.setInterval(5000);
+    connect(&m_pingTimer, &QTimer::timeout, this, &LatencyProbe::sendPing);
+    connect(m_socket, &MessageSocket::pong, this, &LatencyProbe::onPong);
+    connect(m_socket, &MessageSocket::connected, this, [this]() {
+        m_pongPending = false;
+        m_pingTimer.start();
+        sendPing();
+    });
+    connect(m_socket, &MessageSocket::disconnected, this, [this]() {
+        m_pingTimer.stop();
+        m_pongPending = false;
+    });
+}
+
+LatencyProbe::~LatencyProbe()
+{
+}
+
+void LatencyProbe::sendPing()
+{
+    if (m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    if (m_pongPending) {
+        ++m_lostPings;
+        emit statsChanged();
+    }
+
+    // The serial tells a late pong of a lost ping from the pong of the current one
+    char payload[4];
+    qToBigEndian(++m_pingSerial, reinterpret_cast<uchar *>(payload));
+    m_pongPending = true;
+    m_pingClock.start();
+    m_socket->ping(QByteArray(payload, sizeof(payload)));
+}
+
+void LatencyProbe::onPong(quint64 elapsedTime, const QByteArray &payload)
+{
+    // Only millisecond precision, too coarse on a local link
+    Q_UNUSED(elapsedTime)
+
+    if (!m_pongPending || payload.size() != 4
+        || qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(payload.constData())) != m_pingSerial) {
+        return;
+    }
+
+    m_pongPending = false;
+    addSample(m_pingClock.nsecsElapsed() / 1000000.0);
+}
+
+int LatencyProbe::bucketFor(qreal rtt)
+{
+    return std::lower_bound(std::begin(s_histogramBounds), std::end(s_histogramBounds), rtt) - std::begin(s_histogramBounds);
+}
+
+void LatencyProbe::addSample(qreal rtt)
+{
+    if (m_lastRtt >= 0) {
+        m_jitter += (std::abs(rtt - m_lastRtt) - m_jitter) / 16;
+    }
+    m_lastRtt = rtt;
+
+    if (m_window.size() < s_windowSize) {
+        m_window.append(rtt);
+    } else {
+        --m_histogram[bucketFor(m_window[m_windowNext])];
+        m_window[m_windowNext] = rtt;
+        m_windowNext = (m_windowNext + 1) % s_windowSize;
+    }
+    ++m_histogram[bucketFor(rtt)];
+
+    updatePercentiles();
+    emit statsChanged();
+    updateDegraded();
+}
+
+qreal LatencyProbe::percentile(qreal percent) const
+{
+    if (m_window.isEmpty()) {
+        return -1;
+    }
+
+    // Nearest rank, on a copy: the window is small
+    QVector<qreal> sorted = m_window;
+    const int rank = qBound(0, int(std::ceil(percent / 100 * sorted.size())) - 1, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+void LatencyProbe::updatePercentiles()
+{
+    m_p50 = percentile(50);
+    m_p95 = percentile(95);
+    m_p99 = percentile(99);
+}
+
+void LatencyProbe::updateDegraded()
+{
+    if (m_window.size() < s_minSamples) {
+        return;
+    }
+
+    if (!m_degraded && m_p95 > m_degradedThreshold) {
+        m_degraded = true;
+        emit degradedChanged();
+        emit latencyDegraded(m_p95);
+    } else if (m_degraded && m_p95 < m_degradedThreshold * s_recoveryRatio) {
+        m_degraded = false;
+        emit degradedChanged();
+        emit latencyRecovered();
+    }
+}
+
+qreal LatencyProbe::lastRtt() const
+{
+    return m_lastRtt;
+}
+
+qreal LatencyProbe::p50() const
+{
+    return m_p50;
+}
+
+qreal LatencyProbe::p95() const
+{
+    return m_p95;
+}
+
+qreal LatencyProbe::p99() const
+{
+    return m_p99;
+}
+
+qreal LatencyProbe::jitter() const
+{
+    return m_jitter;
+}
+
+int LatencyProbe::samples() const
+{
+    return m_window.size();
+}
+
+int LatencyProbe::lostPings() const
+{
+    return m_lostPings;
+}
+
+QVariantList LatencyProbe::histogram() const
+{
+    QVariantList histogram;
+    for (const int count : m_histogram) {
+        histogram << count;
+    }
+    return histogram;
+}
+
+QVariantList LatencyProbe::histogramBounds() const
+{
+    QVariantList bounds;
+    for (const qreal bound : s_histogramBounds) {
+        bounds << bound;
+    }
+    return bounds;
+}
+
+int LatencyProbe::interval() const
+{
+    return m_pingTimer.interval();
+}
+
+void LatencyProbe::setInterval(int interval)
+{
+    interval = qMax(10, interval);
+    if (m_pingTimer.interval() == interval) {
+        return;
+    }
+
+    m_pingTimer.setInterval(interval);
+    emit intervalChanged();
+}
+
+int LatencyProbe::degradedThreshold() const
+{
+    return m_degradedThreshold;
+}
+
+void LatencyProbe::setDegradedThreshold(int threshold)
+{
+    if (m_degradedThreshold == threshold) {
+        return;
+    }
+
+    m_degradedThreshold = threshold;
+    emit degradedThresholdChanged();
+    updateDegraded();
+}
+
+bool LatencyProbe::isDegraded() const
+{
+    return m_degraded;
+}
+
+#include "moc_latencyprobe.cpp"
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVariantList>
+#include <QVector>
+
+class MessageSocket;
+
+/**
+ * Measures the round trip time of a connection with periodic ping frames, answered
+ * by the server websocket implementation itself, or by the server on the local transport. The most recent round trips are kept
+ * in a rolling window, from which percentiles, jitter and a histogram are computed.
+ * All times are in milliseconds.
+ */
+class LatencyProbe : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal lastRtt READ lastRtt NOTIFY statsChanged)
+    Q_PROPERTY(qreal p50 READ p50 NOTIFY statsChanged)
+    Q_PROPERTY(qreal p95 READ p95 NOTIFY statsChanged)
+    Q_PROPERTY(qreal p99 READ p99 NOTIFY statsChanged)
+    /**
+     * Smoothed variation between consecutive round trips, as RFC 3550 does for interarrival jitter
+     */
+    Q_PROPERTY(qreal jitter READ jitter NOTIFY statsChanged)
+    Q_PROPERTY(int samples READ samples NOTIFY statsChanged)
+    /**
+     * Pings which got no pong before the next one was due
+     */
+    Q_PROPERTY(int lostPings READ lostPings NOTIFY statsChanged)
+    /**
+     * Round trips of the window per bucket, the upper bounds of the buckets are in histogramBounds,
+     * the last bucket counts everything above
+     */
+    Q_PROPERTY(QVariantList histogram READ histogram NOTIFY statsChanged)
+    Q_PROPERTY(QVariantList histogramBounds READ histogramBounds CONSTANT)
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    /**
+     * The link is considered degraded when the 95th percentile goes over this
+     */
+    Q_PROPERTY(int degradedThreshold READ degradedThreshold WRITE setDegradedThreshold NOTIFY degradedThresholdChanged)
+    Q_PROPERTY(bool degraded READ isDegraded NOTIFY degradedChanged)
+
+public:
+    explicit LatencyProbe(MessageSocket *socket, QObject *parent = nullptr);
+    ~LatencyProbe();
+
+    qreal lastRtt() const;
+    qreal p50() const;
+    qreal p95() const;
+    qreal p99() const;
+    qreal jitter() const;
+    int samples() const;
+    int lostPings() const;
+    QVariantList histogram() const;
+    QVariantList histogramBounds() const;
+
+    int interval() const;
+    void setInterval(int interval);
+
+    int degradedThreshold() const;
+    void setDegradedThreshold(int threshold);
+
+    bool isDegraded() const;
+
+    /**
+     * Accounts one round trip, called for every pong
+     */
+    void addSample(qreal rtt);
+
+    /**
+     * @returns the given percentile (0-100) of the window, -1 if empty
+     */
+    qreal percentile(qreal percent) const;
+
+Q_SIGNALS:
+    void statsChanged();
+    void intervalChanged();
+    void degradedThresholdChanged();
+    void degradedChanged();
+    /**
+     * The 95th percentile went over degradedThreshold
+     */
+    void latencyDegraded(qreal p95);
+    /**
+     * The 95th percentile went back well under degradedThreshold
+     */
+    void latencyRecovered();
+
+private:
+    void sendPing();
+    void onPong(quint64 elapsedTime, const QByteArray &payload);
+    void updatePercentiles();
+    void updateDegraded();
+    static int bucketFor(qreal rtt);
+
+    MessageSocket *m_socket;
+    QTimer m_pingTimer;
+    QElapsedTimer m_pingClock;
+    quint32 m_pingSerial = 0;
+    bool m_pongPending = false;
+
+    QVector<qreal> m_window;
+    int m_windowNext = 0;
+    QVector<int> m_histogram;
+
+    qreal m_lastRtt = -1;
+    qreal m_p50 = -1;
+    qreal m_p95 = -1;
+    qreal m_p99 = -1;
+    qreal m_jitter = 0;
+    int m_lostPings = 0;
+    int m_degradedThreshold = 250;
+    bool m_degraded = false;
+};
+
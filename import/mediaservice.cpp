@@ -16,6 +16,7 @@
  */
 
 #include "mediaservice.h"
+#include "sampleconversion.h"
 #include <QAudioProbe>
 #include <QMediaObject>
 #include <QMediaPlayer>
@@ -23,6 +24,9 @@
 #include <QAudioDeviceInfo>
 #include <QAudioInput>
 #include <QAudioRecorder>
+#include <QQuickWindow>
+
+#include <algorithm>
 
 MediaService::MediaService(QObject *parent)
     : QObject(parent),
@@ -34,33 +38,88 @@ MediaService::MediaService(QObject *parent)
                 &MediaService::onMainSocketIntentReceived);
     }
 
+    m_positionTimer.setInterval(250);
+    connect(&m_positionTimer, &QTimer::timeout, this, &MediaService::reportPosition);
+    m_syncTimer.setInterval(1000);
+    connect(&m_syncTimer, &QTimer::timeout, this, &MediaService::syncPosition);
+
+    // The player, the probe and the spectrum worker are created by ensurePlayer on first use
+}
+
+void MediaService::ensurePlayer()
+{
+    if (m_player) {
+        return;
+    }
+
     calculator = new FFTCalc(this);
-    m_player = new QMediaPlayer;
+    calculator->setIdleTimeout(m_idleTimeout);
     connect(calculator, &FFTCalc::calculatedSpectrum, this, [this](QVector<double> spectrum) {
-        int size = 20;
+        // Each value is the loudest of its group of bins, picking one bin every n would alias.
+        // The groups cover all the bins even when they don't divide evenly
+        const int size = 20;
+        const int n = spectrum.size();
         m_spectrum.resize(size);
-        int j = 0;
-        for (int i = 0; i < spectrum.size(); i += spectrum.size()/(size - 1)) {
-            m_spectrum[j] = spectrum[i];
-            ++j;
+        for (int j = 0; j < size; ++j) {
+            const int first = j * n / size;
+            const int last = qMax(first + 1, (j + 1) * n / size);
+            m_spectrum[j] = first < n ? *std::max_element(spectrum.constBegin() + first, spectrum.constBegin() + last) : 0;
+        }
+        if (m_presentationWindow) {
+            // Intermediate spectra are overwritten until the next frame
+            m_spectrumPending = true;
+            m_presentationWindow->update();
+        } else {
+            emit spectrumChanged();
         }
-        emit spectrumChanged();
     });
 
-    connect(m_player, &QMediaPlayer::mediaStatusChanged, this, &MediaService::onMediaStatusChanged);
+    m_player = new QMediaPlayer(this);
     setupProbeSource();
+    attachPlayer(m_player);
 }
 
 void MediaService::setupProbeSource()
 {
-    QAudioProbe *probe = new QAudioProbe;
-    probe->setSource(m_player);
+    if (!m_player) {
+        ensurePlayer();
+        return;
+    }
 
-    connect(probe, SIGNAL(audioBufferProbed(QAudioBuffer)), this, SLOT(processBuffer(QAudioBuffer)));
+    if (!m_probe) {
+        m_probe = new QAudioProbe(this);
+        connect(m_probe, SIGNAL(audioBufferProbed(QAudioBuffer)), this, SLOT(processBuffer(QAudioBuffer)));
+    }
+    m_probe->setSource(m_player);
 
     return;
 }
 
+void MediaService::attachPlayer(QMediaPlayer *player)
+{
+    connect(player, &QMediaPlayer::mediaStatusChanged, this, &MediaService::onMediaStatusChanged);
+    connect(player, &QMediaPlayer::stateChanged, this, &MediaService::onPlayerStateChanged);
+    // The position is polled at the reporting cadence instead of following the notifications of the player
+    connect(player, &QMediaPlayer::durationChanged, this, &MediaService::onPlayerDurationChanged);
+    m_probe->setSource(player);
+    if (mVideoSurface) {
+        player->setVideoOutput(mVideoSurface);
+    }
+}
+
+void MediaService::detachPlayer(QMediaPlayer *player)
+{
+    disconnect(player, nullptr, this, nullptr);
+    if (mVideoSurface) {
+        player->setVideoOutput(static_cast<QAbstractVideoSurface *>(nullptr));
+    }
+}
+
+SpectrumBuffer *MediaService::latestSpectrum() const
+{
+    return calculator ? calculator->latestSpectrum() : nullptr;
+}
+
 QAbstractVideoSurface *MediaService::videoSurface() const
 {
     return mVideoSurface;
@@ -71,7 +130,9 @@ void MediaService::setVidSurface(QAbstractVideoSurface *videoSurface)
     if(videoSurface != mVideoSurface)
     {
         mVideoSurface = videoSurface;
-        m_player->setVideoOutput(mVideoSurface);
+        if (m_player) {
+            m_player->setVideoOutput(mVideoSurface);
+        }
 
         emit signalVideoSurfaceChanged();
     }
@@ -79,117 +140,331 @@ void MediaService::setVidSurface(QAbstractVideoSurface *videoSurface)
 
 void MediaService::processBuffer(QAudioBuffer buffer)
 {
-    qreal peakValue;
-    int duration;
-
     if(buffer.frameCount() < 512)
         return;
 
-    levelLeft = levelRight = 0;
-
     if(buffer.format().channelCount() != 2)
         return;
 
     sample.resize(buffer.frameCount());
-    if(buffer.format().sampleType() == QAudioFormat::SignedInt){
-        QAudioBuffer::S16S *data = buffer.data<QAudioBuffer::S16S>();
-        if (buffer.format().sampleSize() == 32)
-            peakValue=INT_MAX;
-        else if (buffer.format().sampleSize() == 16)
-            peakValue=SHRT_MAX;
-        else
-            peakValue=CHAR_MAX;
-
-        for(int i=0; i<buffer.frameCount(); i++){
-            sample[i] = data[i].left/peakValue;
-#ifndef Q_OS_ANDROID
-            levelLeft+= abs(data[i].left)/peakValue;
-            levelRight+= abs(data[i].right)/peakValue;
-#else
-            levelLeft+= (data[i].left)/peakValue * ((data[i].left)/peakValue>0) - ((data[i].left)/peakValue<0);
-            levelRight+= (data[i].right)/peakValue * ((data[i].right)/peakValue>0) - ((data[i].right)/peakValue<0);
-#endif
+    StereoLevels stereoLevels;
+
+    const int frames = buffer.frameCount();
+    const int sampleSize = buffer.format().sampleSize();
+    switch (buffer.format().sampleType()) {
+    case QAudioFormat::SignedInt:
+        if (sampleSize == 32) {
+            convertSamples(buffer.constData<qint32>(), frames, sample.data(), stereoLevels);
+        } else if (sampleSize == 16) {
+            convertSamples(buffer.constData<qint16>(), frames, sample.data(), stereoLevels);
+        } else if (sampleSize == 8) {
+            convertSamples(buffer.constData<qint8>(), frames, sample.data(), stereoLevels);
+        } else {
+            return;
+        }
+        break;
+    case QAudioFormat::UnSignedInt:
+        if (sampleSize == 32) {
+            convertSamples(buffer.constData<quint32>(), frames, sample.data(), stereoLevels);
+        } else if (sampleSize == 16) {
+            convertSamples(buffer.constData<quint16>(), frames, sample.data(), stereoLevels);
+        } else if (sampleSize == 8) {
+            convertSamples(buffer.constData<quint8>(), frames, sample.data(), stereoLevels);
+        } else {
+            return;
         }
+        break;
+    case QAudioFormat::Float:
+        if (sampleSize != 32) {
+            return;
+        }
+        convertSamples(buffer.constData<float>(), frames, sample.data(), stereoLevels);
+        break;
+    default:
+        return;
     }
 
-    else if(buffer.format().sampleType() == QAudioFormat::UnSignedInt){
-        QAudioBuffer::S16U *data = buffer.data<QAudioBuffer::S16U>();
-        if (buffer.format().sampleSize() == 32)
-            peakValue=UINT_MAX;
-        else if (buffer.format().sampleSize() == 16)
-            peakValue=USHRT_MAX;
-        else
-            peakValue=UCHAR_MAX;
-        for(int i=0; i<buffer.frameCount(); i++){
-            sample[i] = data[i].left/peakValue;
-#ifndef Q_OS_ANDROID
-            levelLeft+= abs(data[i].left)/peakValue;
-            levelRight+= abs(data[i].right)/peakValue;
-#else
-            levelLeft+= (data[i].left)/peakValue * ((data[i].left)/peakValue>0) - ((data[i].left)/peakValue<0);
-            levelRight+= (data[i].right)/peakValue * ((data[i].right)/peakValue>0) - ((data[i].right)/peakValue<0);
-#endif
-        }
+    levelLeft = stereoLevels.left;
+    levelRight = stereoLevels.right;
+
+    calculator->calc(sample.constData(), frames, buffer.format().sampleRate());
+    publishLevels(levelLeft/buffer.frameCount(), levelRight/buffer.frameCount());
+}
+
+void MediaService::publishLevels(double left, double right)
+{
+    if (!m_presentationWindow) {
+        emit levels(left, right);
+        return;
     }
 
-    else if(buffer.format().sampleType() == QAudioFormat::Float){
-        QAudioBuffer::S32F *data = buffer.data<QAudioBuffer::S32F>();
-        peakValue = 1.00003;
-        for(int i=0; i<buffer.frameCount(); i++){
-            sample[i] = data[i].left/peakValue;
-            if(sample[i] != sample[i]){
-                sample[i] = 0;
-            }
-            else{
-#ifndef Q_OS_ANDROID
-                levelLeft+= abs(data[i].left)/peakValue;
-                levelRight+= abs(data[i].right)/peakValue;
-#else
-                levelLeft+= (data[i].left)/peakValue * ((data[i].left)/peakValue>0) - ((data[i].left)/peakValue<0);
-                levelRight+= (data[i].right)/peakValue * ((data[i].right)/peakValue>0) - ((data[i].right)/peakValue<0);
-#endif
-            }
-        }
+    m_pendingLevelLeft = left;
+    m_pendingLevelRight = right;
+    m_levelsPending = true;
+    m_presentationWindow->update();
+}
+
+QQuickWindow *MediaService::presentationWindow() const
+{
+    return m_presentationWindow;
+}
+
+void MediaService::setPresentationWindow(QQuickWindow *window)
+{
+    if (m_presentationWindow == window) {
+        return;
+    }
+
+    if (m_presentationWindow) {
+        disconnect(m_presentationWindow, nullptr, this, nullptr);
+        publishFrame();
+    }
+
+    m_presentationWindow = window;
+
+    // afterAnimating is the last GUI thread step of a frame before the scene graph
+    // synchronization: beforeSynchronizing itself is emitted in the render thread,
+    // where QML bindings can't be evaluated
+    if (m_presentationWindow) {
+        connect(m_presentationWindow, &QQuickWindow::afterAnimating, this, &MediaService::publishFrame);
+    }
+
+    emit presentationWindowChanged();
+}
+
+void MediaService::publishFrame()
+{
+    if (m_spectrumPending) {
+        m_spectrumPending = false;
+        emit spectrumChanged();
+    }
+    if (m_levelsPending) {
+        m_levelsPending = false;
+        emit levels(m_pendingLevelLeft, m_pendingLevelRight);
     }
-    duration = buffer.format().durationForBytes(buffer.frameCount())/1000;
-    calculator->calc(sample, duration);
-    emit levels(levelLeft/buffer.frameCount(), levelRight/buffer.frameCount());
 }
 
 void MediaService::playURL(const QString &filename)
 {
+    // Asked to play what was announced as the next track: it is already buffered
+    if (!m_nextTrack.isEmpty() && filename == m_nextTrack && switchToPreloaded()) {
+        return;
+    }
+
+    ensurePlayer();
+    resetReportedPosition();
     m_player->setMedia(QUrl(filename));
     m_player->play();
     setPlaybackState(QMediaPlayer::PlayingState);
-    connect(m_player, &QMediaPlayer::durationChanged, this, [&](qint64 dur) {
-        emit durationChanged(dur);
-    });
-    connect(m_player, &QMediaPlayer::positionChanged, this, [&](qint64 pos) {
-        emit positionChanged(pos);
-    });
+}
+
+void MediaService::preloadURL(const QString &filename)
+{
+    if (filename == m_nextTrack) {
+        return;
+    }
+
+    ensurePlayer();
+    if (!m_nextPlayer) {
+        m_nextPlayer = new QMediaPlayer(this);
+    }
+
+    m_nextTrack = filename;
+    if (m_nextTrack.isEmpty()) {
+        m_nextPlayer->setMedia(QMediaContent());
+        return;
+    }
+
+    // Pausing a stopped player opens and prerolls the media: the decoder is ready and
+    // the first buffers are there, but nothing gets played and nothing is probed
+    m_nextPlayer->setMedia(QUrl(m_nextTrack));
+    m_nextPlayer->pause();
+}
+
+bool MediaService::switchToPreloaded()
+{
+    if (!m_nextPlayer || m_nextTrack.isEmpty() || m_nextPlayer->mediaStatus() == QMediaPlayer::InvalidMedia) {
+        return false;
+    }
+
+    QMediaPlayer *previous = m_player;
+    detachPlayer(previous);
+    m_player = m_nextPlayer;
+    resetReportedPosition();
+    attachPlayer(m_player);
+    m_player->play();
+
+    // The old player is kept around to preload the track after this one
+    previous->stop();
+    previous->setMedia(QMediaContent());
+    m_nextPlayer = previous;
+
+    m_track = m_nextTrack;
+    m_nextTrack.clear();
+
+    setPlaybackState(QMediaPlayer::PlayingState);
+    onPlayerDurationChanged(m_player->duration());
+    onMediaStatusChanged(m_player->mediaStatus());
+
+    QVariantMap trackData;
+    trackData.insert(QStringLiteral("track"), m_track);
+    m_controller->sendRequest(QStringLiteral("gui.player.media.service.track.changed"), trackData);
+    emit trackChanged(m_track);
+
+    return true;
+}
+
+int MediaService::idleTimeout() const
+{
+    return m_idleTimeout;
+}
+
+void MediaService::setIdleTimeout(int timeout)
+{
+    timeout = qMax(FRAMEINTERVAL, timeout);
+    if (m_idleTimeout == timeout) {
+        return;
+    }
+
+    m_idleTimeout = timeout;
+    if (calculator) {
+        calculator->setIdleTimeout(m_idleTimeout);
+    }
+    emit idleTimeoutChanged();
+}
+
+void MediaService::onPlayerStateChanged(QMediaPlayer::State state)
+{
+    if (state == QMediaPlayer::PlayingState) {
+        m_positionTimer.start();
+        if (m_syncTimer.interval() > 0) {
+            m_syncTimer.start();
+        }
+        return;
+    }
+
+    // Where playback stopped, so that the UI and the server don't stay on the last tick
+    m_positionTimer.stop();
+    m_syncTimer.stop();
+    reportPosition();
+    syncPosition();
+}
+
+void MediaService::onPlayerDurationChanged(qint64 duration)
+{
+    if (duration == m_reportedDuration) {
+        return;
+    }
+
+    m_reportedDuration = duration;
+    emit durationChanged(duration);
+}
+
+void MediaService::resetReportedPosition()
+{
+    m_reportedPosition = -1;
+    m_syncedPosition = -1;
+    m_reportedDuration = -1;
+}
+
+void MediaService::reportPosition()
+{
+    const qint64 position = m_player->position();
+    if (position == m_reportedPosition) {
+        return;
+    }
+
+    m_reportedPosition = position;
+    emit positionChanged(position);
+}
+
+void MediaService::syncPosition()
+{
+    if (m_syncTimer.interval() <= 0 || m_controller->status() != MycroftController::Open) {
+        return;
+    }
+
+    const qint64 position = m_player->position();
+    if (position == m_syncedPosition) {
+        return;
+    }
+
+    m_syncedPosition = position;
+    QVariantMap positionData;
+    positionData.insert(QStringLiteral("position"), position);
+    positionData.insert(QStringLiteral("duration"), m_player->duration());
+    m_controller->sendRequest(QStringLiteral("gui.player.media.service.sync.position"), positionData);
+}
+
+int MediaService::positionInterval() const
+{
+    return m_positionTimer.interval();
+}
+
+void MediaService::setPositionInterval(int interval)
+{
+    interval = qMax(1, interval);
+    if (m_positionTimer.interval() == interval) {
+        return;
+    }
+
+    // Changing the interval restarts an active timer
+    m_positionTimer.setInterval(interval);
+    emit positionIntervalChanged();
+}
+
+int MediaService::syncInterval() const
+{
+    return m_syncTimer.interval();
+}
+
+void MediaService::setSyncInterval(int interval)
+{
+    interval = qMax(0, interval);
+    if (m_syncTimer.interval() == interval) {
+        return;
+    }
+
+    m_syncTimer.setInterval(interval);
+    if (interval == 0) {
+        m_syncTimer.stop();
+    } else if (m_player && m_player->state() == QMediaPlayer::PlayingState) {
+        m_syncTimer.start();
+    }
+    emit syncIntervalChanged();
 }
 
 void MediaService::playerStop()
 {
-    m_player->stop();
+    if (m_player) {
+        m_player->stop();
+    }
     setPlaybackState(QMediaPlayer::StoppedState);
 }
 
 void MediaService::playerPause()
 {
+    if (!m_player) {
+        return;
+    }
     m_player->pause();
     setPlaybackState(QMediaPlayer::PausedState);
 }
 
 void MediaService::playerContinue()
 {
+    if (!m_player) {
+        return;
+    }
     m_player->play();
     setPlaybackState(QMediaPlayer::PlayingState);
 }
 
 void MediaService::playerRestart()
 {
-    m_player->stop();
+    if (m_player) {
+        m_player->stop();
+    }
     playURL(m_track);
 }
 
@@ -230,7 +505,9 @@ void MediaService::setPlaybackState(QMediaPlayer::State playbackState)
 
 void MediaService::playerSeek(qint64 seekvalue)
 {
-    m_player->setPosition(seekvalue);
+    if (m_player) {
+        m_player->setPosition(seekvalue);
+    }
 }
 
 QString MediaService::getTrack()
@@ -269,11 +546,16 @@ bool MediaService::getRepeat()
 
 QMediaPlayer::State MediaService::playbackState() const
 {
-    return m_player->state();
+    return m_player ? m_player->state() : QMediaPlayer::StoppedState;
 }
 
 void MediaService::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
 {
+    // With a preloaded next track the end of this one isn't reported, the next one just starts
+    if (status == QMediaPlayer::EndOfMedia && switchToPreloaded()) {
+        return;
+    }
+
     emit mediaStatusChanged(status);
 
     m_currentMediaStatus.clear();
@@ -317,6 +599,10 @@ void MediaService::onMainSocketIntentReceived(const QString &type, const QVarian
         emit playRequested();
     }
 
+    if(type == QStringLiteral("gui.player.media.service.preload")) {
+        preloadURL(data[QStringLiteral("track")].toString());
+    }
+
     if(type == QStringLiteral("gui.player.media.service.pause")) {
         playerPause();
         emit pauseRequested();
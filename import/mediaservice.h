@@ -24,29 +24,68 @@
 #include <QMediaPlayer>
 #include <QAbstractVideoSurface>
 #include <QJsonDocument>
+#include <QPointer>
+#include <QTimer>
 #include "thirdparty/fftcalc.h"
 #include "mycroftcontroller.h"
 
+class QQuickWindow;
+
 class MediaService : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(QVector<double> spectrum READ spectrum NOTIFY spectrumChanged)
     Q_PROPERTY(QMediaPlayer::State playbackState READ playbackState NOTIFY playbackStateChanged)
     Q_PROPERTY(QAbstractVideoSurface* videoSurface READ videoSurface WRITE setVidSurface NOTIFY signalVideoSurfaceChanged)
+    /**
+     * Presentation mode: when set, spectrumChanged and levels are emitted at most once per frame
+     * of this window, right before it synchronizes with the scene graph, with the latest values only
+     */
+    Q_PROPERTY(QQuickWindow *presentationWindow READ presentationWindow WRITE setPresentationWindow NOTIFY presentationWindowChanged)
+    /**
+     * Milliseconds between two positionChanged while playing, only emitted if the position has changed
+     */
+    Q_PROPERTY(int positionInterval READ positionInterval WRITE setPositionInterval NOTIFY positionIntervalChanged)
+    /**
+     * Milliseconds between two gui.player.media.service.sync.position messages to the server while playing,
+     * only sent if the position has changed. 0 disables them
+     */
+    Q_PROPERTY(int syncInterval READ syncInterval WRITE setSyncInterval NOTIFY syncIntervalChanged)
+    /**
+     * Milliseconds without any audio after which the spectrum worker thread is stopped,
+     * it is started again by the next played buffer
+     */
+    Q_PROPERTY(int idleTimeout READ idleTimeout WRITE setIdleTimeout NOTIFY idleTimeoutChanged)
 
 public:
     explicit MediaService(QObject *parent = Q_NULLPTR);
 
     QMediaPlayer::State playerState() const {return m_playerState;}
     QVector<double> spectrum() const {return m_spectrum;}
+    // For C++ consumers like SpectrumItem, not exposed to QML
+    SpectrumBuffer *latestSpectrum() const;
     QAbstractVideoSurface *videoSurface() const;
     void setVidSurface(QAbstractVideoSurface *videoSurface);
     QMediaPlayer::State getPlaybackState();
+    QQuickWindow *presentationWindow() const;
+    void setPresentationWindow(QQuickWindow *window);
+    int positionInterval() const;
+    void setPositionInterval(int interval);
+    int syncInterval() const;
+    void setSyncInterval(int interval);
+    int idleTimeout() const;
+    void setIdleTimeout(int timeout);
 
 public Q_SLOTS:
     void setupProbeSource();
     void processBuffer(QAudioBuffer buffer);
     void playURL(const QString &filename);
+    /**
+     * Opens and buffers the track that comes after the current one on a second player,
+     * which takes over without a gap at the end of the current track, or when
+     * playURL is called with the same track. An empty filename drops the preloaded track
+     */
+    void preloadURL(const QString &filename);
     void playerStop();
     void playerPause();
     void playerContinue();
@@ -79,20 +118,36 @@ Q_SIGNALS:
     void shuffleRequested();
     void metaReceived();
     void metaUpdated();
+    // The preloaded track has started playing
+    void trackChanged(const QString &track);
 
 private:
     MycroftController *m_controller;
     QAbstractVideoSurface *mVideoSurface;
     void onMainSocketIntentReceived(const QString &type, const QVariantMap &data);
     void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+    void publishLevels(double left, double right);
+    void ensurePlayer();
+    void attachPlayer(QMediaPlayer *player);
+    void detachPlayer(QMediaPlayer *player);
+    bool switchToPreloaded();
+    void onPlayerStateChanged(QMediaPlayer::State state);
+    void onPlayerDurationChanged(qint64 duration);
+    void resetReportedPosition();
+    void reportPosition();
+    void syncPosition();
+    void publishFrame();
 
-    QVector<double> sample;
+    QVector<float> sample;
     QVector<double> m_spectrum;
     QMediaPlayer::State m_playerState;
     double levelLeft, levelRight;
-    FFTCalc *calculator;
-    QMediaPlayer *m_player;
+    FFTCalc *calculator = nullptr;
+    QMediaPlayer *m_player = nullptr;
+    QMediaPlayer *m_nextPlayer = nullptr;
+    QAudioProbe *m_probe = nullptr;
     QString m_track;
+    QString m_nextTrack;
     QString m_artist;
     QString m_album;
     QString m_title;
@@ -102,10 +157,25 @@ private:
     QVariantMap m_metadataList;
     QVariantMap m_playerStateSync;
     QVariantMap m_currentMediaStatus;
+    QPointer<QQuickWindow> m_presentationWindow;
+    bool m_spectrumPending = false;
+    bool m_levelsPending = false;
+    double m_pendingLevelLeft = 0;
+    double m_pendingLevelRight = 0;
+    QTimer m_positionTimer;
+    QTimer m_syncTimer;
+    qint64 m_reportedPosition = -1;
+    qint64 m_syncedPosition = -1;
+    qint64 m_reportedDuration = -1;
+    int m_idleTimeout = IDLETIMEOUT;
 
 signals:
     int levels(double left, double right);
     void spectrumChanged();
+    void presentationWindowChanged();
+    void positionIntervalChanged();
+    void syncIntervalChanged();
+    void idleTimeoutChanged();
 };
 
 #endif // MEDIASERVICE_H
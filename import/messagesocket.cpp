@@ -0,0 +1,256 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "messagesocket.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QLocalSocket>
+#include <QWebSocket>
+#include <QtEndian>
+#include <QDebug>
+
+MessageSocket::MessageSocket(QObject *parent)
+    : QObject(parent),
+      m_webSocket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this)),
+      m_localSocket(new QLocalSocket(this))
+{
+    connect(m_webSocket, &QWebSocket::connected, this, &MessageSocket::connected);
+    connect(m_webSocket, &QWebSocket::disconnected, this, &MessageSocket::disconnected);
+    connect(m_webSocket, &QWebSocket::stateChanged, this, &MessageSocket::stateChanged);
+    connect(m_webSocket, &QWebSocket::textMessageReceived, this, &MessageSocket::textMessageReceived);
+    connect(m_webSocket, &QWebSocket::pong, this, &MessageSocket::pong);
+    connect(m_webSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error), this, &MessageSocket::error);
+
+    connect(m_localSocket, &QLocalSocket::connected, this, [this]() {
+        m_localConnected = true;
+        emit stateChanged(QAbstractSocket::ConnectedState);
+        emit connected();
+    });
+    connect(m_localSocket, &QLocalSocket::disconnected, this, [this]() {
+        m_readBuffer.clear();
+        //a refused local connection falls back to the websocket, it never was connected
+        if (m_localConnected) {
+            m_localConnected = false;
+            emit disconnected();
+        }
+    });
+    connect(m_localSocket, &QLocalSocket::stateChanged, this, [this](QLocalSocket::LocalSocketState state) {
+        // The socket can be written only from connected(), which announces the connected state
+        if (!m_local || state == QLocalSocket::ConnectedState) {
+            return;
+        }
+        // Comes before the error, which may fall back to the websocket: then it never was unconnected
+        if (state == QLocalSocket::UnconnectedState && !m_localConnected) {
+            m_unconnectedPending = true;
+            return;
+        }
+        // LocalSocketState has the values of the matching SocketState
+        emit stateChanged(static_cast<QAbstractSocket::SocketState>(state));
+    });
+    connect(m_localSocket, &QLocalSocket::readyRead, this, &MessageSocket::readFrames);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    connect(m_localSocket, &QLocalSocket::errorOccurred, this,
+#else
+    connect(m_localSocket, QOverload<QLocalSocket::LocalSocketError>::of(&QLocalSocket::error), this,
+#endif
+            [this](QLocalSocket::LocalSocketError socketError) {
+                if (!m_local) {
+                    return;
+                }
+                //stale socket file, or a server without the local transport
+                if (!m_localConnected && (socketError == QLocalSocket::ServerNotFoundError || socketError == QLocalSocket::ConnectionRefusedError)) {
+                    qWarning() << "Local socket for" << m_url << "refused the connection, using the websocket";
+                    m_local = false;
+                    m_unconnectedPending = false;
+                    openWebSocket();
+                    return;
+                }
+                flushUnconnected();
+                // LocalSocketError has the values of the matching SocketError
+                emit error(static_cast<QAbstractSocket::SocketError>(socketError));
+            });
+}
+
+MessageSocket::~MessageSocket()
+{
+}
+
+QString MessageSocket::localSocketDirectory() const
+{
+    return m_localSocketDirectory;
+}
+
+void MessageSocket::setLocalSocketDirectory(const QString &directory)
+{
+    m_localSocketDirectory = directory;
+}
+
+QString MessageSocket::localSocketPath(const QString &directory, const QUrl &url)
+{
+    if (directory.isEmpty() || url.port() < 0) {
+        return QString();
+    }
+
+    const QString host = url.host();
+    if (host != QLatin1String("localhost") && host != QLatin1String("127.0.0.1")
+        && host != QLatin1String("::1") && host != QLatin1String("0.0.0.0")) {
+        return QString();
+    }
+
+    const QString name = url.path().section(QLatin1Char('/'), -1);
+    return QDir(directory).filePath(name + QLatin1Char('-') + QString::number(url.port()) + QStringLiteral(".sock"));
+}
+
+QByteArray MessageSocket::frame(Opcode opcode, const QByteArray &payload)
+{
+    QByteArray data(s_headerSize, Qt::Uninitialized);
+    qToBigEndian(quint32(payload.size()), reinterpret_cast<uchar *>(data.data()));
+    data[4] = char(opcode);
+    data += payload;
+    return data;
+}
+
+void MessageSocket::open(const QUrl &url)
+{
+    close();
+    m_url = url;
+    m_readBuffer.clear();
+    m_unconnectedPending = false;
+
+    const QString path = localSocketPath(m_localSocketDirectory, url);
+    m_local = !path.isEmpty() && QFileInfo::exists(path);
+
+    if (m_local) {
+        m_localSocket->connectToServer(path);
+    } else {
+        openWebSocket();
+    }
+}
+
+void MessageSocket::openWebSocket()
+{
+    m_webSocket->open(m_url);
+}
+
+void MessageSocket::close()
+{
+    if (m_local) {
+        m_localSocket->abort();
+        m_localConnected = false;
+        // Aborted while connecting: no error follows
+        flushUnconnected();
+    }
+    m_webSocket->close();
+}
+
+void MessageSocket::flushUnconnected()
+{
+    if (m_unconnectedPending) {
+        m_unconnectedPending = false;
+        emit stateChanged(QAbstractSocket::UnconnectedState);
+    }
+}
+
+QAbstractSocket::SocketState MessageSocket::state() const
+{
+    if (m_local) {
+        return static_cast<QAbstractSocket::SocketState>(m_localSocket->state());
+    }
+    return m_webSocket->state();
+}
+
+bool MessageSocket::isLocal() const
+{
+    return m_local;
+}
+
+void MessageSocket::sendTextMessage(const QString &message)
+{
+    if (m_local) {
+        writeFrame(TextFrame, message.toUtf8());
+    } else {
+        m_webSocket->sendTextMessage(message);
+    }
+}
+
+void MessageSocket::sendBinaryMessage(const QByteArray &data)
+{
+    if (m_local) {
+        writeFrame(BinaryFrame, data);
+    } else {
+        m_webSocket->sendBinaryMessage(data);
+    }
+}
+
+void MessageSocket::ping(const QByteArray &payload)
+{
+    if (m_local) {
+        m_pingClock.start();
+        writeFrame(PingFrame, payload);
+    } else {
+        m_webSocket->ping(payload);
+    }
+}
+
+void MessageSocket::writeFrame(Opcode opcode, const QByteArray &payload)
+{
+    if (m_localSocket->state() != QLocalSocket::ConnectedState) {
+        return;
+    }
+    m_localSocket->write(frame(opcode, payload));
+}
+
+void MessageSocket::readFrames()
+{
+    m_readBuffer += m_localSocket->readAll();
+
+    int offset = 0;
+    while (m_readBuffer.size() - offset >= s_headerSize) {
+        const quint32 size = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(m_readBuffer.constData() + offset));
+        if (size > s_maxFrameSize) {
+            qWarning() << "Frame of" << size << "bytes on the local socket, closing it";
+            m_localSocket->abort();
+            emit error(QAbstractSocket::DatagramTooLargeError);
+            return;
+        }
+        if (quint32(m_readBuffer.size() - offset - s_headerSize) < size) {
+            break;
+        }
+
+        const char opcode = m_readBuffer.at(offset + 4);
+        const QByteArray payload = m_readBuffer.mid(offset + s_headerSize, size);
+        offset += s_headerSize + size;
+
+        // As on the websocket, binary messages from the server aren't used
+        if (opcode == PingFrame) {
+            writeFrame(PongFrame, payload);
+        } else if (opcode == PongFrame) {
+            emit pong(m_pingClock.isValid() ? m_pingClock.elapsed() : 0, payload);
+        } else if (opcode == TextFrame) {
+            emit textMessageReceived(QString::fromUtf8(payload));
+            // A handler may have closed the connection
+            if (!m_local || m_localSocket->state() != QLocalSocket::ConnectedState) {
+                return;
+            }
+        }
+    }
+
+    m_readBuffer.remove(0, offset);
+}
+
+#include "moc_messagesocket.cpp"
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QAbstractSocket>
+#include <QElapsedTimer>
+#include <QUrl>
+
+class QLocalSocket;
+class QWebSocket;
+
+/**
+ * A message connection to the server, with the part of the QWebSocket API the GUI uses.
+ * When the server runs on the same host and exposes a Unix socket for the url in the
+ * local socket directory, messages go through it as length prefixed frames, otherwise
+ * and if the Unix socket refuses the connection, through the websocket.
+ *
+ * Local frames are a 4 bytes big endian payload length, a 1 byte opcode (1 text, 2 binary,
+ * 9 ping, 10 pong, as the websocket ones) and the payload. A ping is answered by a pong
+ * with the same payload, on both transports.
+ */
+class MessageSocket : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Opcode {
+        TextFrame = 0x1,
+        BinaryFrame = 0x2,
+        PingFrame = 0x9,
+        PongFrame = 0xA
+    };
+
+    static const int s_headerSize = 5;
+    static const quint32 s_maxFrameSize = 64 * 1024 * 1024;
+
+    explicit MessageSocket(QObject *parent = nullptr);
+    ~MessageSocket() override;
+
+    /**
+     * Where the server puts its Unix sockets: <path>-<port>.sock, e.g. core-8181.sock
+     * for ws://0.0.0.0:8181/core. Empty disables the local transport
+     */
+    QString localSocketDirectory() const;
+    void setLocalSocketDirectory(const QString &directory);
+
+    /**
+     * @returns the Unix socket path for url, empty if url isn't on this host
+     */
+    static QString localSocketPath(const QString &directory, const QUrl &url);
+
+    /**
+     * Encodes a local frame
+     */
+    static QByteArray frame(Opcode opcode, const QByteArray &payload);
+
+    void open(const QUrl &url);
+    void close();
+
+    QAbstractSocket::SocketState state() const;
+
+    /**
+     * Whether the last open went through the Unix socket
+     */
+    bool isLocal() const;
+
+    void sendTextMessage(const QString &message);
+    void sendBinaryMessage(const QByteArray &data);
+
+    /**
+     * Pings the server on the transport in use, pong is emitted with payload when it answers
+     */
+    void ping(const QByteArray &payload = QByteArray());
+
+Q_SIGNALS:
+    void connected();
+    void disconnected();
+    void stateChanged(QAbstractSocket::SocketState state);
+    void textMessageReceived(const QString &message);
+    /**
+     * @param elapsedTime milliseconds since the last ping, as QWebSocket::pong
+     */
+    void pong(quint64 elapsedTime, const QByteArray &payload);
+    void error(QAbstractSocket::SocketError error);
+
+private:
+    void openWebSocket();
+    void flushUnconnected();
+    void writeFrame(Opcode opcode, const QByteArray &payload);
+    void readFrames();
+
+    QString m_localSocketDirectory;
+    QUrl m_url;
+    QWebSocket *m_webSocket;
+    QLocalSocket *m_localSocket;
+    QByteArray m_readBuffer;
+    QElapsedTimer m_pingClock;
+    bool m_local = false;
+    bool m_localConnected = false;
+    //the local socket went unconnected before ever connecting, announced unless it falls back
+    bool m_unconnectedPending = false;
+};
+
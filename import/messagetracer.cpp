@@ -0,0 +1,300 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "messagetracer.h"
+#include "abstractdelegate.h"
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QQuickWindow>
+#include <QDebug>
+
+// Traces whose delegates never got created are given up after this time
+static const qint64 s_maxTraceAge = 10000000000LL;
+
+static double toMsecs(qint64 nsecs)
+{
+    return nsecs / 1000000.0;
+}
+
+MessageTracer::Scope::Scope(MessageTracer *tracer, const QString &type, const QJsonValue &context, qint64 received)
+    : m_tracer(tracer),
+      m_serial(tracer->begin(type, context, received))
+{
+}
+
+MessageTracer::Scope::~Scope()
+{
+    if (m_serial) {
+        m_tracer->applied(m_serial);
+    }
+}
+
+MessageTracer::MessageTracer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MessageTracer::~MessageTracer()
+{
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+    }
+    QMutexLocker locker(&m_frameMutex);
+    qDeleteAll(m_traces);
+}
+
+qint64 MessageTracer::now()
+{
+    // A message received by a shared GuiConnection is timestamped once for all its views
+    static const QElapsedTimer s_clock = []() {
+        QElapsedTimer clock;
+        clock.start();
+        return clock;
+    }();
+    return s_clock.nsecsElapsed();
+}
+
+quint64 MessageTracer::begin(const QString &type, const QJsonValue &context, qint64 received)
+{
+    const QJsonObject contextObject = context.toObject();
+    const QString id = contextObject.value(QStringLiteral("trace_id")).toString();
+    if (id.isEmpty()) {
+        return 0;
+    }
+
+    expire();
+
+    Trace *trace = new Trace;
+    trace->serial = m_nextSerial++;
+    trace->id = id;
+    trace->type = type;
+    trace->received = received;
+    trace->parsed = now();
+    trace->receivedWall = QDateTime::currentMSecsSinceEpoch() - (trace->parsed - received) / 1000000;
+    trace->sentWall = qint64(contextObject.value(QStringLiteral("sent_at")).toDouble(-1));
+    m_traces[trace->serial] = trace;
+    m_current = trace->serial;
+
+    return trace->serial;
+}
+
+void MessageTracer::waitForDelegate(DelegateLoader *loader)
+{
+    Trace *trace = m_traces.value(m_current);
+    // Delegates already compiled, or incubated by the prefetcher, exist right away
+    if (!trace || loader->delegate()) {
+        return;
+    }
+
+    ++trace->pendingDelegates;
+    const quint64 serial = trace->serial;
+    connect(loader, &DelegateLoader::delegateCreated, this, [this, serial]() {
+        delegateReady(serial);
+    });
+}
+
+void MessageTracer::applied(quint64 serial)
+{
+    m_current = 0;
+    Trace *trace = m_traces.value(serial);
+    if (!trace) {
+        return;
+    }
+
+    trace->applied = now();
+    if (trace->pendingDelegates == 0) {
+        markReady(trace);
+    }
+}
+
+void MessageTracer::delegateReady(quint64 serial)
+{
+    Trace *trace = m_traces.value(serial);
+    if (!trace || trace->pendingDelegates == 0) {
+        return;
+    }
+
+    // Delegates created while still in the handler don't make the trace ready before it's applied
+    if (--trace->pendingDelegates == 0 && trace->applied >= 0) {
+        markReady(trace);
+    }
+}
+
+void MessageTracer::markReady(Trace *trace)
+{
+    trace->ready = now();
+
+    if (!m_window || !m_window->isExposed()) {
+        complete(trace);
+        return;
+    }
+
+    trace->queuedForFrame = true;
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_awaitingSync << trace;
+    }
+    m_window->update();
+}
+
+void MessageTracer::setWindow(QQuickWindow *window)
+{
+    if (m_window == window) {
+        return;
+    }
+
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+    }
+
+    // Traces waiting for a frame of the old window won't get one
+    QVector<Trace *> orphans;
+    {
+        QMutexLocker locker(&m_frameMutex);
+        orphans << m_awaitingSync << m_awaitingSwap << m_swapped;
+        m_awaitingSync.clear();
+        m_awaitingSwap.clear();
+        m_swapped.clear();
+    }
+    for (auto *trace : orphans) {
+        complete(trace);
+    }
+
+    m_window = window;
+    if (!m_window) {
+        return;
+    }
+
+    // Both are emitted in the render thread with the threaded render loop
+    connect(m_window, &QQuickWindow::beforeSynchronizing, this, &MessageTracer::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::frameSwapped, this, &MessageTracer::onFrameSwapped, Qt::DirectConnection);
+}
+
+void MessageTracer::onBeforeSynchronizing()
+{
+    // The GUI thread is blocked: whatever is ready now makes it into this frame
+    QMutexLocker locker(&m_frameMutex);
+    m_awaitingSwap << m_awaitingSync;
+    m_awaitingSync.clear();
+}
+
+void MessageTracer::onFrameSwapped()
+{
+    {
+        QMutexLocker locker(&m_frameMutex);
+        if (m_awaitingSwap.isEmpty()) {
+            return;
+        }
+        const qint64 swapped = now();
+        for (auto *trace : m_awaitingSwap) {
+            trace->swapped = swapped;
+        }
+        m_swapped << m_awaitingSwap;
+        m_awaitingSwap.clear();
+    }
+    QMetaObject::invokeMethod(this, "collect", Qt::QueuedConnection);
+}
+
+void MessageTracer::collect()
+{
+    QVector<Trace *> swapped;
+    {
+        QMutexLocker locker(&m_frameMutex);
+        swapped.swap(m_swapped);
+    }
+    for (auto *trace : swapped) {
+        complete(trace);
+    }
+}
+
+void MessageTracer::complete(Trace *trace)
+{
+    const qint64 end = trace->swapped >= 0 ? trace->swapped : trace->ready;
+
+    QVariantMap stages;
+    if (trace->sentWall >= 0 && trace->receivedWall >= trace->sentWall) {
+        // Only meaningful with synchronized clocks on both ends
+        stages[QStringLiteral("network")] = double(trace->receivedWall - trace->sentWall);
+    }
+    stages[QStringLiteral("parse")] = toMsecs(trace->parsed - trace->received);
+    stages[QStringLiteral("apply")] = toMsecs(trace->applied - trace->parsed);
+    stages[QStringLiteral("delegate")] = toMsecs(trace->ready - trace->applied);
+    if (trace->swapped >= 0) {
+        stages[QStringLiteral("frame")] = toMsecs(trace->swapped - trace->ready);
+    }
+    stages[QStringLiteral("client")] = toMsecs(end - trace->received);
+
+    auto &typeStats = m_stats[trace->type];
+    ++m_counts[trace->type];
+    for (auto it = stages.constBegin(); it != stages.constEnd(); ++it) {
+        StageStats &stats = typeStats[it.key()];
+        const double value = it.value().toDouble();
+        ++stats.count;
+        stats.sum += value;
+        stats.max = qMax(stats.max, value);
+        stats.last = value;
+    }
+
+    QVariantMap result;
+    result[QStringLiteral("trace_id")] = trace->id;
+    result[QStringLiteral("type")] = trace->type;
+    result[QStringLiteral("stages")] = stages;
+
+    m_traces.remove(trace->serial);
+    delete trace;
+
+    emit traceCompleted(result);
+    emit breakdownChanged();
+}
+
+void MessageTracer::expire()
+{
+    const qint64 oldest = now() - s_maxTraceAge;
+    for (auto it = m_traces.begin(); it != m_traces.end();) {
+        // Traces waiting for a frame are in the hands of the render thread
+        if (!it.value()->queuedForFrame && it.value()->received < oldest) {
+            qWarning() << "Giving up the trace" << it.value()->id << "of" << it.value()->type;
+            delete it.value();
+            it = m_traces.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QVariantMap MessageTracer::breakdown() const
+{
+    QVariantMap breakdown;
+    for (auto typeIt = m_stats.constBegin(); typeIt != m_stats.constEnd(); ++typeIt) {
+        QVariantMap stages;
+        for (auto it = typeIt.value().constBegin(); it != typeIt.value().constEnd(); ++it) {
+            stages[it.key()] = QVariantMap({
+                {QStringLiteral("mean"), it.value().sum / it.value().count},
+                {QStringLiteral("max"), it.value().max},
+                {QStringLiteral("last"), it.value().last}
+            });
+        }
+        breakdown[typeIt.key()] = QVariantMap({
+            {QStringLiteral("count"), m_counts.value(typeIt.key())},
+            {QStringLiteral("stages"), stages}
+        });
+    }
+    return breakdown;
+}
+
+#include "moc_messagetracer.cpp"
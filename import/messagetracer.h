@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonValue>
+#include <QMutex>
+#include <QPointer>
+#include <QVariantMap>
+#include <QVector>
+
+class QQuickWindow;
+class DelegateLoader;
+
+/**
+ * Follows the messages carrying a trace id in their context from the socket to the screen:
+ * received, parsed, applied to the models, delegates ready and first frame swapped after that.
+ * Completed traces are aggregated in a latency breakdown per message type.
+ * Messages without a trace id cost a clock read.
+ */
+class MessageTracer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Records the stages of one message between the construction and the destruction of the scope,
+     * for the body of a message handler with many exit points
+     */
+    class Scope
+    {
+    public:
+        Scope(MessageTracer *tracer, const QString &type, const QJsonValue &context, qint64 received);
+        ~Scope();
+
+    private:
+        MessageTracer *m_tracer;
+        quint64 m_serial;
+    };
+
+    explicit MessageTracer(QObject *parent = nullptr);
+    ~MessageTracer();
+
+    /**
+     * Nanoseconds on the clock of the traces, shared by all the tracers
+     */
+    static qint64 now();
+
+    /**
+     * The message being handled creates this delegate: the trace is ready only once it exists
+     */
+    void waitForDelegate(DelegateLoader *loader);
+
+    /**
+     * The first frame swapped by this window after a message is handled completes its trace
+     */
+    void setWindow(QQuickWindow *window);
+
+    /**
+     * Per message type: the number of traces and, for each stage, mean, max and last in milliseconds
+     */
+    QVariantMap breakdown() const;
+
+Q_SIGNALS:
+    void traceCompleted(const QVariantMap &trace);
+    void breakdownChanged();
+
+private Q_SLOTS:
+    void collect();
+
+private:
+    struct Trace {
+        quint64 serial = 0;
+        QString id;
+        QString type;
+        qint64 sentWall = -1;
+        qint64 receivedWall = -1;
+        qint64 received = -1;
+        qint64 parsed = -1;
+        qint64 applied = -1;
+        qint64 ready = -1;
+        qint64 swapped = -1;
+        int pendingDelegates = 0;
+        bool queuedForFrame = false;
+    };
+
+    struct StageStats {
+        int count = 0;
+        double sum = 0;
+        double max = 0;
+        double last = 0;
+    };
+
+    quint64 begin(const QString &type, const QJsonValue &context, qint64 received);
+    void applied(quint64 serial);
+    void delegateReady(quint64 serial);
+    void markReady(Trace *trace);
+    void complete(Trace *trace);
+    void expire();
+    void onBeforeSynchronizing();
+    void onFrameSwapped();
+
+    quint64 m_nextSerial = 1;
+    quint64 m_current = 0;
+    QHash<quint64, Trace *> m_traces;
+    QPointer<QQuickWindow> m_window;
+
+    // Shared with the render thread
+    QMutex m_frameMutex;
+    QVector<Trace *> m_awaitingSync;
+    QVector<Trace *> m_awaitingSwap;
+    QVector<Trace *> m_swapped;
+
+    // type -> stage -> stats
+    QHash<QString, QHash<QString, StageStats>> m_stats;
+    QHash<QString, int> m_counts;
+};
+
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "metricsregistry.h"
+
+#include <QDebug>
+
+static QByteArray escapeLabelValue(const QString &value)
+{
+    QByteArray escaped = value.toUtf8();
+    escaped.replace('\\', "\\\\");
+    escaped.replace('"', "\\\"");
+    escaped.replace('\n', "\\n");
+    return escaped;
+}
+
+static QByteArray formatLabels(const MetricLabels &labels, const QByteArray &extra = QByteArray())
+{
+    if (labels.isEmpty() && extra.isEmpty()) {
+        return QByteArray();
+    }
+
+    QByteArray result("{");
+    for (auto it = labels.constBegin(); it != labels.constEnd(); ++it) {
+        if (result.size() > 1) {
+            result += ',';
+        }
+        result += it.key().toUtf8() + "=\"" + escapeLabelValue(it.value()) + '"';
+    }
+    if (!extra.isEmpty()) {
+        if (result.size() > 1) {
+            result += ',';
+        }
+        result += extra;
+    }
+    result += '}';
+    return result;
+}
+
+static QByteArray formatSeconds(qint64 nsecs)
+{
+    return QByteArray::number(double(nsecs) / 1e9, 'g', 12);
+}
+
+MetricHistogram::MetricHistogram()
+    : m_buckets(new QAtomicInteger<quint64>[bounds().count() + 1])
+{
+    for (int i = 0; i <= bounds().count(); ++i) {
+        m_buckets[i].store(0);
+    }
+}
+
+const QVector<qint64> &MetricHistogram::bounds()
+{
+    static const QVector<qint64> s_bounds({
+        500000, 1000000, 2500000, 5000000, 10000000, 25000000, 50000000,
+        100000000, 250000000, 500000000, 1000000000, 2500000000
+    });
+    return s_bounds;
+}
+
+void MetricHistogram::observe(qint64 nsecs)
+{
+    const QVector<qint64> &upperBounds = bounds();
+    int bucket = 0;
+    while (bucket < upperBounds.count() && nsecs > upperBounds[bucket]) {
+        ++bucket;
+    }
+
+    m_buckets[bucket].fetchAndAddRelaxed(1);
+    m_sum.fetchAndAddRelaxed(nsecs);
+    m_count.fetchAndAddRelaxed(1);
+    m_last.store(nsecs);
+}
+
+QVector<quint64> MetricHistogram::buckets() const
+{
+    QVector<quint64> result(bounds().count() + 1);
+    for (int i = 0; i < result.count(); ++i) {
+        result[i] = m_buckets[i].load();
+    }
+    return result;
+}
+
+quint64 MetricHistogram::count() const
+{
+    return m_count.load();
+}
+
+qint64 MetricHistogram::sum() const
+{
+    return m_sum.load();
+}
+
+qint64 MetricHistogram::last() const
+{
+    return m_last.load();
+}
+
+//////////////////////////////////////////
+
+MetricsRegistry *MetricsRegistry::instance()
+{
+    // Outlives every QObject updating metrics from its destructor
+    static MetricsRegistry s_self;
+    return &s_self;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    for (const auto &family : m_families) {
+        for (const auto &series : family.series) {
+            switch (family.type) {
+            case Counter:
+                delete static_cast<MetricCounter *>(series.metric);
+                break;
+            case Gauge:
+                delete static_cast<MetricGauge *>(series.metric);
+                break;
+            case Histogram:
+                delete static_cast<MetricHistogram *>(series.metric);
+                break;
+            }
+        }
+    }
+}
+
+void *MetricsRegistry::find(const QString &name, Type type, const QString &help, const MetricLabels &labels)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_families.find(name);
+    if (it == m_families.end()) {
+        it = m_families.insert(name, Family{type, help, QVector<Series>()});
+    } else if (it.value().type != type) {
+        qWarning() << "Metric" << name << "already registered with another type";
+        return nullptr;
+    }
+
+    for (const auto &series : it.value().series) {
+        if (series.labels == labels) {
+            return series.metric;
+        }
+    }
+
+    void *metric = nullptr;
+    switch (type) {
+    case Counter:
+        metric = new MetricCounter;
+        break;
+    case Gauge:
+        metric = new MetricGauge;
+        break;
+    case Histogram:
+        metric = new MetricHistogram;
+        break;
+    }
+    it.value().series << Series{labels, metric};
+    return metric;
+}
+
+MetricCounter *MetricsRegistry::counter(const QString &name, const QString &help, const MetricLabels &labels)
+{
+    return static_cast<MetricCounter *>(find(name, Counter, help, labels));
+}
+
+MetricGauge *MetricsRegistry::gauge(const QString &name, const QString &help, const MetricLabels &labels)
+{
+    return static_cast<MetricGauge *>(find(name, Gauge, help, labels));
+}
+
+MetricHistogram *MetricsRegistry::histogram(const QString &name, const QString &help, const MetricLabels &labels)
+{
+    return static_cast<MetricHistogram *>(find(name, Histogram, help, labels));
+}
+
+const void *MetricsRegistry::lookup(const QString &name, Type type, const MetricLabels &labels) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const auto it = m_families.constFind(name);
+    if (it == m_families.constEnd() || it.value().type != type) {
+        return nullptr;
+    }
+
+    for (const auto &series : it.value().series) {
+        if (series.labels == labels) {
+            return series.metric;
+        }
+    }
+    return nullptr;
+}
+
+const MetricGauge *MetricsRegistry::findGauge(const QString &name, const MetricLabels &labels) const
+{
+    return static_cast<const MetricGauge *>(lookup(name, Gauge, labels));
+}
+
+const MetricHistogram *MetricsRegistry::findHistogram(const QString &name, const MetricLabels &labels) const
+{
+    return static_cast<const MetricHistogram *>(lookup(name, Histogram, labels));
+}
+
+QByteArray MetricsRegistry::exposition() const
+{
+    static const char *s_typeNames[] = {"counter", "gauge", "histogram"};
+
+    QMutexLocker locker(&m_mutex);
+
+    QByteArray text;
+    for (auto it = m_families.constBegin(); it != m_families.constEnd(); ++it) {
+        const QByteArray name = it.key().toUtf8();
+        const Family &family = it.value();
+
+        text += "# HELP " + name + ' ' + family.help.toUtf8() + '\n';
+        text += "# TYPE " + name + ' ' + s_typeNames[family.type] + '\n';
+
+        for (const auto &series : family.series) {
+            switch (family.type) {
+            case Counter:
+                text += name + formatLabels(series.labels) + ' '
+                    + QByteArray::number(static_cast<MetricCounter *>(series.metric)->value()) + '\n';
+                break;
+            case Gauge:
+                text += name + formatLabels(series.labels) + ' '
+                    + QByteArray::number(static_cast<MetricGauge *>(series.metric)->value()) + '\n';
+                break;
+            case Histogram: {
+                const MetricHistogram *histogram = static_cast<MetricHistogram *>(series.metric);
+                const QVector<quint64> buckets = histogram->buckets();
+                const QVector<qint64> &bounds = MetricHistogram::bounds();
+                // Read while other threads observe: only the cumulative counts are made consistent
+                quint64 cumulative = 0;
+                for (int i = 0; i < bounds.count(); ++i) {
+                    cumulative += buckets[i];
+                    text += name + "_bucket" + formatLabels(series.labels, "le=\"" + formatSeconds(bounds[i]) + '"') + ' '
+                        + QByteArray::number(cumulative) + '\n';
+                }
+                cumulative += buckets.last();
+                text += name + "_bucket" + formatLabels(series.labels, "le=\"+Inf\"") + ' ' + QByteArray::number(cumulative) + '\n';
+                text += name + "_sum" + formatLabels(series.labels) + ' ' + formatSeconds(histogram->sum()) + '\n';
+                text += name + "_count" + formatLabels(series.labels) + ' ' + QByteArray::number(cumulative) + '\n';
+                break;
+            }
+            }
+        }
+    }
+
+    return text;
+}
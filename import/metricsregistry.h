@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QScopedArrayPointer>
+#include <QString>
+#include <QVector>
+
+typedef QMap<QString, QString> MetricLabels;
+
+/**
+ * Monotonically increasing value, e.g. messages received
+ */
+class MetricCounter
+{
+public:
+    void increment(quint64 amount = 1)
+    {
+        m_value.fetchAndAddRelaxed(amount);
+    }
+
+    quint64 value() const
+    {
+        return m_value.load();
+    }
+
+private:
+    QAtomicInteger<quint64> m_value;
+};
+
+/**
+ * Value that goes up and down, e.g. live delegates
+ */
+class MetricGauge
+{
+public:
+    void set(qint64 value)
+    {
+        m_value.store(value);
+    }
+
+    void add(qint64 amount)
+    {
+        m_value.fetchAndAddRelaxed(amount);
+    }
+
+    qint64 value() const
+    {
+        return m_value.load();
+    }
+
+private:
+    QAtomicInteger<qint64> m_value;
+};
+
+/**
+ * Distribution of durations in fixed buckets, from half a millisecond to 2.5 seconds
+ */
+class MetricHistogram
+{
+public:
+    MetricHistogram();
+
+    void observe(qint64 nsecs);
+
+    /**
+     * Upper bounds of the buckets in nanoseconds, the last one (+Inf) excluded
+     */
+    static const QVector<qint64> &bounds();
+
+    /**
+     * Observations per bucket, not cumulative, with +Inf as last element
+     */
+    QVector<quint64> buckets() const;
+    quint64 count() const;
+    qint64 sum() const;
+
+    /**
+     * The most recent observation, not exported
+     */
+    qint64 last() const;
+
+private:
+    QScopedArrayPointer<QAtomicInteger<quint64>> m_buckets;
+    QAtomicInteger<quint64> m_count;
+    QAtomicInteger<qint64> m_sum;
+    QAtomicInteger<qint64> m_last;
+};
+
+/**
+ * Observes the time spent in its scope into a histogram
+ */
+class MetricTimer
+{
+public:
+    explicit MetricTimer(MetricHistogram *histogram)
+        : m_histogram(histogram)
+    {
+        m_timer.start();
+    }
+
+    ~MetricTimer()
+    {
+        m_histogram->observe(m_timer.nsecsElapsed());
+    }
+
+private:
+    MetricHistogram *m_histogram;
+    QElapsedTimer m_timer;
+};
+
+/**
+ * Process wide registry of the GUI health metrics.
+ * Updating a metric is lock free and can happen from any thread; only registering one
+ * takes a lock, so callers keep the returned pointer, which stays valid for the whole
+ * life of the process.
+ */
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry *instance();
+
+    /**
+     * @returns the metric registered with this name and labels, creating it on first use.
+     * name follows the Prometheus conventions: mycroft_gui_ prefix, _total for counters,
+     * _seconds for histograms.
+     * nullptr if the name is already registered with another type
+     */
+    MetricCounter *counter(const QString &name, const QString &help, const MetricLabels &labels = MetricLabels());
+    MetricGauge *gauge(const QString &name, const QString &help, const MetricLabels &labels = MetricLabels());
+    MetricHistogram *histogram(const QString &name, const QString &help, const MetricLabels &labels = MetricLabels());
+
+    /**
+     * Lookups for readers of metrics registered elsewhere.
+     * @returns nullptr if the metric hasn't been registered yet
+     */
+    const MetricGauge *findGauge(const QString &name, const MetricLabels &labels = MetricLabels()) const;
+    const MetricHistogram *findHistogram(const QString &name, const MetricLabels &labels = MetricLabels()) const;
+
+    /**
+     * All the metrics in the Prometheus text exposition format
+     */
+    QByteArray exposition() const;
+
+private:
+    MetricsRegistry() = default;
+    ~MetricsRegistry();
+
+    enum Type {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Series {
+        MetricLabels labels;
+        void *metric;
+    };
+
+    struct Family {
+        Type type;
+        QString help;
+        QVector<Series> series;
+    };
+
+    void *find(const QString &name, Type type, const QString &help, const MetricLabels &labels);
+    const void *lookup(const QString &name, Type type, const MetricLabels &labels) const;
+
+    mutable QMutex m_mutex;
+    QMap<QString, Family> m_families;
+};
+
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "metricsserver.h"
+#include "metricsregistry.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+// A scrape is a single small GET: anything bigger or slower is not a scraper
+static const int s_maxRequestSize = 8192;
+static const int s_requestTimeout = 5000;
+
+static void closeConnection(QIODevice *connection)
+{
+    // Both wait for the pending data to be written before closing
+    if (QLocalSocket *localSocket = qobject_cast<QLocalSocket *>(connection)) {
+        localSocket->disconnectFromServer();
+    } else if (QTcpSocket *tcpSocket = qobject_cast<QTcpSocket *>(connection)) {
+        tcpSocket->disconnectFromHost();
+    }
+}
+
+static QByteArray response(const QByteArray &status, const QByteArray &contentType, const QByteArray &body)
+{
+    return "HTTP/1.0 " + status + "\r\n"
+        "Content-Type: " + contentType + "\r\n"
+        "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+        "Connection: close\r\n"
+        "\r\n" + body;
+}
+
+MetricsServer *MetricsServer::instance()
+{
+    static MetricsServer* s_self = nullptr;
+    if (!s_self) {
+        s_self = new MetricsServer(QCoreApplication::instance());
+    }
+    return s_self;
+}
+
+static bool isSocketFile(const QString &path)
+{
+#ifdef Q_OS_UNIX
+    struct stat info;
+    return ::lstat(QFile::encodeName(path).constData(), &info) == 0 && S_ISSOCK(info.st_mode);
+#else
+    Q_UNUSED(path)
+    return false;
+#endif
+}
+
+MetricsServer::MetricsServer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool MetricsServer::listen(const QString &endpoint)
+{
+    close();
+
+    if (endpoint.isEmpty()) {
+        return true;
+    }
+
+    if (endpoint.startsWith(QLatin1Char('/')) || endpoint.startsWith(QLatin1String("unix:"))) {
+        const QString path = endpoint.startsWith(QLatin1Char('/')) ? endpoint : endpoint.mid(5);
+
+        m_localServer = new QLocalServer(this);
+        // Scraped by local agents running as other users
+        m_localServer->setSocketOptions(QLocalServer::WorldAccessOption);
+        //a stale socket of a previous run would make listen() fail, anything else at that path is not ours to delete
+        if (isSocketFile(path)) {
+            QLocalServer::removeServer(path);
+        }
+        if (!m_localServer->listen(path)) {
+            qWarning() << "Can't serve metrics on" << path << m_localServer->errorString();
+            close();
+            return false;
+        }
+        connect(m_localServer, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket *connection = m_localServer->nextPendingConnection()) {
+                connect(connection, &QLocalSocket::disconnected, connection, &QObject::deleteLater);
+                serve(connection);
+            }
+        });
+        return true;
+    }
+
+    QString portString = endpoint;
+    if (portString.startsWith(QLatin1String("localhost:"))) {
+        portString = portString.mid(10);
+    } else if (portString.startsWith(QLatin1String("127.0.0.1:"))) {
+        portString = portString.mid(10);
+    }
+
+    bool ok = false;
+    const uint port = portString.toUInt(&ok);
+    if (!ok || port > 65535) {
+        qWarning() << "Invalid metrics endpoint" << endpoint;
+        return false;
+    }
+
+    m_tcpServer = new QTcpServer(this);
+    if (!m_tcpServer->listen(QHostAddress::LocalHost, quint16(port))) {
+        qWarning() << "Can't serve metrics on port" << port << m_tcpServer->errorString();
+        close();
+        return false;
+    }
+    connect(m_tcpServer, &QTcpServer::newConnection, this, [this]() {
+        while (QTcpSocket *connection = m_tcpServer->nextPendingConnection()) {
+            connect(connection, &QTcpSocket::disconnected, connection, &QObject::deleteLater);
+            serve(connection);
+        }
+    });
+    return true;
+}
+
+void MetricsServer::close()
+{
+    delete m_localServer;
+    m_localServer = nullptr;
+    delete m_tcpServer;
+    m_tcpServer = nullptr;
+}
+
+bool MetricsServer::isListening() const
+{
+    return (m_localServer && m_localServer->isListening()) || (m_tcpServer && m_tcpServer->isListening());
+}
+
+QString MetricsServer::address() const
+{
+    if (m_localServer && m_localServer->isListening()) {
+        return QStringLiteral("unix:") + m_localServer->fullServerName();
+    }
+    if (m_tcpServer && m_tcpServer->isListening()) {
+        return m_tcpServer->serverAddress().toString() + QLatin1Char(':') + QString::number(m_tcpServer->serverPort());
+    }
+    return QString();
+}
+
+void MetricsServer::serve(QIODevice *connection)
+{
+    QTimer::singleShot(s_requestTimeout, connection, [connection]() {
+        closeConnection(connection);
+    });
+
+    connect(connection, &QIODevice::readyRead, connection, [connection]() {
+        const QByteArray request = connection->peek(s_maxRequestSize);
+        const int headerEnd = request.indexOf("\r\n\r\n");
+
+        if (headerEnd < 0) {
+            if (request.size() >= s_maxRequestSize) {
+                connection->write(response("400 Bad Request", "text/plain", QByteArray()));
+                closeConnection(connection);
+            }
+            return;
+        }
+        connection->readAll();
+        //don't answer again to anything sent after the request
+        QObject::disconnect(connection, &QIODevice::readyRead, connection, nullptr);
+
+        const QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+        if (requestLine.count() < 2 || requestLine[0] != "GET") {
+            connection->write(response("405 Method Not Allowed", "text/plain", QByteArray()));
+        } else if (requestLine[1] != "/metrics" && requestLine[1] != "/") {
+            connection->write(response("404 Not Found", "text/plain", QByteArray()));
+        } else {
+            connection->write(response("200 OK", "text/plain; version=0.0.4; charset=utf-8", MetricsRegistry::instance()->exposition()));
+        }
+        closeConnection(connection);
+    });
+}
+
+#include "moc_metricsserver.cpp"
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+
+class QIODevice;
+class QLocalServer;
+class QTcpServer;
+
+/**
+ * Serves MetricsRegistry::exposition() over HTTP at /metrics, for Prometheus to scrape.
+ * Only ever listens locally: either on a Unix socket or on the loopback interface.
+ */
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MetricsServer *instance();
+
+    /**
+     * Starts serving on endpoint, stopping any previous one:
+     * - "unix:/path" or "/path" listens on a Unix socket
+     * - "port" or "localhost:port" listens on 127.0.0.1, port 0 picks a free one
+     * - an empty string just stops serving
+     * @returns false if the endpoint can't be parsed or listened on
+     */
+    bool listen(const QString &endpoint);
+    void close();
+
+    bool isListening() const;
+
+    /**
+     * Where it is actually listening, as "unix:/path" or "127.0.0.1:port"
+     */
+    QString address() const;
+
+private:
+    explicit MetricsServer(QObject *parent = nullptr);
+
+    void serve(QIODevice *connection);
+
+    QLocalServer *m_localServer = nullptr;
+    QTcpServer *m_tcpServer = nullptr;
+};
+
@@ -21,7 +21,12 @@
 #include "abstractdelegate.h"
 #include "activeskillsmodel.h"
 #include "abstractskillview.h"
+#include "guiconnection.h"
 #include "controllerconfig.h"
+#include "connectionscheduler.h"
+#include "latencyprobe.h"
+#include "metricsserver.h"
+#include "startuptrace.h"
 
 #include <QtGlobal>
 #include <QJsonObject>
@@ -49,16 +54,35 @@ MycroftController *MycroftController::instance()
 
 MycroftController::MycroftController(QObject *parent)
     : QObject(parent),
-      m_appSettingObj(new GlobalSettings)
+      m_busBackoff(ConnectionScheduler::instance()->bus()),
+      m_announceBackoff(ConnectionScheduler::instance()->announce()),
+      m_latency(new LatencyProbe(&m_mainSocket, this)),
+      m_appSettingObj(GlobalSettings::instance())
 {
     m_qt_version_context = QStringLiteral("5");
-    connect(&m_mainWebSocket, &QWebSocket::connected, this,
+
+    // Only real transitions reach QML, the gaps between spoken chunks are hidden
+    connect(&m_speaking, &CoalescedState::valueChanged, this, &MycroftController::isSpeakingChanged);
+    connect(&m_listening, &CoalescedState::valueChanged, this, &MycroftController::isListeningChanged);
+    m_speaking.setDebounceInterval(m_appSettingObj->speakingDebounceInterval());
+    connect(m_appSettingObj, &GlobalSettings::speakingDebounceIntervalChanged, this, [this]() {
+        m_speaking.setDebounceInterval(m_appSettingObj->speakingDebounceInterval());
+    });
+    connect(&m_mainSocket, &MessageSocket::connected, this,
             [this] () {
-                m_reconnectTimer.stop();
+                StartupTrace::mark(QStringLiteral("core connected"));
+                m_busBackoff->succeeded();
                 emit socketStatusChanged();
             });
-    connect(&m_mainWebSocket, &QWebSocket::disconnected, this, &MycroftController::closed);
-    connect(&m_mainWebSocket, &QWebSocket::stateChanged, this,
+    connect(&m_mainSocket, &MessageSocket::disconnected, this, &MycroftController::closed);
+    // Core went away, e.g. restarted: reconnect right away, then back off
+    connect(&m_mainSocket, &MessageSocket::disconnected, this, [this]() {
+        if (m_autoReconnect) {
+            m_busBackoff->schedule();
+            emit socketStatusChanged();
+        }
+    });
+    connect(&m_mainSocket, &MessageSocket::stateChanged, this,
             [this] (QAbstractSocket::SocketState state) {
                 emit socketStatusChanged();
                 if (state == QAbstractSocket::ConnectedState) {
@@ -69,15 +93,13 @@ MycroftController::MycroftController(QObject *parent)
                         m_qt_version_context = QStringLiteral("5");
                     #endif
 
-                    for (const auto &guiId : m_views.keys()) {
-                        sendRequest(QStringLiteral("mycroft.gui.connected"),
-                                    QVariantMap({{QStringLiteral("gui_id"), guiId}}),
-                                    QVariantMap({{QStringLiteral("qt_version"), m_qt_version_context}}));
-                    }
-                    m_reannounceGuiTimer.start();
+                    // The GUIs get announced right away, then again with backoff until a port arrives
+                    m_announceBackoff->cancel();
+                    m_announceBackoff->schedule();
 
                     sendRequest(QStringLiteral("mycroft.skills.all_loaded"), QVariantMap());
                 } else {
+                    m_announceBackoff->cancel();
                     if (m_serverReady) {
                         m_serverReady = false;
                         emit serverReadyChanged();
@@ -85,64 +107,112 @@ MycroftController::MycroftController(QObject *parent)
                 }
             });
 
-    connect(&m_mainWebSocket, &QWebSocket::textMessageReceived, this, &MycroftController::onMainSocketMessageReceived);
+    connect(&m_mainSocket, &MessageSocket::textMessageReceived, this, &MycroftController::onMainSocketMessageReceived);
 
-    m_reconnectTimer.setInterval(1000);
-    connect(&m_reconnectTimer, &QTimer::timeout, this, [this]() {
-        QString socket = m_appSettingObj->webSocketAddress() + QStringLiteral(":8181/core");
-        m_mainWebSocket.open(QUrl(socket));
-    });
+    connect(&m_mainSocket, &MessageSocket::error,
+            this, [this] (const QAbstractSocket::SocketError &error) {
+        //qDebug() << error;
+
+        if (error != QAbstractSocket::HostNotFoundError && error != QAbstractSocket::ConnectionRefusedError) {
+            qWarning() << "Mycroft is running but the connection failed for some reason. Kill Mycroft manually.";
 
-    m_reannounceGuiTimer.setInterval(10000);
-    connect(&m_reannounceGuiTimer, &QTimer::timeout, this, [this]() {
-        if (m_mainWebSocket.state() != QAbstractSocket::ConnectedState) {
             return;
         }
-        for (const auto &guiId : m_views.keys()) {
-            if (m_views[guiId]->status() != Open) {
+
+        if (m_autoReconnect) {
+            m_busBackoff->schedule();
+        }
+        emit socketStatusChanged();
+    });
+
+    connect(m_busBackoff, &ReconnectBackoff::retry, this, [this]() {
+        QString socket = m_appSettingObj->webSocketAddress() + QStringLiteral(":8181/core");
+        m_mainSocket.setLocalSocketDirectory(m_appSettingObj->localSocketDirectory());
+        m_mainSocket.open(QUrl(socket));
+    });
+
+    connect(m_announceBackoff, &ReconnectBackoff::retry, this, &MycroftController::announceConnections);
+    connect(ConnectionScheduler::instance(), &ConnectionScheduler::metricsChanged, this, &MycroftController::reconnectMetricsChanged);
+
+    // Nothing listens unless an endpoint is configured
+    MetricsServer::instance()->listen(m_appSettingObj->metricsEndpoint());
+    connect(m_appSettingObj, &GlobalSettings::metricsEndpointChanged, this, [this]() {
+        MetricsServer::instance()->listen(m_appSettingObj->metricsEndpoint());
+    });
+}
+
+void MycroftController::announceConnections()
+{
+    if (m_mainSocket.state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    bool announced = false;
+    for (const auto &guiId : m_connections.keys()) {
+        if (m_connections[guiId]->status() != Open) {
+            if (m_announceBackoff->attempts() > 1) {
                 qWarning()<<"Retrying to announce gui";
-                sendRequest(QStringLiteral("mycroft.gui.connected"),
-                            QVariantMap({{QStringLiteral("gui_id"), guiId}}), QVariantMap({{QStringLiteral("qt_version"), m_qt_version_context}}));
             }
+            sendRequest(QStringLiteral("mycroft.gui.connected"),
+                        QVariantMap({{QStringLiteral("gui_id"), guiId}}), QVariantMap({{QStringLiteral("qt_version"), m_qt_version_context}}));
+            announced = true;
         }
-    });
+    }
+
+    if (announced) {
+        m_announceBackoff->schedule();
+    } else {
+        m_announceBackoff->succeeded();
+    }
 }
 
+void MycroftController::reannounceConnections()
+{
+    // Goes through the scheduler, so that many failing GUI sockets make a single announcement
+    m_announceBackoff->schedule();
+}
 
-void MycroftController::start()
+LatencyProbe *MycroftController::latency() const
 {
-    //auto appSettingObj = new GlobalSettings;
-    QString socket = m_appSettingObj->webSocketAddress() + QStringLiteral(":8181/core");
-    m_mainWebSocket.open(QUrl(socket));
-    connect(&m_mainWebSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error),
-            this, [this] (const QAbstractSocket::SocketError &error) {
-        //qDebug() << error;
+    return m_latency;
+}
 
-        if (error != QAbstractSocket::HostNotFoundError && error != QAbstractSocket::ConnectionRefusedError) {
-            qWarning() << "Mycroft is running but the connection failed for some reason. Kill Mycroft manually.";
+QVariantMap MycroftController::reconnectMetrics() const
+{
+    return ConnectionScheduler::instance()->metrics();
+}
 
-            return;
-        }
 
-        m_reconnectTimer.start();
-        emit socketStatusChanged();
-    });
+void MycroftController::start()
+{
+    m_autoReconnect = true;
+    //Already connecting, the scheduler decides when to try again
+    if (m_busBackoff->isPending() || m_mainSocket.state() != QAbstractSocket::UnconnectedState) {
+        return;
+    }
+
+    //auto appSettingObj = new GlobalSettings;
+    QString socket = m_appSettingObj->webSocketAddress() + QStringLiteral(":8181/core");
+    m_mainSocket.setLocalSocketDirectory(m_appSettingObj->localSocketDirectory());
+    m_mainSocket.open(QUrl(socket));
     emit socketStatusChanged();
 }
 
 void MycroftController::disconnectSocket()
 {
     qDebug() << "in reconnect";
-    m_mainWebSocket.close();
-    m_reconnectTimer.stop();
+    m_autoReconnect = false;
+    m_mainSocket.close();
+    m_busBackoff->cancel();
     emit socketStatusChanged();
 }
 
 void MycroftController::reconnect()
 {
     qDebug() << "in reconnect";
-    m_mainWebSocket.close();
-    m_reconnectTimer.start();
+    m_autoReconnect = true;
+    m_mainSocket.close();
+    m_busBackoff->schedule();
     emit socketStatusChanged();
 }
 
@@ -170,33 +240,23 @@ void MycroftController::onMainSocketMessageReceived(const QString &message)
 
     // Instead of intent_failure which is handled by fallback skills, use complete_intent_failure where all skills failed to parse intent
     if (type == QLatin1String("complete_intent_failure")) {
-        m_isListening = false;
-        emit isListeningChanged();
+        m_listening.setValue(false);
         emit notUnderstood();
     }
     if (type == QLatin1String("recognizer_loop:audio_output_start")) {
-        m_isSpeaking = true;
-        emit isSpeakingChanged();
+        m_speaking.setValue(true);
         return;
     }
     if (type == QLatin1String("recognizer_loop:audio_output_end")) {
-        m_isSpeaking = false;
-        emit isSpeakingChanged();
-        return;
-    }
-    if (type == QLatin1String("recognizer_loop:wakeword")) {
-        m_isListening = true;
-        emit isListeningChanged();
+        m_speaking.setValue(false);
         return;
     }
-    if (type == QLatin1String("recognizer_loop:record_begin") && !m_isListening) {
-        m_isListening = true;
-        emit isListeningChanged();
+    if (type == QLatin1String("recognizer_loop:wakeword") || type == QLatin1String("recognizer_loop:record_begin")) {
+        m_listening.setValue(true);
         return;
     }
     if (type == QLatin1String("recognizer_loop:record_end")) {
-        m_isListening = false;
-        emit isListeningChanged();
+        m_listening.setValue(false);
         return;
     }
     if (type == QLatin1String("mycroft.speech.recognition.unknown")) {
@@ -225,14 +285,14 @@ void MycroftController::onMainSocketMessageReceived(const QString &message)
         }
 
         qWarning() << "Received port" << port << "for gui" << guiId;
-        if (!m_views.contains(guiId)) {
+        if (!m_connections.contains(guiId)) {
             qWarning() << "Unknown guiId from mycroft.gui.port";
             return;
         }
 
         QUrl url(QStringLiteral("%1:%2/gui").arg(m_appSettingObj->webSocketAddress()).arg(port));
-        m_views[guiId]->setUrl(url);
-        m_reannounceGuiTimer.stop();
+        m_connections[guiId]->setUrl(url);
+        m_announceBackoff->succeeded();
     } else if (type == QLatin1String("mycroft.skills.all_loaded.response")) {
         if (doc[QStringLiteral("data")][QStringLiteral("status")].toBool() == true) {
             m_serverReady = true;
@@ -262,7 +322,7 @@ void MycroftController::onMainSocketMessageReceived(const QString &message)
 
 void MycroftController::sendRequest(const QString &type, const QVariantMap &data, const QVariantMap &context)
 {
-    if (m_mainWebSocket.state() != QAbstractSocket::ConnectedState) {
+    if (m_mainSocket.state() != QAbstractSocket::ConnectedState) {
         qWarning() << "mycroft connection not open!";
         return;
     }
@@ -282,12 +342,12 @@ void MycroftController::sendRequest(const QString &type, const QVariantMap &data
     root[QStringLiteral("context")] = contextJson;
 
     QJsonDocument doc(root);
-    m_mainWebSocket.sendTextMessage(QString::fromUtf8(doc.toJson()));
+    m_mainSocket.sendTextMessage(QString::fromUtf8(doc.toJson()));
 }
 
 void MycroftController::sendBinary(const QString &type, const QJsonObject &data, const QVariantMap &context)
 {
-    if (m_mainWebSocket.state() != QAbstractSocket::ConnectedState) {
+    if (m_mainSocket.state() != QAbstractSocket::ConnectedState) {
         qWarning() << "mycroft connection not open!";
         return;
     }
@@ -299,7 +359,7 @@ void MycroftController::sendBinary(const QString &type, const QJsonObject &data,
     QJsonDocument doc;
     doc.setObject(socketObject);
     QByteArray docbin = doc.toJson(QJsonDocument::Compact);
-    m_mainWebSocket.sendBinaryMessage(docbin);
+    m_mainSocket.sendBinaryMessage(docbin);
 }
 
 void MycroftController::sendText(const QString &message)
@@ -307,25 +367,29 @@ void MycroftController::sendText(const QString &message)
     sendRequest(QStringLiteral("recognizer_loop:utterance"), QVariantMap({{QStringLiteral("utterances"), QStringList({message})}}), QVariantMap({{QStringLiteral("source"), QStringLiteral("mycroft-gui")}, {QStringLiteral("destination"), QStringLiteral("skills")}, {QStringLiteral("qt_version"), m_qt_version_context}}));
 }
 
-void MycroftController::registerView(AbstractSkillView *view)
+void MycroftController::registerConnection(GuiConnection *connection)
 {
-    Q_ASSERT(!view->id().isEmpty());
-    Q_ASSERT(!m_views.contains(view->id()));
-    m_views[view->id()] = view;
-//TODO: manage view destruction
-    if (m_mainWebSocket.state() == QAbstractSocket::ConnectedState) {
+    Q_ASSERT(!connection->id().isEmpty());
+    Q_ASSERT(!m_connections.contains(connection->id()));
+    m_connections[connection->id()] = connection;
+    if (m_mainSocket.state() == QAbstractSocket::ConnectedState) {
         sendRequest(QStringLiteral("mycroft.gui.connected"),
-                    QVariantMap({{QStringLiteral("gui_id"), view->id()}}), QVariantMap({{QStringLiteral("qt_version"), m_qt_version_context}}));
+                    QVariantMap({{QStringLiteral("gui_id"), connection->id()}}), QVariantMap({{QStringLiteral("qt_version"), m_qt_version_context}}));
     }
 }
 
+void MycroftController::unregisterConnection(GuiConnection *connection)
+{
+    m_connections.remove(connection->id());
+}
+
 MycroftController::Status MycroftController::status() const
 {
-    if (m_reconnectTimer.isActive()) {
+    if (m_busBackoff->isPending()) {
         return Connecting;
     }
 
-    switch(m_mainWebSocket.state())
+    switch(m_mainSocket.state())
     {
     case QAbstractSocket::ConnectingState:
     case QAbstractSocket::BoundState:
@@ -355,12 +419,12 @@ QString MycroftController::currentIntent() const
 
 bool MycroftController::isSpeaking() const
 {
-    return m_isSpeaking;
+    return m_speaking.value();
 }
 
 bool MycroftController::isListening() const
 {
-    return m_isListening;
+    return m_listening.value();
 }
 
 bool MycroftController::serverReady() const
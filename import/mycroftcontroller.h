@@ -24,10 +24,15 @@
 #include <QQuickItem>
 #include <QTimer>
 
+#include "coalescedstate.h"
+#include "messagesocket.h"
+
 class GlobalSettings;
 class QQmlPropertyMap;
 class ActiveSkillsModel;
-class AbstractSkillView;
+class GuiConnection;
+class ReconnectBackoff;
+class LatencyProbe;
 
 class MycroftController : public QObject
 {
@@ -42,6 +47,17 @@ class MycroftController : public QObject
 
     Q_PROPERTY(bool serverReady READ serverReady NOTIFY serverReadyChanged)
 
+    /**
+     * Reconnect timeline of the bus, the GUI announcement and every GUI socket, keyed by name:
+     * attempts, outages, last and longest outage and the most recent events, times in milliseconds
+     */
+    Q_PROPERTY(QVariantMap reconnectMetrics READ reconnectMetrics NOTIFY reconnectMetricsChanged)
+
+    /**
+     * Round trip times of the bus connection
+     */
+    Q_PROPERTY(LatencyProbe *latency READ latency CONSTANT)
+
     Q_ENUMS(Status)
 public:
     enum Status {
@@ -59,9 +75,19 @@ public:
     Status status() const;
     QString currentSkill() const;
     QString currentIntent() const;
+    QVariantMap reconnectMetrics() const;
+    LatencyProbe *latency() const;
 
     //Public API NOT to be used with QML
-    void registerView(AbstractSkillView *view);
+    /**
+     * Announces a GUI connection to the server, which answers with its port
+     */
+    void registerConnection(GuiConnection *connection);
+    void unregisterConnection(GuiConnection *connection);
+    /**
+     * A GUI socket keeps failing, its port may be stale: announce the GUIs which aren't connected again
+     */
+    void reannounceConnections();
 
 Q_SIGNALS:
     //socket stuff
@@ -76,6 +102,7 @@ Q_SIGNALS:
     void currentSkillChanged();
     void currentIntentChanged();
     void serverReadyChanged();
+    void reconnectMetricsChanged();
 
     //signal with nearly all data
     //TODO: remove?
@@ -100,11 +127,14 @@ public Q_SLOTS:
 private:
     explicit MycroftController(QObject *parent = nullptr);
     void onMainSocketMessageReceived(const QString &message);
+    void announceConnections();
 
-    QWebSocket m_mainWebSocket;
+    MessageSocket m_mainSocket;
 
-    QTimer m_reconnectTimer;
-    QTimer m_reannounceGuiTimer;
+    ReconnectBackoff *m_busBackoff;
+    ReconnectBackoff *m_announceBackoff;
+    LatencyProbe *m_latency;
+    bool m_autoReconnect = false;
 
     GlobalSettings *m_appSettingObj;
 
@@ -112,13 +142,13 @@ private:
     QString m_currentSkill;
     QString m_currentIntent;
 
-    QHash<QString, AbstractSkillView *> m_views;
+    QHash<QString, GuiConnection *> m_connections;
 
     QHash<QString, QQmlPropertyMap*> m_skillData;
 
     QString m_qt_version_context;
-    bool m_isSpeaking = false;
-    bool m_isListening = false;
+    CoalescedState m_speaking;
+    CoalescedState m_listening;
     bool m_mycroftLaunched = false;
     bool m_serverReady = false;
 };
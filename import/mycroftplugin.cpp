@@ -28,6 +28,13 @@
 #include "delegatesmodel.h"
 #include "sessiondatamap.h"
 #include "mediaservice.h"
+#include "capturemeter.h"
+#include "spectrumitem.h"
+#include "performancehud.h"
+#include "latencyprobe.h"
+#include "blobstore.h"
+#include "scaledimageprovider.h"
+#include "startuptrace.h"
 
 #include <QQmlEngine>
 #include <QQmlContext>
@@ -43,10 +50,11 @@ static QObject *fileReaderSingletonProvider(QQmlEngine *engine, QJSEngine *scrip
 
 static QObject *globalSettingsSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
 {
-    Q_UNUSED(engine)
     Q_UNUSED(scriptEngine)
 
-    return new GlobalSettings;
+    //shared with the C++ side, qml should never delete it
+    engine->setObjectOwnership(GlobalSettings::instance(), QQmlEngine::CppOwnership);
+    return GlobalSettings::instance();
 }
 
 static QObject *mycroftControllerSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
@@ -66,18 +74,30 @@ static QObject *mediaServiceSingletonProvider(QQmlEngine *engine, QJSEngine *scr
     return new MediaService;
 }
 
+static QObject *captureMeterSingletonProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(engine)
+    Q_UNUSED(scriptEngine)
+
+    return new CaptureMeter;
+}
+
 void MycroftPlugin::registerTypes(const char *uri)
 {
     Q_ASSERT(QLatin1String(uri) == QLatin1String("Mycroft"));
+    StartupTrace::begin(QStringLiteral("Mycroft registerTypes"));
 
     qmlRegisterSingletonType<MycroftController>(uri, 1, 0, "MycroftController", mycroftControllerSingletonProvider);
     qmlRegisterSingletonType<GlobalSettings>(uri, 1, 0, "GlobalSettings", globalSettingsSingletonProvider);
     qmlRegisterSingletonType<FileReader>(uri, 1, 0, "FileReader", fileReaderSingletonProvider);
     qmlRegisterSingletonType<MediaService>(uri, 1, 0, "MediaService", mediaServiceSingletonProvider);
+    qmlRegisterSingletonType<CaptureMeter>(uri, 1, 0, "CaptureMeter", captureMeterSingletonProvider);
     qmlRegisterSingletonType(QUrl(QStringLiteral("qrc:/qml/Units.qml")), uri, 1, 0, "Units");
     qmlRegisterSingletonType(QUrl(QStringLiteral("qrc:/qml/SoundEffects.qml")), uri, 1, 0, "SoundEffects");
     qmlRegisterType<AbstractSkillView>(uri, 1, 0, "AbstractSkillView");
     qmlRegisterType<AbstractDelegate>(uri, 1, 0, "AbstractDelegate");
+    qmlRegisterType<SpectrumItem>(uri, 1, 0, "SpectrumItem");
+    qmlRegisterType<PerformanceHud>(uri, 1, 0, "PerformanceHud");
     qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AudioPlayer.qml")), uri, 1, 0, "AudioPlayer");
     qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/AutoFitLabel.qml")), uri, 1, 0, "AutoFitLabel");
     qmlRegisterType(QUrl(QStringLiteral("qrc:/qml/Delegate.qml")), uri, 1, 0, "Delegate");
@@ -97,9 +117,21 @@ void MycroftPlugin::registerTypes(const char *uri)
     qmlRegisterUncreatableType<ActiveSkillsModel>(uri, 1, 0, "ActiveSkillsModel", QStringLiteral("You cannot instantiate items of type ActiveSkillsModel"));
     qmlRegisterUncreatableType<DelegatesModel>(uri, 1, 0, "DelegatesModel", QStringLiteral("You cannot instantiate items of type DelegatesModel"));
     qmlRegisterUncreatableType<SessionDataMap>(uri, 1, 0, "SessionDataMap", QStringLiteral("You cannot instantiate items of type SessionDataMap"));
+    qmlRegisterUncreatableType<LatencyProbe>(uri, 1, 0, "LatencyProbe", QStringLiteral("You cannot instantiate items of type LatencyProbe"));
 
     //use this only when all qml files are registered by the plugin
    // qmlProtectModule(uri, 1);
+
+    StartupTrace::end(QStringLiteral("Mycroft registerTypes"));
+}
+
+void MycroftPlugin::initializeEngine(QQmlEngine *engine, const char *uri)
+{
+    Q_UNUSED(uri)
+
+    StartupTrace::mark(QStringLiteral("Mycroft initializeEngine"));
+    engine->addImageProvider(QStringLiteral("mycroftblob"), new BlobImageProvider);
+    engine->addImageProvider(QStringLiteral("mycroftscaled"), new ScaledImageProvider);
 }
 
 #include "moc_mycroftplugin.cpp"
@@ -32,6 +32,7 @@ class MycroftPlugin : public QQmlExtensionPlugin
 
 public:
     void registerTypes(const char *uri) override;
+    void initializeEngine(QQmlEngine *engine, const char *uri) override;
 };
 
 #endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "pageprefetcher.h"
+#include "abstractdelegate.h"
+#include "abstractskillview.h"
+#include "metricsregistry.h"
+
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlIncubator>
+#include <QDebug>
+
+// Prefetched pages nobody asked for are dropped after this time, not to pin memory forever
+static const int s_maxPrefetchAge = 60000;
+
+static QString entryKey(const QString &skillId, const QUrl &url)
+{
+    return skillId + QLatin1Char('|') + url.toString();
+}
+
+static MetricGauge *incubatingDelegates()
+{
+    static MetricGauge *s_gauge = MetricsRegistry::instance()->gauge(QStringLiteral("mycroft_gui_delegates_incubating"),
+                                                                     QStringLiteral("Prefetched skill delegates being incubated"));
+    return s_gauge;
+}
+
+class DelegateIncubator : public QQmlIncubator
+{
+public:
+    DelegateIncubator(const QString &skillId, const QUrl &url, AbstractSkillView *view)
+        : QQmlIncubator(QQmlIncubator::Asynchronous),
+          m_skillId(skillId),
+          m_url(url),
+          m_view(view)
+    {
+        incubatingDelegates()->add(1);
+    }
+
+    ~DelegateIncubator()
+    {
+        if (m_incubating) {
+            incubatingDelegates()->add(-1);
+        }
+    }
+
+protected:
+    void statusChanged(Status status) override
+    {
+        // Ready, Error, or Null once cleared
+        if (m_incubating && status != QQmlIncubator::Loading) {
+            m_incubating = false;
+            incubatingDelegates()->add(-1);
+        }
+    }
+
+    // Same initialization DelegateLoader does between beginCreate and completeCreate
+    void setInitialState(QObject *object) override
+    {
+        AbstractDelegate *delegate = qobject_cast<AbstractDelegate *>(object);
+        if (!delegate) {
+            return;
+        }
+        delegate->setSkillId(m_skillId);
+        delegate->setQmlUrl(m_url);
+        delegate->setSkillView(m_view);
+        delegate->setSessionData(m_view->sessionDataForSkill(m_skillId));
+    }
+
+private:
+    QString m_skillId;
+    QUrl m_url;
+    AbstractSkillView *m_view;
+    bool m_incubating = true;
+};
+
+PagePrefetcher::PagePrefetcher(AbstractSkillView *view)
+    : QObject(view),
+      m_view(view)
+{
+    m_expireTimer.setInterval(s_maxPrefetchAge / 2);
+    connect(&m_expireTimer, &QTimer::timeout, this, [this]() {
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (it.value()->age.elapsed() > s_maxPrefetchAge) {
+                deleteEntry(it.value());
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (m_entries.isEmpty()) {
+            m_expireTimer.stop();
+        }
+    });
+}
+
+PagePrefetcher::~PagePrefetcher()
+{
+    for (auto *entry : m_entries) {
+        deleteEntry(entry);
+    }
+}
+
+void PagePrefetcher::prefetch(const QString &skillId, const QUrl &url, bool incubate)
+{
+    const QString key = entryKey(skillId, url);
+    if (m_entries.contains(key)) {
+        return;
+    }
+
+    QQmlEngine *engine = qmlEngine(m_view);
+    if (!engine) {
+        return;
+    }
+
+    // Incubated pages need the session data, which exists only for active skills
+    incubate = incubate && m_view->sessionDataForSkill(skillId);
+
+    Entry *entry = new Entry;
+    entry->skillId = skillId;
+    entry->incubate = incubate;
+    entry->age.start();
+    // Asynchronous compilation happens in the QML type loader thread
+    entry->component = new QQmlComponent(engine, url, QQmlComponent::Asynchronous, this);
+    m_entries[key] = entry;
+
+    if (entry->component->isLoading()) {
+        connect(entry->component, &QQmlComponent::statusChanged, this, [this, entry](QQmlComponent::Status status) {
+            if (status == QQmlComponent::Ready) {
+                startIncubation(entry);
+            } else if (status == QQmlComponent::Error) {
+                qWarning() << "ERROR Prefetching QML file" << entry->component->url() << entry->component->errors();
+            }
+        });
+    } else {
+        startIncubation(entry);
+    }
+
+    if (!m_expireTimer.isActive()) {
+        m_expireTimer.start();
+    }
+}
+
+void PagePrefetcher::startIncubation(Entry *entry)
+{
+    if (!entry->incubate || entry->incubator || !entry->component->isReady()) {
+        return;
+    }
+
+    QQmlContext *context = QQmlEngine::contextForObject(m_view);
+    if (!context) {
+        return;
+    }
+
+    entry->incubator = new DelegateIncubator(entry->skillId, entry->component->url(), m_view);
+    entry->component->create(*entry->incubator, context);
+}
+
+AbstractDelegate *PagePrefetcher::take(const QString &skillId, const QUrl &url)
+{
+    Entry *entry = m_entries.take(entryKey(skillId, url));
+
+    if (!entry) {
+        ++m_misses;
+        emit statsChanged();
+        return nullptr;
+    }
+
+    ++m_hits;
+    emit statsChanged();
+
+    AbstractDelegate *delegate = nullptr;
+    if (entry->incubator) {
+        if (entry->incubator->isLoading()) {
+            entry->incubator->forceCompletion();
+        }
+        if (entry->incubator->isReady()) {
+            delegate = qobject_cast<AbstractDelegate *>(entry->incubator->object());
+            if (!delegate) {
+                qWarning() << "ERROR: QML gui" << entry->incubator->object() << "not a Mycroft.AbstractDelegate instance";
+                entry->incubator->object()->deleteLater();
+            }
+        }
+    }
+
+    // The compiled type stays in the engine cache, referenced by the component of the DelegateLoader
+    entry->component->disconnect(this);
+    entry->component->deleteLater();
+    delete entry->incubator;
+    delete entry;
+
+    return delegate;
+}
+
+void PagePrefetcher::discardSkill(const QString &skillId)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.value()->skillId == skillId) {
+            deleteEntry(it.value());
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PagePrefetcher::deleteEntry(Entry *entry)
+{
+    if (entry->incubator) {
+        if (entry->incubator->isReady() && entry->incubator->object()) {
+            entry->incubator->object()->deleteLater();
+        }
+        //clearing a loading incubator cancels it and deletes the partially created object
+        entry->incubator->clear();
+        delete entry->incubator;
+    }
+    entry->component->disconnect(this);
+    entry->component->deleteLater();
+    delete entry;
+}
+
+int PagePrefetcher::hits() const
+{
+    return m_hits;
+}
+
+int PagePrefetcher::misses() const
+{
+    return m_misses;
+}
+
+#include "moc_pageprefetcher.cpp"
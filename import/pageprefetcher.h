@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QTimer>
+
+class QQmlComponent;
+class AbstractSkillView;
+class AbstractDelegate;
+class DelegateIncubator;
+
+/**
+ * Compiles, and optionally incubates, the pages announced by mycroft.gui.prefetch,
+ * so that when the matching mycroft.gui.list.insert arrives the page can be shown right away.
+ * Prefetched pages are never part of a DelegatesModel until they are taken by a DelegateLoader.
+ */
+class PagePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PagePrefetcher(AbstractSkillView *view);
+    ~PagePrefetcher();
+
+    /**
+     * Starts compiling url in the background. If incubate is true the page is also
+     * instantiated using the idle time of the engine incubation controller
+     */
+    void prefetch(const QString &skillId, const QUrl &url, bool incubate);
+
+    /**
+     * Called for every page about to be inserted: accounts a hit if the page was prefetched,
+     * a miss otherwise.
+     * @returns the already instantiated delegate if it was incubated, nullptr otherwise
+     */
+    AbstractDelegate *take(const QString &skillId, const QUrl &url);
+
+    /**
+     * Drops everything prefetched for a skill which is not active anymore
+     */
+    void discardSkill(const QString &skillId);
+
+    int hits() const;
+    int misses() const;
+
+Q_SIGNALS:
+    void statsChanged();
+
+private:
+    struct Entry {
+        QString skillId;
+        QQmlComponent *component = nullptr;
+        DelegateIncubator *incubator = nullptr;
+        bool incubate = false;
+        QElapsedTimer age;
+    };
+
+    void startIncubation(Entry *entry);
+    void deleteEntry(Entry *entry);
+
+    AbstractSkillView *m_view;
+    //keyed by skill id and url
+    QHash<QString, Entry *> m_entries;
+    QTimer m_expireTimer;
+    int m_hits = 0;
+    int m_misses = 0;
+};
+
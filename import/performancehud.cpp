@@ -0,0 +1,340 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "performancehud.h"
+#include "metricsregistry.h"
+
+#include <QFile>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGSimpleRectNode>
+#include <QSGSimpleTextureNode>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+static const int s_refreshInterval = 500;
+// Frame times kept for the graph
+static const int s_graphSamples = 120;
+static const qreal s_graphHeight = 40;
+// Frame time at the top of the graph, in ms: two frames at 60Hz
+static const float s_graphRange = 33.3f;
+static const qreal s_padding = 4;
+
+static qint64 readResidentMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    //size resident shared text lib data dt, in pages
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.count() < 2) {
+        return -1;
+    }
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+static QSGGeometryNode *createGeometryNode(QSGGeometry::DrawingMode mode, const QColor &color)
+{
+    QSGGeometryNode *node = new QSGGeometryNode;
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+    geometry->setLineWidth(1);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    QSGFlatColorMaterial *material = new QSGFlatColorMaterial;
+    material->setColor(color);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    return node;
+}
+
+PerformanceHud::PerformanceHud(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+
+    m_refreshTimer.setInterval(s_refreshInterval);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PerformanceHud::refresh);
+}
+
+PerformanceHud::~PerformanceHud()
+{
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+    }
+    // Waits for a render thread handler still running
+    QMutexLocker locker(&m_frameMutex);
+}
+
+qreal PerformanceHud::frameTime() const
+{
+    return m_frameTime;
+}
+
+qreal PerformanceHud::framesPerSecond() const
+{
+    return m_framesPerSecond;
+}
+
+int PerformanceHud::pendingDelegates() const
+{
+    return m_pendingDelegates;
+}
+
+int PerformanceHud::incubatingDelegates() const
+{
+    return m_incubatingDelegates;
+}
+
+int PerformanceHud::socketBacklog() const
+{
+    return m_socketBacklog;
+}
+
+qreal PerformanceHud::lastApplyTime() const
+{
+    return m_lastApplyTime;
+}
+
+qint64 PerformanceHud::residentMemory() const
+{
+    return m_residentMemory;
+}
+
+void PerformanceHud::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange || change == ItemVisibleHasChanged) {
+        updateSampling();
+    }
+
+    QQuickItem::itemChange(change, value);
+}
+
+void PerformanceHud::updateSampling()
+{
+    QQuickWindow *window = isVisible() ? this->window() : nullptr;
+    if (m_window == window) {
+        return;
+    }
+
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+    }
+
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_frameStart = -1;
+        m_frameTimes.clear();
+        m_frameTimeSum = 0;
+        m_renderedFrames = 0;
+        m_swaps = 0;
+    }
+
+    m_window = window;
+    if (!m_window) {
+        m_refreshTimer.stop();
+        return;
+    }
+
+    m_frameClock.start();
+    // All emitted in the render thread with the threaded render loop
+    connect(m_window, &QQuickWindow::beforeSynchronizing, this, &PerformanceHud::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::afterRendering, this, &PerformanceHud::onAfterRendering, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::frameSwapped, this, &PerformanceHud::onFrameSwapped, Qt::DirectConnection);
+
+    m_refreshClock.start();
+    m_refreshTimer.start();
+    refresh();
+}
+
+void PerformanceHud::onBeforeSynchronizing()
+{
+    QMutexLocker locker(&m_frameMutex);
+    m_frameStart = m_frameClock.nsecsElapsed();
+}
+
+void PerformanceHud::onAfterRendering()
+{
+    QMutexLocker locker(&m_frameMutex);
+    if (m_frameStart < 0) {
+        return;
+    }
+
+    const float frameTime = float(m_frameClock.nsecsElapsed() - m_frameStart) / 1000000;
+    m_frameStart = -1;
+    if (m_frameTimes.count() == s_graphSamples) {
+        m_frameTimes.removeFirst();
+    }
+    m_frameTimes << frameTime;
+    m_frameTimeSum += frameTime;
+    ++m_renderedFrames;
+}
+
+void PerformanceHud::onFrameSwapped()
+{
+    QMutexLocker locker(&m_frameMutex);
+    ++m_swaps;
+}
+
+void PerformanceHud::refresh()
+{
+    MetricsRegistry *registry = MetricsRegistry::instance();
+    // Registered by their owners on first use
+    if (!m_pendingGauge) {
+        m_pendingGauge = registry->findGauge(QStringLiteral("mycroft_gui_delegates_pending"));
+    }
+    if (!m_incubatingGauge) {
+        m_incubatingGauge = registry->findGauge(QStringLiteral("mycroft_gui_delegates_incubating"));
+    }
+    if (!m_backlogGauge) {
+        m_backlogGauge = registry->findGauge(QStringLiteral("mycroft_gui_socket_backlog"));
+    }
+    if (!m_applyHistogram) {
+        m_applyHistogram = registry->findHistogram(QStringLiteral("mycroft_gui_message_apply_seconds"));
+    }
+
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_frameTime = m_renderedFrames > 0 ? m_frameTimeSum / m_renderedFrames : 0;
+        m_framesPerSecond = m_swaps * 1000.0 / qMax<qint64>(1, m_refreshClock.restart());
+        m_frameTimeSum = 0;
+        m_renderedFrames = 0;
+        m_swaps = 0;
+        m_graph = m_frameTimes;
+    }
+
+    m_pendingDelegates = m_pendingGauge ? int(m_pendingGauge->value()) : 0;
+    m_incubatingDelegates = m_incubatingGauge ? int(m_incubatingGauge->value()) : 0;
+    m_socketBacklog = m_backlogGauge ? int(m_backlogGauge->value()) : 0;
+    m_lastApplyTime = m_applyHistogram ? m_applyHistogram->last() / 1000000.0 : 0;
+    m_residentMemory = readResidentMemory();
+
+    const QStringList lines({
+        QStringLiteral("%1 fps, frame %2 ms").arg(m_framesPerSecond, 0, 'f', 0).arg(m_frameTime, 0, 'f', 1),
+        QStringLiteral("delegates: %1 pending, %2 incubating").arg(m_pendingDelegates).arg(m_incubatingDelegates),
+        QStringLiteral("socket backlog: %1").arg(m_socketBacklog),
+        QStringLiteral("last apply: %1 ms").arg(m_lastApplyTime, 0, 'f', 2),
+        m_residentMemory >= 0 ? QStringLiteral("rss: %1 MiB").arg(m_residentMemory / 1048576.0, 0, 'f', 1) : QStringLiteral("rss: n/a")
+    });
+
+    // The text is rasterized here, at most twice a second, and uploaded as a texture
+    const qreal dpr = m_window ? m_window->effectiveDevicePixelRatio() : 1;
+    QFont font;
+    font.setStyleHint(QFont::Monospace);
+    font.setFamily(QStringLiteral("monospace"));
+    const QFontMetrics metrics(font);
+    int textWidth = 0;
+    for (const auto &line : lines) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+#else
+        textWidth = qMax(textWidth, metrics.width(line));
+#endif
+    }
+    const QSize textSize(textWidth, metrics.height() * lines.count());
+
+    QImage text(textSize * dpr, QImage::Format_ARGB32_Premultiplied);
+    text.setDevicePixelRatio(dpr);
+    text.fill(Qt::transparent);
+    QPainter painter(&text);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    for (int i = 0; i < lines.count(); ++i) {
+        painter.drawText(0, metrics.ascent() + i * metrics.height(), lines[i]);
+    }
+    painter.end();
+
+    m_text = text;
+    m_textDirty = true;
+    setImplicitSize(textSize.width() + s_padding * 2, textSize.height() + s_graphHeight + s_padding * 3);
+
+    update();
+    emit statsChanged();
+}
+
+QSGNode *PerformanceHud::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data)
+
+    if (m_text.isNull()) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    QSGSimpleRectNode *background = static_cast<QSGSimpleRectNode *>(oldNode);
+    QSGSimpleTextureNode *textNode;
+    QSGGeometryNode *budgetNode;
+    QSGGeometryNode *graphNode;
+    if (!background) {
+        background = new QSGSimpleRectNode;
+        background->setColor(QColor(0, 0, 0, 180));
+        textNode = new QSGSimpleTextureNode;
+        textNode->setOwnsTexture(true);
+        background->appendChildNode(textNode);
+        budgetNode = createGeometryNode(QSGGeometry::DrawLines, QColor(255, 255, 255, 90));
+        background->appendChildNode(budgetNode);
+        graphNode = createGeometryNode(QSGGeometry::DrawLineStrip, QColor(0, 255, 128));
+        background->appendChildNode(graphNode);
+    } else {
+        textNode = static_cast<QSGSimpleTextureNode *>(background->childAtIndex(0));
+        budgetNode = static_cast<QSGGeometryNode *>(background->childAtIndex(1));
+        graphNode = static_cast<QSGGeometryNode *>(background->childAtIndex(2));
+    }
+
+    background->setRect(boundingRect());
+
+    const QSizeF textSize = QSizeF(m_text.size()) / m_text.devicePixelRatio();
+    if (m_textDirty) {
+        textNode->setTexture(window()->createTextureFromImage(m_text));
+        m_textDirty = false;
+    }
+    textNode->setRect(QRectF(QPointF(s_padding, s_padding), textSize));
+
+    const qreal graphTop = s_padding * 2 + textSize.height();
+    const qreal graphWidth = qMax<qreal>(0, width() - s_padding * 2);
+
+    // Reference line at the 60Hz frame budget
+    QSGGeometry *budget = budgetNode->geometry();
+    budget->allocate(2);
+    const float budgetY = graphTop + s_graphHeight * (1 - 16.7f / s_graphRange);
+    budget->vertexDataAsPoint2D()[0].set(s_padding, budgetY);
+    budget->vertexDataAsPoint2D()[1].set(s_padding + graphWidth, budgetY);
+    budgetNode->markDirty(QSGNode::DirtyGeometry);
+
+    QSGGeometry *graph = graphNode->geometry();
+    graph->allocate(m_graph.count());
+    QSGGeometry::Point2D *vertices = graph->vertexDataAsPoint2D();
+    for (int i = 0; i < m_graph.count(); ++i) {
+        const float level = qMin(m_graph[i], s_graphRange) / s_graphRange;
+        vertices[i].set(s_padding + graphWidth * i / (s_graphSamples - 1), graphTop + s_graphHeight * (1 - level));
+    }
+    graphNode->markDirty(QSGNode::DirtyGeometry);
+
+    return background;
+}
+
+#include "moc_performancehud.cpp"
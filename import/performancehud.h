@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QQuickItem>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMutex>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+class MetricGauge;
+class MetricHistogram;
+
+/**
+ * Overlay showing what a slow screen is waiting for: rendering, delegate loading,
+ * the server or the device. Text and frame time graph are drawn straight in the
+ * scene graph and only refreshed twice a second, so the overlay itself doesn't
+ * keep the window rendering.
+ * It only samples while visible, usually bound to GlobalSettings.showPerformanceHud
+ */
+class PerformanceHud : public QQuickItem
+{
+    Q_OBJECT
+    /**
+     * Average time in ms the render thread spent on each frame, from synchronization to the end of rendering
+     */
+    Q_PROPERTY(qreal frameTime READ frameTime NOTIFY statsChanged)
+    Q_PROPERTY(qreal framesPerSecond READ framesPerSecond NOTIFY statsChanged)
+    /**
+     * Delegates waiting for their QML file to be loaded
+     */
+    Q_PROPERTY(int pendingDelegates READ pendingDelegates NOTIFY statsChanged)
+    /**
+     * Prefetched delegates being incubated
+     */
+    Q_PROPERTY(int incubatingDelegates READ incubatingDelegates NOTIFY statsChanged)
+    /**
+     * GUI messages received in the last burst from the socket
+     */
+    Q_PROPERTY(int socketBacklog READ socketBacklog NOTIFY statsChanged)
+    /**
+     * Time in ms the last GUI message took to be applied to the models
+     */
+    Q_PROPERTY(qreal lastApplyTime READ lastApplyTime NOTIFY statsChanged)
+    /**
+     * Resident memory of the process in bytes, -1 where not available
+     */
+    Q_PROPERTY(qint64 residentMemory READ residentMemory NOTIFY statsChanged)
+
+public:
+    explicit PerformanceHud(QQuickItem *parent = nullptr);
+    ~PerformanceHud() override;
+
+    qreal frameTime() const;
+    qreal framesPerSecond() const;
+    int pendingDelegates() const;
+    int incubatingDelegates() const;
+    int socketBacklog() const;
+    qreal lastApplyTime() const;
+    qint64 residentMemory() const;
+
+Q_SIGNALS:
+    void statsChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    void updateSampling();
+    void refresh();
+    void onBeforeSynchronizing();
+    void onAfterRendering();
+    void onFrameSwapped();
+
+    QPointer<QQuickWindow> m_window;
+    QTimer m_refreshTimer;
+    QElapsedTimer m_refreshClock;
+
+    const MetricGauge *m_pendingGauge = nullptr;
+    const MetricGauge *m_incubatingGauge = nullptr;
+    const MetricGauge *m_backlogGauge = nullptr;
+    const MetricHistogram *m_applyHistogram = nullptr;
+
+    qreal m_frameTime = 0;
+    qreal m_framesPerSecond = 0;
+    int m_pendingDelegates = 0;
+    int m_incubatingDelegates = 0;
+    int m_socketBacklog = 0;
+    qreal m_lastApplyTime = 0;
+    qint64 m_residentMemory = -1;
+
+    //Written in the render thread
+    QMutex m_frameMutex;
+    QElapsedTimer m_frameClock;
+    qint64 m_frameStart = -1;
+    QVector<float> m_frameTimes;
+    double m_frameTimeSum = 0;
+    int m_renderedFrames = 0;
+    int m_swaps = 0;
+
+    //Handed over to updatePaintNode
+    QImage m_text;
+    QVector<float> m_graph;
+    bool m_textDirty = false;
+};
+
@@ -22,6 +22,7 @@ import QtQuick.Layouts 1.3
 import QtMultimedia 5.9
 import org.kde.kirigami 2.5 as Kirigami
 import Mycroft 1.0 as Mycroft
+import "private/scaledimage.js" as ScaledImage
 
 
 Item {
@@ -30,7 +31,7 @@ Item {
     property alias source: player.source
     property string status: "stop"
     property int switchWidth: Kirigami.Units.gridUnit * 22
-    property alias thumbnail: albumimg.source
+    property url thumbnail
     property alias title: songtitle.text
     property bool progressBar: true
     property bool thumbnailVisible: true
@@ -108,6 +109,9 @@ Item {
         Image {
             id: albumimg
             fillMode: Image.PreserveAspectCrop
+            // Decoded off the GUI thread, at the thumbnail size
+            source: ScaledImage.scaledUrl(root.thumbnail)
+            sourceSize: Qt.size(Layout.preferredWidth, Layout.preferredHeight)
             visible: root.thumbnailVisible ? 1 : 0
             enabled: root.thumbnailVisible ? 1 : 0
             Layout.preferredWidth: root.horizontal ? Kirigami.Units.gridUnit * 10 : Kirigami.Units.gridUnit * 5
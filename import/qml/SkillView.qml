@@ -329,4 +329,14 @@ Mycroft.AbstractSkillView {
             }
         }
     }
+
+    Mycroft.PerformanceHud {
+        anchors {
+            left: parent.left
+            bottom: parent.bottom
+            margins: Kirigami.Units.largeSpacing
+        }
+        z: 9999
+        visible: Mycroft.GlobalSettings.showPerformanceHud
+    }
 }
@@ -17,6 +17,7 @@
 
 import QtQuick 2.4
 import org.kde.kirigami 2.4 as Kirigami
+import "private/scaledimage.js" as ScaledImage
 
 /**
  * Contains an image that will slowly scroll in order to be shown completely
@@ -44,7 +45,7 @@ Item {
      * source: url
      * source for the image
      */
-    property alias source: image.source
+    property url source
 
     /**
      * speed: real
@@ -61,22 +62,26 @@ Item {
     Image {
         id: image
         fillMode: Image.PreserveAspectFit
+        // Decoded off the GUI thread, just large enough to cover the item
+        source: root.width > 0 && root.height > 0 ? ScaledImage.scaledUrl(root.source) : ""
+        sourceSize: Qt.size(root.width, root.height)
 
-        readonly property bool horizontal: sourceSize.width / sourceSize.height > root.width / root.height
+        readonly property bool horizontal: implicitWidth / implicitHeight > root.width / root.height
         //Transforms the speed into duration
         readonly property real duration: horizontal
             ? ((image.width - root.width) / (root.speed * Kirigami.Units.gridUnit)) * (1000 / Kirigami.Units.gridUnit)
             : ((image.height - root.height) / (root.speed * Kirigami.Units.gridUnit)) * (1000 / Kirigami.Units.gridUnit)
 
+        // sourceSize is the requested size, the loaded one is the implicit size
         width: horizontal
-            ? root.height * (sourceSize.width / sourceSize.height)
+            ? root.height * (implicitWidth / implicitHeight)
             : root.width
         height: horizontal
             ? root.height
-            : root.width * (sourceSize.height / sourceSize.width)
+            : root.width * (implicitHeight / implicitWidth)
         onWidthChanged: updateAnimsTimer.restart()
         onHeightChanged: updateAnimsTimer.restart()
-        onSourceSizeChanged: updateAnimsTimer.restart()
+        onImplicitWidthChanged: updateAnimsTimer.restart()
 
         Timer {
             id: updateAnimsTimer
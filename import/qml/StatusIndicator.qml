@@ -217,6 +217,13 @@ Item {
         height: width
         color: innerCircle.backgroundColor
         radius: height
+        // pulses with the voice of the user when capture metering is enabled
+        scale: Mycroft.CaptureMeter.running ? 1 + Math.min(0.2, Mycroft.CaptureMeter.level) : 1
+        Behavior on scale {
+            NumberAnimation {
+                duration: 80
+            }
+        }
         layer.enabled: hasShadow
         layer.effect: DropShadow {
             cached: true
@@ -20,6 +20,7 @@ import QtQuick 2.4
 import QtQuick.Layouts 1.2
 import QtQuick.Controls 2.4 as Controls
 import org.kde.kirigami 2.7 as Kirigami
+import "scaledimage.js" as ScaledImage
 
 
 Item {
@@ -33,15 +34,24 @@ Item {
     onSourceChanged: {
         if (backgroundImage.currentImage == image1) {
             image2.opacity = 0;
-            image2.source = source;
+            image2.backgroundSource = source;
             backgroundImage.setCurrent(image2);
         } else {
             image1.opacity = 0;
-            image1.source = source;
+            image1.backgroundSource = source;
             backgroundImage.setCurrent(image1);
         }
     }
 
+    // Wallpapers are decoded off the GUI thread, at the screen size
+    function scaledSource(url) {
+        // Not laid out yet: an empty sourceSize would decode the full image
+        if (backgroundImage.width <= 0 || backgroundImage.height <= 0) {
+            return "";
+        }
+        return ScaledImage.scaledUrl(url);
+    }
+
     function setCurrent(image) {
         if (image.status === Image.Ready) {
             backgroundImage.currentImage = image;
@@ -56,7 +66,10 @@ Item {
     }
     Image {
         id: image1
+        property string backgroundSource
         anchors.fill: parent
+        source: backgroundImage.scaledSource(backgroundSource)
+        sourceSize: Qt.size(backgroundImage.width, backgroundImage.height)
         z: backgroundImage.currentImage == image1 ? 1 : 0
         fillMode: Image.PreserveAspectCrop
         onStatusChanged: {
@@ -67,7 +80,10 @@ Item {
     }
     Image {
         id: image2
+        property string backgroundSource
         anchors.fill: parent
+        source: backgroundImage.scaledSource(backgroundSource)
+        sourceSize: Qt.size(backgroundImage.width, backgroundImage.height)
         z: backgroundImage.currentImage == image2 ? 1 : 0
         fillMode: Image.PreserveAspectCrop
         onStatusChanged: {
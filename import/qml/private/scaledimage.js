@@ -0,0 +1,29 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+.pragma library
+
+// The url to load an image through the mycroftscaled provider, which decodes it off
+// the GUI thread at the sourceSize of the Image. Urls the provider can't read,
+// like the ones of other image providers, are returned unchanged
+function scaledUrl(url) {
+    url = url.toString();
+    if (/^(file|qrc|https?):|^\//.test(url)) {
+        return "image://mycroftscaled/" + encodeURIComponent(url);
+    }
+    return url;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MYCROFT_SAMPLES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MYCROFT_SAMPLES_NEON
+#endif
+
+/**
+ * Sum of the absolute values of the normalized samples of each channel
+ */
+struct StereoLevels
+{
+    float left = 0;
+    float right = 0;
+};
+
+/**
+ * Normalization of a single sample to [-1, 1].
+ * Unsigned formats are centered on half their range, flipping the top bit
+ * gives the same value as the signed format, which is what the vector paths do.
+ */
+template<typename T> struct SampleFormat;
+
+template<> struct SampleFormat<qint8> {
+    static float scale() { return 1.0f / 128; }
+    static float toFloat(qint8 v) { return v * scale(); }
+};
+
+template<> struct SampleFormat<quint8> {
+    static float scale() { return 1.0f / 128; }
+    static float toFloat(quint8 v) { return (int(v) - 128) * scale(); }
+};
+
+template<> struct SampleFormat<qint16> {
+    static float scale() { return 1.0f / 32768; }
+    static float toFloat(qint16 v) { return v * scale(); }
+};
+
+template<> struct SampleFormat<quint16> {
+    static float scale() { return 1.0f / 32768; }
+    static float toFloat(quint16 v) { return (int(v) - 32768) * scale(); }
+};
+
+template<> struct SampleFormat<qint32> {
+    static float scale() { return 1.0f / 2147483648.0f; }
+    static float toFloat(qint32 v) { return float(v) * scale(); }
+};
+
+template<> struct SampleFormat<quint32> {
+    static float scale() { return 1.0f / 2147483648.0f; }
+    static float toFloat(quint32 v) { return float(qint32(v ^ 0x80000000u)) * scale(); }
+};
+
+template<> struct SampleFormat<float> {
+    static float scale() { return 1.0f; }
+    // Broken decoders can produce NaN, which would poison the spectrum and the levels
+    static float toFloat(float v) { return v == v ? v : 0.0f; }
+};
+
+/**
+ * Reference implementation: deinterleaves the left channel of frames stereo frames
+ * into mono as normalized floats and accumulates the levels of both channels.
+ */
+template<typename T>
+void convertSamplesScalar(const T *data, int frames, float *mono, StereoLevels &levels)
+{
+    for (int i = 0; i < frames; ++i) {
+        const float left = SampleFormat<T>::toFloat(data[2 * i]);
+        const float right = SampleFormat<T>::toFloat(data[2 * i + 1]);
+        mono[i] = left;
+        levels.left += std::fabs(left);
+        levels.right += std::fabs(right);
+    }
+}
+
+#if defined(MYCROFT_SAMPLES_SSE2)
+
+/**
+ * Loads 4 stereo frames as normalized left and right vectors
+ */
+template<typename T> struct SimdFrames;
+
+static inline void deinterleaveInt32(__m128i a, __m128i b, float scale, __m128 &left, __m128 &right)
+{
+    const __m128 fa = _mm_cvtepi32_ps(a);
+    const __m128 fb = _mm_cvtepi32_ps(b);
+    const __m128 s = _mm_set1_ps(scale);
+    left = _mm_mul_ps(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0)), s);
+    right = _mm_mul_ps(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1)), s);
+}
+
+// Each 32 bit lane holds a left sample in its low half and a right sample in its high half
+static inline void deinterleaveInt16(__m128i x, float scale, __m128 &left, __m128 &right)
+{
+    const __m128 s = _mm_set1_ps(scale);
+    left = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(x, 16), 16)), s);
+    right = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(x, 16)), s);
+}
+
+static inline __m128i widenInt8(__m128i x)
+{
+    return _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+}
+
+template<> struct SimdFrames<qint8> {
+    static void load(const qint8 *p, __m128 &left, __m128 &right) {
+        const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+        deinterleaveInt16(widenInt8(x), SampleFormat<qint8>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<quint8> {
+    static void load(const quint8 *p, __m128 &left, __m128 &right) {
+        const __m128i x = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi8(char(0x80)));
+        deinterleaveInt16(widenInt8(x), SampleFormat<quint8>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<qint16> {
+    static void load(const qint16 *p, __m128 &left, __m128 &right) {
+        deinterleaveInt16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), SampleFormat<qint16>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<quint16> {
+    static void load(const quint16 *p, __m128 &left, __m128 &right) {
+        const __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi16(short(0x8000)));
+        deinterleaveInt16(x, SampleFormat<quint16>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<qint32> {
+    static void load(const qint32 *p, __m128 &left, __m128 &right) {
+        deinterleaveInt32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 4)),
+                          SampleFormat<qint32>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<quint32> {
+    static void load(const quint32 *p, __m128 &left, __m128 &right) {
+        const __m128i sign = _mm_set1_epi32(int(0x80000000u));
+        deinterleaveInt32(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), sign),
+                          _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 4)), sign),
+                          SampleFormat<quint32>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<float> {
+    static void load(const float *p, __m128 &left, __m128 &right) {
+        const __m128 a = _mm_loadu_ps(p);
+        const __m128 b = _mm_loadu_ps(p + 4);
+        left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        //NaN compares unordered with itself
+        left = _mm_and_ps(left, _mm_cmpord_ps(left, left));
+        right = _mm_and_ps(right, _mm_cmpord_ps(right, right));
+    }
+};
+
+static inline float horizontalSum(__m128 v)
+{
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+#elif defined(MYCROFT_SAMPLES_NEON)
+
+template<typename T> struct SimdFrames;
+
+static inline void deinterleaveInt16(int16x8_t x, float scale, float32x4_t &left, float32x4_t &right)
+{
+    const int16x4x2_t channels = vuzp_s16(vget_low_s16(x), vget_high_s16(x));
+    left = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(channels.val[0])), scale);
+    right = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(channels.val[1])), scale);
+}
+
+template<> struct SimdFrames<qint8> {
+    static void load(const qint8 *p, float32x4_t &left, float32x4_t &right) {
+        deinterleaveInt16(vmovl_s8(vld1_s8(p)), SampleFormat<qint8>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<quint8> {
+    static void load(const quint8 *p, float32x4_t &left, float32x4_t &right) {
+        const int8x8_t x = vreinterpret_s8_u8(veor_u8(vld1_u8(p), vdup_n_u8(0x80)));
+        deinterleaveInt16(vmovl_s8(x), SampleFormat<quint8>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<qint16> {
+    static void load(const qint16 *p, float32x4_t &left, float32x4_t &right) {
+        deinterleaveInt16(vld1q_s16(p), SampleFormat<qint16>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<quint16> {
+    static void load(const quint16 *p, float32x4_t &left, float32x4_t &right) {
+        const int16x8_t x = vreinterpretq_s16_u16(veorq_u16(vld1q_u16(p), vdupq_n_u16(0x8000)));
+        deinterleaveInt16(x, SampleFormat<quint16>::scale(), left, right);
+    }
+};
+
+template<> struct SimdFrames<qint32> {
+    static void load(const qint32 *p, float32x4_t &left, float32x4_t &right) {
+        const int32x4x2_t channels = vld2q_s32(p);
+        left = vmulq_n_f32(vcvtq_f32_s32(channels.val[0]), SampleFormat<qint32>::scale());
+        right = vmulq_n_f32(vcvtq_f32_s32(channels.val[1]), SampleFormat<qint32>::scale());
+    }
+};
+
+template<> struct SimdFrames<quint32> {
+    static void load(const quint32 *p, float32x4_t &left, float32x4_t &right) {
+        const uint32x4x2_t channels = vld2q_u32(p);
+        const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+        left = vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(veorq_u32(channels.val[0], sign))), SampleFormat<quint32>::scale());
+        right = vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(veorq_u32(channels.val[1], sign))), SampleFormat<quint32>::scale());
+    }
+};
+
+template<> struct SimdFrames<float> {
+    static void load(const float *p, float32x4_t &left, float32x4_t &right) {
+        const float32x4x2_t channels = vld2q_f32(p);
+        //NaN compares unequal to itself
+        left = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(channels.val[0]), vceqq_f32(channels.val[0], channels.val[0])));
+        right = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(channels.val[1]), vceqq_f32(channels.val[1], channels.val[1])));
+    }
+};
+
+static inline float horizontalSum(float32x4_t v)
+{
+    return (vgetq_lane_f32(v, 0) + vgetq_lane_f32(v, 1)) + (vgetq_lane_f32(v, 2) + vgetq_lane_f32(v, 3));
+}
+
+#endif
+
+/**
+ * Deinterleaves, normalizes and meters a stereo buffer in a single pass,
+ * 4 frames at a time with SSE2 or NEON where available.
+ * Same results as convertSamplesScalar, except for the rounding of the level sums.
+ */
+template<typename T>
+void convertSamples(const T *data, int frames, float *mono, StereoLevels &levels)
+{
+    int i = 0;
+
+#if defined(MYCROFT_SAMPLES_SSE2)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 sumLeft = _mm_setzero_ps();
+    __m128 sumRight = _mm_setzero_ps();
+    for (; i + 4 <= frames; i += 4) {
+        __m128 left, right;
+        SimdFrames<T>::load(data + 2 * i, left, right);
+        _mm_storeu_ps(mono + i, left);
+        sumLeft = _mm_add_ps(sumLeft, _mm_and_ps(left, absMask));
+        sumRight = _mm_add_ps(sumRight, _mm_and_ps(right, absMask));
+    }
+    levels.left += horizontalSum(sumLeft);
+    levels.right += horizontalSum(sumRight);
+#elif defined(MYCROFT_SAMPLES_NEON)
+    float32x4_t sumLeft = vdupq_n_f32(0);
+    float32x4_t sumRight = vdupq_n_f32(0);
+    for (; i + 4 <= frames; i += 4) {
+        float32x4_t left, right;
+        SimdFrames<T>::load(data + 2 * i, left, right);
+        vst1q_f32(mono + i, left);
+        sumLeft = vaddq_f32(sumLeft, vabsq_f32(left));
+        sumRight = vaddq_f32(sumRight, vabsq_f32(right));
+    }
+    levels.left += horizontalSum(sumLeft);
+    levels.right += horizontalSum(sumRight);
+#endif
+
+    convertSamplesScalar(data + 2 * i, frames - i, mono + i, levels);
+}
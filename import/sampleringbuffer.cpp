@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "sampleringbuffer.h"
+
+#include <atomic>
+#include <cstring>
+
+SampleRingBuffer::SampleRingBuffer(int capacity)
+    : m_writePosition(0),
+      m_reservedPosition(0)
+{
+    int size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_samples.resize(size);
+    m_mask = size - 1;
+}
+
+int SampleRingBuffer::capacity() const
+{
+    return m_samples.size();
+}
+
+void SampleRingBuffer::write(const float *samples, int count)
+{
+    const int size = m_samples.size();
+    quint64 position = m_writePosition.loadAcquire();
+
+    // Only the newest samples would survive anyways
+    if (count > size) {
+        position += count - size;
+        samples += count - size;
+        count = size;
+    }
+
+    // Announce which samples are about to be overwritten before touching them
+    m_reservedPosition.storeRelease(position + count);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const int start = position & m_mask;
+    const int firstPart = qMin(count, size - start);
+    float *data = m_samples.data();
+    memcpy(data + start, samples, firstPart * sizeof(float));
+    memcpy(data, samples + firstPart, (count - firstPart) * sizeof(float));
+
+    m_writePosition.storeRelease(position + count);
+}
+
+quint64 SampleRingBuffer::writePosition() const
+{
+    return m_writePosition.loadAcquire();
+}
+
+bool SampleRingBuffer::read(quint64 end, float *out, int count) const
+{
+    const int size = m_samples.size();
+    if (count > size || end < quint64(count) || end > m_writePosition.loadAcquire()) {
+        return false;
+    }
+
+    const quint64 begin = end - count;
+    const int start = begin & m_mask;
+    const int firstPart = qMin(count, size - start);
+    const float *data = m_samples.constData();
+    memcpy(out, data + start, firstPart * sizeof(float));
+    memcpy(out + firstPart, data, (count - firstPart) * sizeof(float));
+
+    // The copy must be complete before checking if the producer started overwriting it meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return m_reservedPosition.loadAcquire() - begin <= quint64(size);
+}
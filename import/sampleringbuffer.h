@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QVector>
+
+/**
+ * Lock free single producer, single consumer ring of float samples.
+ * The producer never waits: when the consumer falls behind the oldest samples
+ * are overwritten, so memory stays bounded whatever the size of the bursts.
+ * Positions are absolute sample counts since the creation of the ring; the
+ * consumer keeps its own read position and, like a seqlock, checks if what it
+ * copied was overwritten while copying.
+ */
+class SampleRingBuffer
+{
+public:
+    /**
+     * @param capacity rounded up to a power of two
+     */
+    explicit SampleRingBuffer(int capacity);
+
+    int capacity() const;
+
+    /**
+     * Producer side: appends count samples, overwriting the oldest ones if needed
+     */
+    void write(const float *samples, int count);
+
+    /**
+     * Consumer side: total number of samples written so far
+     */
+    quint64 writePosition() const;
+
+    /**
+     * Consumer side: copies the count samples ending at position end into out.
+     * @returns false if they are not available anymore, or not yet
+     */
+    bool read(quint64 end, float *out, int count) const;
+
+private:
+    QVector<float> m_samples;
+    quint64 m_mask;
+    //samples up to here are completely written
+    QAtomicInteger<quint64> m_writePosition;
+    //samples up to here may be being written
+    QAtomicInteger<quint64> m_reservedPosition;
+};
+
@@ -0,0 +1,465 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "scaledimageprovider.h"
+#include "metricsregistry.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadStorage>
+#include <QTimer>
+#include <QDebug>
+
+static const int s_downloadTimeout = 30000;
+
+static MetricCounter *lookups(const QString &result)
+{
+    return MetricsRegistry::instance()->counter(QStringLiteral("mycroft_gui_image_cache_lookups_total"),
+                                                QStringLiteral("Scaled images requested, by where they were found"),
+                                                {{QStringLiteral("result"), result}});
+}
+
+static bool isRemote(const QUrl &source)
+{
+    return source.scheme() == QLatin1String("http") || source.scheme() == QLatin1String("https");
+}
+
+static QString localPath(const QUrl &source)
+{
+    if (source.scheme() == QLatin1String("qrc")) {
+        return QLatin1Char(':') + source.path();
+    } else if (source.isLocalFile()) {
+        return source.toLocalFile();
+    }
+    return source.path();
+}
+
+static int imageBytes(const QImage &image)
+{
+    return image.bytesPerLine() * image.height();
+}
+
+// Smallest downscaled size still covering requestedSize, so it works for both fit and crop fill modes
+static QSize coveringSize(const QSize &imageSize, const QSize &requestedSize)
+{
+    if (imageSize.isEmpty()) {
+        return imageSize;
+    }
+
+    qreal factor = 0;
+    if (requestedSize.width() > 0) {
+        factor = qreal(requestedSize.width()) / imageSize.width();
+    }
+    if (requestedSize.height() > 0) {
+        factor = qMax(factor, qreal(requestedSize.height()) / imageSize.height());
+    }
+    if (factor <= 0 || factor >= 1) {
+        return imageSize;
+    }
+    return QSize(qMax(1, qRound(imageSize.width() * factor)), qMax(1, qRound(imageSize.height() * factor)));
+}
+
+// data is the downloaded file of remote sources
+static QImage decode(const QUrl &source, const QByteArray &data, const QSize &requestedSize, bool *downscaled, QString *errorString)
+{
+    QBuffer buffer;
+    QImageReader reader;
+    if (isRemote(source)) {
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+    } else {
+        reader.setFileName(localPath(source));
+    }
+    reader.setAutoTransform(true);
+
+    // Decoding straight at the smaller size is what saves time and memory, when the format supports it
+    QSize requested = requestedSize;
+    if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+        requested.transpose();
+    }
+    const QSize imageSize = reader.size();
+    const QSize scaledSize = coveringSize(imageSize, requested);
+    if (scaledSize != imageSize) {
+        reader.setScaledSize(scaledSize);
+        *downscaled = true;
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        *errorString = reader.errorString();
+        return image;
+    }
+
+    // Formats which don't know their size before decoding
+    if (!*downscaled) {
+        const QSize size = coveringSize(image.size(), requestedSize);
+        if (size != image.size()) {
+            image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            *downscaled = true;
+        }
+    }
+    return image;
+}
+
+ScaledImageCache *ScaledImageCache::instance()
+{
+    static ScaledImageCache s_self;
+    return &s_self;
+}
+
+ScaledImageCache::ScaledImageCache()
+    : m_cacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/images"))
+{
+    m_memory.setMaxCost(64 * 1024 * 1024);
+    m_validators.setMaxCost(1024);
+}
+
+int ScaledImageCache::memoryBudget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_memory.maxCost();
+}
+
+void ScaledImageCache::setMemoryBudget(int bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_memory.setMaxCost(bytes);
+}
+
+qint64 ScaledImageCache::diskBudget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_diskBudget;
+}
+
+void ScaledImageCache::setDiskBudget(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_diskBudget = bytes;
+    pruneDisk();
+}
+
+int ScaledImageCache::memoryUsage() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_memory.totalCost();
+}
+
+QString ScaledImageCache::cacheDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cacheDirectory;
+}
+
+void ScaledImageCache::setCacheDirectory(const QString &directory)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cacheDirectory = directory;
+    m_diskUsage = -1;
+}
+
+void ScaledImageCache::clearMemory()
+{
+    QMutexLocker locker(&m_mutex);
+    m_memory.clear();
+}
+
+QByteArray ScaledImageCache::download(const QUrl &source, bool conditional, QByteArray *contentHash, QString *errorString)
+{
+    // Runs on a thread of the pool, which has no event loop of its own. Each thread keeps its
+    // manager, so the connections to the same server are reused
+    static QThreadStorage<QNetworkAccessManager *> s_managers;
+    if (!s_managers.hasLocalData()) {
+        s_managers.setLocalData(new QNetworkAccessManager);
+    }
+
+    Validators validators;
+    if (conditional) {
+        QMutexLocker locker(&m_mutex);
+        if (const Validators *cached = m_validators.object(source)) {
+            validators = *cached;
+        }
+    }
+
+    QNetworkRequest request(source);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+    if (!validators.etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", validators.etag);
+    }
+    if (!validators.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", validators.lastModified);
+    }
+    QNetworkReply *reply = s_managers.localData()->get(request);
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    timeout.start(s_downloadTimeout);
+    loop.exec();
+
+    QByteArray data;
+    contentHash->clear();
+    if (!reply->isFinished()) {
+        reply->abort();
+        *errorString = QStringLiteral("Timed out downloading %1").arg(source.toString());
+    } else if (reply->error() != QNetworkReply::NoError) {
+        *errorString = reply->errorString();
+    } else if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        // Only ever asked for with validators, which come with the hash
+        *contentHash = validators.contentHash;
+    } else {
+        data = reply->readAll();
+        if (data.isEmpty()) {
+            *errorString = QStringLiteral("Nothing downloaded from %1").arg(source.toString());
+        } else {
+            *contentHash = QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+
+            const QByteArray etag = reply->rawHeader("ETag");
+            const QByteArray lastModified = reply->rawHeader("Last-Modified");
+            QMutexLocker locker(&m_mutex);
+            if (etag.isEmpty() && lastModified.isEmpty()) {
+                m_validators.remove(source);
+            } else {
+                m_validators.insert(source, new Validators{etag, lastModified, *contentHash});
+            }
+        }
+    }
+    delete reply;
+    return data;
+}
+
+QString ScaledImageCache::cacheKey(const QUrl &source, const QByteArray &contentHash, const QSize &requestedSize) const
+{
+    QString key = source.toString();
+    // A file replaced in place must not get its old scaled version
+    if (isRemote(source)) {
+        key += QLatin1Char('|') + QString::fromLatin1(contentHash);
+    } else {
+        const QFileInfo info(localPath(source));
+        key += QStringLiteral("|%1|%2").arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size());
+    }
+    key += QStringLiteral("|%1x%2").arg(requestedSize.width()).arg(requestedSize.height());
+    return QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QImage ScaledImageCache::readDisk(const QString &key) const
+{
+    const QString path = QDir(cacheDirectory()).filePath(key);
+    QImageReader reader(path);
+    if (!reader.canRead()) {
+        return QImage();
+    }
+
+    const QImage image = reader.read();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // Pruning removes the least recently used files first
+    if (!image.isNull()) {
+        QFile file(path);
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+    }
+#endif
+    return image;
+}
+
+void ScaledImageCache::writeDisk(const QString &key, const QImage &image)
+{
+    const QString directory = cacheDirectory();
+    if (directory.isEmpty() || !QDir().mkpath(directory)) {
+        return;
+    }
+
+    // Lossless when there is transparency, jpeg is much smaller and faster to read otherwise
+    const QString path = QDir(directory).filePath(key);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)
+        || !image.save(&file, image.hasAlphaChannel() ? "PNG" : "JPG", image.hasAlphaChannel() ? -1 : 90)
+        || !file.commit()) {
+        qWarning() << "Can't write the scaled image cache" << path << file.errorString();
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (directory != m_cacheDirectory) {
+        return;
+    }
+    if (m_diskUsage >= 0) {
+        m_diskUsage += QFileInfo(path).size();
+    }
+    pruneDisk();
+}
+
+void ScaledImageCache::pruneDisk()
+{
+    // Called with m_mutex held
+    QDir directory(m_cacheDirectory);
+    if (m_diskUsage < 0) {
+        m_diskUsage = 0;
+        for (const QFileInfo &info : directory.entryInfoList(QDir::Files)) {
+            m_diskUsage += info.size();
+        }
+    }
+    if (m_diskUsage <= m_diskBudget) {
+        return;
+    }
+
+    // Down to 3/4 of the budget, not to prune again at the next write
+    const QFileInfoList files = directory.entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QFileInfo &info : files) {
+        if (m_diskUsage <= m_diskBudget / 4 * 3) {
+            break;
+        }
+        if (QFile::remove(info.filePath())) {
+            m_diskUsage -= info.size();
+        }
+    }
+}
+
+QImage ScaledImageCache::image(const QUrl &source, const QSize &requestedSize, QString *errorString)
+{
+    static MetricCounter *s_memoryHits = lookups(QStringLiteral("memory"));
+    static MetricCounter *s_diskHits = lookups(QStringLiteral("disk"));
+    static MetricCounter *s_misses = lookups(QStringLiteral("decoded"));
+
+    // The server may change what is at a url at any time: remote images are always revalidated,
+    // when unchanged the caches spare both downloading and decoding them again
+    QByteArray data;
+    QByteArray contentHash;
+    if (isRemote(source)) {
+        QString error;
+        data = download(source, true, &contentHash, &error);
+        if (contentHash.isEmpty()) {
+            qWarning() << "Can't load image" << source << error;
+            if (errorString) {
+                *errorString = error;
+            }
+            return QImage();
+        }
+    }
+
+    QString key = cacheKey(source, contentHash, requestedSize);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QImage *cached = m_memory.object(key)) {
+            s_memoryHits->increment();
+            return *cached;
+        }
+    }
+
+    QImage image = readDisk(key);
+    if (!image.isNull()) {
+        s_diskHits->increment();
+    } else {
+        s_misses->increment();
+        // Not modified, but no longer in the caches at this size: the file itself is needed
+        if (isRemote(source) && data.isEmpty()) {
+            QString error;
+            data = download(source, false, &contentHash, &error);
+            if (contentHash.isEmpty()) {
+                qWarning() << "Can't load image" << source << error;
+                if (errorString) {
+                    *errorString = error;
+                }
+                return QImage();
+            }
+            key = cacheKey(source, contentHash, requestedSize);
+        }
+        bool downscaled = false;
+        QString error;
+        image = decode(source, data, requestedSize, &downscaled, &error);
+        if (image.isNull()) {
+            qWarning() << "Can't load image" << source << error;
+            if (errorString) {
+                *errorString = error;
+            }
+            return image;
+        }
+        // Local images at their size already load as fast as from the cache
+        if (downscaled || isRemote(source)) {
+            writeDisk(key, image);
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_memory.insert(key, new QImage(image), imageBytes(image));
+    return image;
+}
+
+ScaledImageResponse::ScaledImageResponse(const QUrl &source, const QSize &requestedSize)
+    : m_source(source),
+      m_requestedSize(requestedSize)
+{
+    // Deleted by the engine once finished
+    setAutoDelete(false);
+}
+
+QQuickTextureFactory *ScaledImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+QString ScaledImageResponse::errorString() const
+{
+    return m_errorString;
+}
+
+void ScaledImageResponse::cancel()
+{
+    m_canceled.store(1);
+}
+
+void ScaledImageResponse::run()
+{
+    // Images scrolled away before their turn are not decoded at all
+    if (!m_canceled.load()) {
+        m_image = ScaledImageCache::instance()->image(m_source, m_requestedSize, &m_errorString);
+    }
+    emit finished();
+}
+
+ScaledImageProvider::ScaledImageProvider()
+{
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 4));
+}
+
+ScaledImageProvider::~ScaledImageProvider()
+{
+    m_pool.waitForDone();
+}
+
+QQuickImageResponse *ScaledImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    ScaledImageResponse *response = new ScaledImageResponse(QUrl(QUrl::fromPercentEncoding(id.toUtf8())), requestedSize);
+    m_pool.start(response);
+    return response;
+}
+
+#include "moc_scaledimageprovider.cpp"
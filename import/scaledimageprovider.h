@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QQuickAsyncImageProvider>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QUrl>
+
+/**
+ * Images decoded at the size they are shown at, for skill backgrounds and thumbnails.
+ * Decoded images are kept in memory in a least recently used cache limited in bytes,
+ * the scaled versions are also written in a disk cache so the next start doesn't need
+ * to decode the full resolution files again.
+ * Local files are cached by modification time and size, remote ones by their content.
+ * Remote images are revalidated at each request with the ETag or Last-Modified the server
+ * sent, an unchanged one costs a 304 and is taken from the caches.
+ *
+ * Thread safe: used from the threads of ScaledImageProvider.
+ */
+class ScaledImageCache
+{
+public:
+    static ScaledImageCache *instance();
+
+    /**
+     * source decoded to cover requestedSize, keeping its aspect ratio. Images are only
+     * ever downscaled, a requested dimension of 0 follows the other one.
+     * Local files, qrc and http(s) sources are supported. Blocks until the image is ready.
+     * @returns the image, null on error with errorString set
+     */
+    QImage image(const QUrl &source, const QSize &requestedSize, QString *errorString = nullptr);
+
+    int memoryBudget() const;
+    void setMemoryBudget(int bytes);
+    qint64 diskBudget() const;
+    void setDiskBudget(qint64 bytes);
+    int memoryUsage() const;
+
+    /**
+     * @internal where the scaled images are written. For the autotests
+     */
+    QString cacheDirectory() const;
+    void setCacheDirectory(const QString &directory);
+
+    /**
+     * Drops the images in memory, the disk cache stays
+     */
+    void clearMemory();
+
+private:
+    ScaledImageCache();
+
+    // What the server sent with the last full download of a url
+    struct Validators {
+        QByteArray etag;
+        QByteArray lastModified;
+        QByteArray contentHash;
+    };
+
+    // Empty data with contentHash set when the server answered 304
+    QByteArray download(const QUrl &source, bool conditional, QByteArray *contentHash, QString *errorString);
+    QString cacheKey(const QUrl &source, const QByteArray &contentHash, const QSize &requestedSize) const;
+    QImage readDisk(const QString &key) const;
+    void writeDisk(const QString &key, const QImage &image);
+    void pruneDisk();
+
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_memory;
+    QCache<QUrl, Validators> m_validators;
+    QString m_cacheDirectory;
+    qint64 m_diskBudget = 128 * 1024 * 1024;
+    // -1 until the cache directory has been looked at
+    qint64 m_diskUsage = -1;
+};
+
+/**
+ * A pending image of ScaledImageProvider, computed on its thread pool
+ */
+class ScaledImageResponse : public QQuickImageResponse, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    ScaledImageResponse(const QUrl &source, const QSize &requestedSize);
+
+    QQuickTextureFactory *textureFactory() const override;
+    QString errorString() const override;
+    void cancel() override;
+
+    void run() override;
+
+private:
+    QUrl m_source;
+    QSize m_requestedSize;
+    QImage m_image;
+    QString m_errorString;
+    QAtomicInt m_canceled;
+};
+
+/**
+ * Serves images through ScaledImageCache to QML, decoded off the GUI thread, as
+ * image://mycroftscaled/<percent encoded url>. The size comes from sourceSize.
+ */
+class ScaledImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    ScaledImageProvider();
+    ~ScaledImageProvider() override;
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+private:
+    QThreadPool m_pool;
+};
+
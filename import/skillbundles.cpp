@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "skillbundles.h"
+
+#include <QFileInfo>
+#include <QResource>
+#include <QDebug>
+
+SkillBundles *SkillBundles::instance()
+{
+    static SkillBundles s_self;
+    return &s_self;
+}
+
+QUrl SkillBundles::resolve(const QString &skillId, const QUrl &url)
+{
+    if (url.scheme() != QLatin1String("bundle")) {
+        return url;
+    }
+
+    QUrl fileUrl = QUrl::fromLocalFile(url.path());
+
+    const QString path = url.path();
+    const int uiIndex = path.lastIndexOf(QStringLiteral("/ui/"));
+    if (uiIndex < 0) {
+        qWarning() << "Bundle url not inside a ui directory, using the loose file" << url;
+        return fileUrl;
+    }
+
+    // The bundle is ui.rcc next to the ui directory, with the ui directory as its root
+    const QString rccPath = path.left(uiIndex) + QStringLiteral("/ui.rcc");
+    if (!registerBundle(skillId, rccPath)) {
+        return fileUrl;
+    }
+
+    const QString resourcePath = m_bundles[skillId].last().mapRoot + path.mid(uiIndex + 3);
+    if (!QFileInfo::exists(QLatin1Char(':') + resourcePath)) {
+        qWarning() << "File not found in bundle" << rccPath << "using the loose file" << path;
+        return fileUrl;
+    }
+
+    QUrl resourceUrl;
+    resourceUrl.setScheme(QStringLiteral("qrc"));
+    resourceUrl.setPath(resourcePath);
+    return resourceUrl;
+}
+
+void SkillBundles::acquire(const QString &skillId)
+{
+    ++m_refCount[skillId];
+}
+
+void SkillBundles::release(const QString &skillId)
+{
+    auto it = m_refCount.find(skillId);
+    if (it == m_refCount.end()) {
+        return;
+    }
+
+    if (--it.value() <= 0) {
+        m_refCount.erase(it);
+        unregisterBundles(skillId);
+    }
+}
+
+bool SkillBundles::registerBundle(const QString &skillId, const QString &rccPath)
+{
+    const QFileInfo info(rccPath);
+
+    auto it = m_bundles.constFind(skillId);
+    if (it != m_bundles.constEnd()) {
+        const Bundle &current = it->last();
+        if (current.rccPath == rccPath && current.lastModified == info.lastModified()) {
+            return true;
+        }
+        //the skill has been updated or moved: the previous bundle stays mapped
+        //for the pages already loaded from it, until the skill is released
+    }
+
+    if (!info.exists()) {
+        return false;
+    }
+
+    // Keeping /ui at the end of the root makes DelegateLoader::translationsUrl() work inside bundles too
+    Bundle bundle;
+    bundle.rccPath = rccPath;
+    bundle.mapRoot = QStringLiteral("/skills/") + skillId + QLatin1Char('/') + QString::number(++m_generation) + QStringLiteral("/ui");
+    bundle.lastModified = info.lastModified();
+
+    // QResource maps the file in memory rather than reading it
+    if (!QResource::registerResource(rccPath, bundle.mapRoot)) {
+        qWarning() << "Invalid skill bundle" << rccPath << "using the loose files";
+        return false;
+    }
+
+    m_bundles[skillId] << bundle;
+    return true;
+}
+
+void SkillBundles::unregisterBundles(const QString &skillId)
+{
+    for (const auto &bundle : m_bundles.take(skillId)) {
+        QResource::unregisterResource(bundle.rccPath, bundle.mapRoot);
+    }
+}
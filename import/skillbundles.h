@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QUrl>
+
+/**
+ * Packed skill UIs: a skill can ship its whole ui/ directory as a single binary
+ * resource file, ui.rcc, next to the ui/ directory (see tools/mycroft-gui-pack-skill).
+ * The file is memory mapped and registered with QResource, so the pages, images and
+ * translations of the skill are read from one mapping instead of many small files.
+ *
+ * Pages in a bundle are referenced with the bundle: scheme, with the same path the
+ * loose file would have, like bundle:///opt/mycroft/skills/skill-weather/ui/forecast.qml
+ * If there is no bundle, or the page is not in it, the loose file is used.
+ *
+ * Every registration is mapped under its own root, so when a skill is repacked the
+ * pages already loaded keep reading the previous bundle until the skill goes away.
+ */
+class SkillBundles
+{
+public:
+    static SkillBundles *instance();
+
+    /**
+     * @returns the url to load for a page sent by the server: for bundle: urls a qrc: url
+     * inside the registered bundle, or the file: url of the loose file as fallback.
+     * Any other url is returned unchanged
+     */
+    QUrl resolve(const QString &skillId, const QUrl &url);
+
+    /**
+     * A view started showing pages of skillId. Calls are reference counted with release()
+     */
+    void acquire(const QString &skillId);
+
+    /**
+     * The skill pages are gone: once no view uses the skill anymore all the
+     * bundles registered for it are unregistered
+     */
+    void release(const QString &skillId);
+
+private:
+    SkillBundles() = default;
+
+    struct Bundle {
+        QString rccPath;
+        QString mapRoot;
+        QDateTime lastModified;
+    };
+
+    bool registerBundle(const QString &skillId, const QString &rccPath);
+    void unregisterBundles(const QString &skillId);
+
+    //skill id -> bundles registered, the last one is the current
+    QHash<QString, QList<Bundle>> m_bundles;
+    QHash<QString, int> m_refCount;
+    int m_generation = 0;
+};
+
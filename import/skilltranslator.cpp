@@ -0,0 +1,239 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "skilltranslator.h"
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QLocale>
+#include <QtConcurrent>
+#include <QDebug>
+
+static QString cacheKeyFor(const QString &skillId, const QLocale &locale)
+{
+    return skillId + QLatin1Char('/') + locale.name();
+}
+
+// Runs in a worker thread: the .qm file gets mapped and the skill QML files enumerated off the GUI thread
+static SkillCatalog loadCatalog(const QString &skillId, const QLocale &locale, const QString &translationsPath, QThread *targetThread)
+{
+    SkillCatalog catalog;
+
+    QTranslator *translator = new QTranslator;
+    if (!translator->load(locale, skillId, QStringLiteral("_"), translationsPath)) {
+        delete translator;
+        return catalog;
+    }
+
+    // The application and the Mycroft module are in resources, skill bundles are mapped under /skills
+    QSet<QString> applicationContexts;
+    QDirIterator resourcesIt(QStringLiteral(":/"), {QStringLiteral("*.qml")}, QDir::Files, QDirIterator::Subdirectories);
+    while (resourcesIt.hasNext()) {
+        resourcesIt.next();
+        if (!resourcesIt.filePath().startsWith(QLatin1String(":/skills/"))) {
+            applicationContexts.insert(resourcesIt.fileInfo().completeBaseName());
+        }
+    }
+
+    // The context of a qsTr() call in QML is the base name of the file it is in
+    QDirIterator it(QFileInfo(translationsPath).path(), {QStringLiteral("*.qml")}, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QString context = it.fileInfo().completeBaseName();
+        if (applicationContexts.contains(context)) {
+            qWarning() << "The skill" << skillId << "page" << it.filePath() << "has the name of an application file, it won't be translated";
+            continue;
+        }
+        if (!catalog.contexts.contains(context)) {
+            catalog.contexts << context;
+        }
+    }
+
+    translator->moveToThread(targetThread);
+    catalog.translator = translator;
+    return catalog;
+}
+
+SkillTranslator *SkillTranslator::instance()
+{
+    static SkillTranslator* s_self = nullptr;
+    if (!s_self) {
+        s_self = new SkillTranslator(QCoreApplication::instance());
+        QCoreApplication::installTranslator(s_self);
+    }
+    return s_self;
+}
+
+SkillTranslator::SkillTranslator(QObject *parent)
+    : QTranslator(parent)
+{
+}
+
+void SkillTranslator::acquire(const QString &skillId, const QString &translationsPath)
+{
+    if (m_refCount[skillId]++ > 0) {
+        return;
+    }
+
+    const QLocale locale;
+    const QString key = cacheKeyFor(skillId, locale);
+
+    if (m_cache.contains(key)) {
+        route(skillId, key);
+        return;
+    }
+
+    if (m_loading.contains(key)) {
+        return;
+    }
+    m_loading.insert(key);
+
+    auto *watcher = new QFutureWatcher<SkillCatalog>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, skillId, key]() {
+        const SkillCatalog catalog = watcher->result();
+        watcher->deleteLater();
+
+        m_loading.remove(key);
+        //skills without translations are cached as well, to not hit the disk again
+        m_cache[key] = catalog;
+        if (catalog.translator) {
+            catalog.translator->setParent(this);
+        }
+
+        if (m_refCount.value(skillId) > 0) {
+            route(skillId, key);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(loadCatalog, skillId, locale, translationsPath, thread()));
+}
+
+void SkillTranslator::release(const QString &skillId)
+{
+    auto it = m_refCount.find(skillId);
+    if (it == m_refCount.end()) {
+        return;
+    }
+
+    if (--it.value() > 0) {
+        return;
+    }
+
+    m_refCount.erase(it);
+    unroute(skillId);
+}
+
+void SkillTranslator::route(const QString &skillId, const QString &cacheKey)
+{
+    const SkillCatalog catalog = m_cache.value(cacheKey);
+    if (!catalog.translator || m_routedSkills.contains(skillId)) {
+        return;
+    }
+
+    QSet<QString> sharingSkills;
+    {
+        QWriteLocker locker(&m_routesLock);
+        for (const auto &context : catalog.contexts) {
+            QList<Route> &routes = m_routes[context.toUtf8()];
+            for (const auto &route : routes) {
+                sharingSkills.insert(route.skillId);
+            }
+            routes.append({skillId, catalog.translator});
+        }
+    }
+    m_routedSkills[skillId] = cacheKey;
+
+    if (!sharingSkills.isEmpty()) {
+        qWarning() << "The skill" << skillId << "has pages with the same file names as the skills" << sharingSkills.values()
+                   << "their strings are translated only where they agree";
+    }
+
+    emit catalogLoaded(skillId);
+    for (const auto &sharingSkill : sharingSkills) {
+        emit catalogLoaded(sharingSkill);
+    }
+}
+
+void SkillTranslator::unroute(const QString &skillId)
+{
+    const QString cacheKey = m_routedSkills.take(skillId);
+    const SkillCatalog catalog = m_cache.value(cacheKey);
+    if (!catalog.translator) {
+        return;
+    }
+
+    QSet<QString> sharingSkills;
+    {
+        QWriteLocker locker(&m_routesLock);
+        for (const auto &context : catalog.contexts) {
+            auto it = m_routes.find(context.toUtf8());
+            if (it == m_routes.end()) {
+                continue;
+            }
+            QList<Route> &routes = it.value();
+            for (int i = routes.count() - 1; i >= 0; --i) {
+                if (routes[i].skillId == skillId) {
+                    routes.removeAt(i);
+                } else {
+                    sharingSkills.insert(routes[i].skillId);
+                }
+            }
+            if (routes.isEmpty()) {
+                m_routes.erase(it);
+            }
+        }
+    }
+
+    //strings of the other skills may be translated again
+    for (const auto &sharingSkill : sharingSkills) {
+        emit catalogLoaded(sharingSkill);
+    }
+}
+
+QString SkillTranslator::translate(const char *context, const char *sourceText, const char *disambiguation, int n) const
+{
+    if (!context) {
+        return QString();
+    }
+
+    QReadLocker locker(&m_routesLock);
+    const auto it = m_routes.constFind(QByteArray::fromRawData(context, qstrlen(context)));
+    if (it == m_routes.constEnd()) {
+        return QString();
+    }
+
+    const QList<Route> &routes = it.value();
+    const QString translation = routes.first().translator->translate(context, sourceText, disambiguation, n);
+
+    //the file may be of any of those skills: don't show the translation of another skill
+    for (int i = 1; i < routes.count(); ++i) {
+        if (routes[i].translator->translate(context, sourceText, disambiguation, n) != translation) {
+            return QString();
+        }
+    }
+
+    return translation;
+}
+
+bool SkillTranslator::isEmpty() const
+{
+    QReadLocker locker(&m_routesLock);
+    return m_routes.isEmpty();
+}
+
+#include "moc_skilltranslator.cpp"
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QTranslator>
+#include <QHash>
+#include <QSet>
+#include <QReadWriteLock>
+
+/**
+ * A translation catalog of a single skill, with the translation contexts
+ * (the base names of the skill QML files) it is responsible for.
+ * Contexts of the application and of the Mycroft module QML files are left out,
+ * a skill can't change their strings
+ */
+struct SkillCatalog
+{
+    QTranslator *translator = nullptr;
+    QStringList contexts;
+};
+
+/**
+ * The only translator installed in the application on behalf of the skills:
+ * instead of installing one QTranslator per skill, which every qsTr() of the whole
+ * application would walk, lookups are routed by context to the catalog of the skill
+ * that owns the QML file.
+ * qsTr() only passes the base name of the file as context, so when pages of several
+ * skills in use share a file name the lookup can't tell them apart: a translation is
+ * used only if all those skills agree on it, the source text is shown otherwise.
+ * Catalogs are loaded in a worker thread and cached by skill id and locale.
+ */
+class SkillTranslator : public QTranslator
+{
+    Q_OBJECT
+
+public:
+    static SkillTranslator *instance();
+
+    /**
+     * Starts routing the translations of skillId, loading its catalog from translationsPath
+     * if not cached yet. Calls are reference counted with release()
+     */
+    void acquire(const QString &skillId, const QString &translationsPath);
+
+    /**
+     * The skill pages are gone: its catalog stays cached but isn't looked up anymore
+     */
+    void release(const QString &skillId);
+
+//REIMPLEMENTED
+    QString translate(const char *context, const char *sourceText, const char *disambiguation = nullptr, int n = -1) const override;
+    bool isEmpty() const override;
+
+Q_SIGNALS:
+    /**
+     * The catalog of a skill has been loaded and is being used, or the contexts it shares
+     * with other skills changed: pages already created need to be retranslated
+     */
+    void catalogLoaded(const QString &skillId);
+
+private:
+    explicit SkillTranslator(QObject *parent = nullptr);
+
+    void route(const QString &skillId, const QString &cacheKey);
+    void unroute(const QString &skillId);
+
+    QHash<QString, SkillCatalog> m_cache;
+    QSet<QString> m_loading;
+    QHash<QString, int> m_refCount;
+    //skill id -> cache key of the catalog currently routed
+    QHash<QString, QString> m_routedSkills;
+
+    struct Route {
+        QString skillId;
+        QTranslator *translator;
+    };
+
+    //Read from any thread calling QCoreApplication::translate
+    QHash<QByteArray, QList<Route>> m_routes;
+    mutable QReadWriteLock m_routesLock;
+};
+
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "spectrumbuffer.h"
+
+#include <QMutexLocker>
+#include <cmath>
+
+SpectrumBuffer::SpectrumBuffer()
+{
+}
+
+float *SpectrumBuffer::backBuffer(int bins)
+{
+    // Only the worker touches the back buffer and m_front is changed only by the worker
+    QVector<float> &back = m_buffers[1 - m_front];
+    if (back.size() != bins) {
+        back.resize(bins);
+    }
+    return back.data();
+}
+
+void SpectrumBuffer::swap(int sampleRate)
+{
+    QMutexLocker locker(&m_mutex);
+    m_front = 1 - m_front;
+    m_sampleRate = sampleRate;
+    ++m_serial;
+}
+
+bool SpectrumBuffer::latest(QVector<float> &magnitudes, int &sampleRate, quint64 &serial) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_serial == serial) {
+        return false;
+    }
+
+    const QVector<float> &front = m_buffers[m_front];
+    if (magnitudes.size() != front.size()) {
+        magnitudes.resize(front.size());
+    }
+    std::copy(front.constBegin(), front.constEnd(), magnitudes.begin());
+    sampleRate = m_sampleRate;
+    serial = m_serial;
+    return true;
+}
+
+void SpectrumBuffer::aggregateBands(const QVector<float> &magnitudes, int sampleRate,
+                                    float minFrequency, float maxFrequency, QVector<float> &bands)
+{
+    const int bins = magnitudes.size();
+    if (bins == 0 || sampleRate <= 0 || bands.isEmpty()) {
+        bands.fill(0);
+        return;
+    }
+
+    // Bin k is centered on k * sampleRate / (2 * bins)
+    const float binsPerHz = 2.0f * bins / sampleRate;
+    const float nyquist = sampleRate / 2.0f;
+    minFrequency = qBound(1.0f, minFrequency, nyquist);
+    maxFrequency = qBound(minFrequency, maxFrequency, nyquist);
+    const float ratio = maxFrequency / minFrequency;
+
+    float low = minFrequency * binsPerHz;
+    for (int i = 0; i < bands.size(); ++i) {
+        const float high = minFrequency * std::pow(ratio, float(i + 1) / bands.size()) * binsPerHz;
+
+        const int first = qBound(0, int(std::ceil(low)), bins - 1);
+        const int last = qBound(0, int(std::floor(high)), bins - 1);
+        if (last < first) {
+            // Narrower than a bin: interpolate at the center of the band
+            const float center = qBound(0.0f, (low + high) / 2, float(bins - 1));
+            const int index = qMin(int(center), bins - 2);
+            const float fraction = center - index;
+            bands[i] = bins > 1 ? magnitudes[index] * (1 - fraction) + magnitudes[index + 1] * fraction : magnitudes[0];
+        } else {
+            float sum = 0;
+            for (int k = first; k <= last; ++k) {
+                sum += magnitudes[k];
+            }
+            bands[i] = sum / (last - first + 1);
+        }
+
+        low = high;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QVector>
+
+/**
+ * The latest linear magnitude spectrum computed by the FFT worker, shared with
+ * the render thread without going through QML.
+ * The worker fills the back buffer without locking, the lock is held only to
+ * swap it with the front one and by readers to copy the front one.
+ */
+class SpectrumBuffer
+{
+public:
+    SpectrumBuffer();
+
+    /**
+     * Worker side: the buffer to fill with the next spectrum, resized to bins
+     */
+    float *backBuffer(int bins);
+
+    /**
+     * Worker side: makes the back buffer the latest spectrum
+     */
+    void swap(int sampleRate);
+
+    /**
+     * Copies the latest spectrum into magnitudes if newer than serial.
+     * @returns true if it was newer, updating serial
+     */
+    bool latest(QVector<float> &magnitudes, int &sampleRate, quint64 &serial) const;
+
+    /**
+     * Averages the bins of magnitudes into bands log spaced between
+     * minFrequency and maxFrequency. Bands narrower than a bin are interpolated
+     */
+    static void aggregateBands(const QVector<float> &magnitudes, int sampleRate,
+                               float minFrequency, float maxFrequency, QVector<float> &bands);
+
+private:
+    QVector<float> m_buffers[2];
+    int m_front = 0;
+    int m_sampleRate = 0;
+    quint64 m_serial = 0;
+    mutable QMutex m_mutex;
+};
+
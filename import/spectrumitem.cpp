@@ -0,0 +1,322 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "spectrumitem.h"
+#include "mediaservice.h"
+#include "spectrumbuffer.h"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <cmath>
+
+// Bands are shown in dB, from -s_dynamicRange to 0
+static const float s_dynamicRange = 60;
+
+static QSGGeometryNode *createGeometryNode(QSGGeometry::DrawingMode mode)
+{
+    QSGGeometryNode *node = new QSGGeometryNode;
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(new QSGFlatColorMaterial);
+    node->setFlag(QSGNode::OwnsMaterial);
+    return node;
+}
+
+static void setNodeColor(QSGGeometryNode *node, const QColor &color)
+{
+    QSGFlatColorMaterial *material = static_cast<QSGFlatColorMaterial *>(node->material());
+    if (material->color() != color) {
+        material->setColor(color);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+static void setRect(QSGGeometry::Point2D *vertices, float x1, float y1, float x2, float y2)
+{
+    vertices[0].set(x1, y1);
+    vertices[1].set(x2, y1);
+    vertices[2].set(x1, y2);
+    vertices[3].set(x1, y2);
+    vertices[4].set(x2, y1);
+    vertices[5].set(x2, y2);
+}
+
+SpectrumItem::SpectrumItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+SpectrumItem::~SpectrumItem()
+{
+}
+
+MediaService *SpectrumItem::source() const
+{
+    return m_source;
+}
+
+void SpectrumItem::setSource(MediaService *source)
+{
+    if (m_source == source) {
+        return;
+    }
+
+    if (m_source) {
+        disconnect(m_source, nullptr, this, nullptr);
+    }
+    m_source = source;
+    if (m_source) {
+        // Just schedule a repaint, the values are picked up in the render thread
+        connect(m_source, &MediaService::spectrumChanged, this, &QQuickItem::update);
+    }
+
+    m_serial = 0;
+    update();
+    emit sourceChanged();
+}
+
+SpectrumItem::Style SpectrumItem::style() const
+{
+    return m_style;
+}
+
+void SpectrumItem::setStyle(Style style)
+{
+    if (m_style == style) {
+        return;
+    }
+
+    m_style = style;
+    update();
+    emit styleChanged();
+}
+
+int SpectrumItem::bands() const
+{
+    return m_bands;
+}
+
+void SpectrumItem::setBands(int bands)
+{
+    bands = qMax(1, bands);
+    if (m_bands == bands) {
+        return;
+    }
+
+    m_bands = bands;
+    m_serial = 0;
+    update();
+    emit bandsChanged();
+}
+
+qreal SpectrumItem::minFrequency() const
+{
+    return m_minFrequency;
+}
+
+void SpectrumItem::setMinFrequency(qreal frequency)
+{
+    if (m_minFrequency == frequency) {
+        return;
+    }
+
+    m_minFrequency = frequency;
+    m_serial = 0;
+    update();
+    emit minFrequencyChanged();
+}
+
+qreal SpectrumItem::maxFrequency() const
+{
+    return m_maxFrequency;
+}
+
+void SpectrumItem::setMaxFrequency(qreal frequency)
+{
+    if (m_maxFrequency == frequency) {
+        return;
+    }
+
+    m_maxFrequency = frequency;
+    m_serial = 0;
+    update();
+    emit maxFrequencyChanged();
+}
+
+qreal SpectrumItem::peakDecay() const
+{
+    return m_peakDecay;
+}
+
+void SpectrumItem::setPeakDecay(qreal decay)
+{
+    if (m_peakDecay == decay) {
+        return;
+    }
+
+    m_peakDecay = decay;
+    update();
+    emit peakDecayChanged();
+}
+
+QColor SpectrumItem::color() const
+{
+    return m_color;
+}
+
+void SpectrumItem::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+
+    m_color = color;
+    update();
+    emit colorChanged();
+}
+
+QColor SpectrumItem::peakColor() const
+{
+    return m_peakColor;
+}
+
+void SpectrumItem::setPeakColor(const QColor &color)
+{
+    if (m_peakColor == color) {
+        return;
+    }
+
+    m_peakColor = color;
+    update();
+    emit peakColorChanged();
+}
+
+qreal SpectrumItem::spacing() const
+{
+    return m_spacing;
+}
+
+void SpectrumItem::setSpacing(qreal spacing)
+{
+    if (m_spacing == spacing) {
+        return;
+    }
+
+    m_spacing = spacing;
+    update();
+    emit spacingChanged();
+}
+
+void SpectrumItem::updateLevels()
+{
+    if (m_levels.size() != m_bands) {
+        m_levels.fill(0, m_bands);
+        m_peaks.fill(0, m_bands);
+    }
+
+    SpectrumBuffer *buffer = m_source ? m_source->latestSpectrum() : nullptr;
+    if (buffer && buffer->latest(m_magnitudes, m_sampleRate, m_serial)) {
+        SpectrumBuffer::aggregateBands(m_magnitudes, m_sampleRate, m_minFrequency, m_maxFrequency, m_levels);
+        for (auto &level : m_levels) {
+            level = level > 0 ? qBound(0.0f, 1 + 20 * std::log10(level) / s_dynamicRange, 1.0f) : 0;
+        }
+    }
+
+    const float decay = m_peakClock.isValid() ? m_peakDecay * m_peakClock.restart() / 1000 : 0;
+    if (!m_peakClock.isValid()) {
+        m_peakClock.start();
+    }
+    for (int i = 0; i < m_bands; ++i) {
+        m_peaks[i] = qMax(m_levels[i], m_peaks[i] - decay);
+    }
+}
+
+QSGNode *SpectrumItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data)
+
+    updateLevels();
+
+    // The root holds the bars or the line, its only child the peaks
+    const QSGGeometry::DrawingMode mode = m_style == Line ? QSGGeometry::DrawLineStrip : QSGGeometry::DrawTriangles;
+    QSGGeometryNode *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (node && node->geometry()->drawingMode() != mode) {
+        delete node;
+        node = nullptr;
+    }
+    if (!node) {
+        node = createGeometryNode(mode);
+        node->appendChildNode(createGeometryNode(QSGGeometry::DrawTriangles));
+    }
+    QSGGeometryNode *peaksNode = static_cast<QSGGeometryNode *>(node->firstChild());
+
+    setNodeColor(node, m_color);
+    setNodeColor(peaksNode, m_peakColor);
+
+    const float w = width();
+    const float h = height();
+    const float bandWidth = w / m_bands;
+    const float gap = qMin<float>(m_spacing, bandWidth / 2);
+
+    QSGGeometry *geometry = node->geometry();
+    if (m_style == Line) {
+        geometry->allocate(m_bands);
+        geometry->setLineWidth(qMax<float>(1, m_spacing));
+        QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+        for (int i = 0; i < m_bands; ++i) {
+            vertices[i].set(bandWidth * (i + 0.5f), h * (1 - m_levels[i]));
+        }
+    } else {
+        geometry->allocate(m_bands * 6);
+        QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+        for (int i = 0; i < m_bands; ++i) {
+            setRect(vertices + i * 6, bandWidth * i + gap / 2, h * (1 - m_levels[i]), bandWidth * (i + 1) - gap / 2, h);
+        }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+
+    QSGGeometry *peaksGeometry = peaksNode->geometry();
+    const bool showPeaks = m_peakDecay > 0;
+    peaksGeometry->allocate(showPeaks ? m_bands * 6 : 0);
+    if (showPeaks) {
+        QSGGeometry::Point2D *vertices = peaksGeometry->vertexDataAsPoint2D();
+        const float thickness = qMax(1.0f, h / 60);
+        for (int i = 0; i < m_bands; ++i) {
+            const float y = h * (1 - m_peaks[i]);
+            setRect(vertices + i * 6, bandWidth * i + gap / 2, y - thickness, bandWidth * (i + 1) - gap / 2, y);
+        }
+    }
+    peaksNode->markDirty(QSGNode::DirtyGeometry);
+
+    // Keep animating until the peaks have fallen on the bars
+    for (int i = 0; i < m_bands; ++i) {
+        if (showPeaks && m_peaks[i] > m_levels[i]) {
+            QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+            break;
+        }
+    }
+    if (!showPeaks || m_peaks == m_levels) {
+        m_peakClock.invalidate();
+    }
+
+    return node;
+}
+
+#include "moc_spectrumitem.cpp"
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QQuickItem>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QVector>
+
+class MediaService;
+
+/**
+ * Spectrum visualizer drawn directly in the scene graph from the spectrum
+ * computed by a MediaService, without passing the values through QML.
+ * The FFT bins are aggregated in log spaced bands, with optional falling peaks.
+ */
+class SpectrumItem : public QQuickItem
+{
+    Q_OBJECT
+    /**
+     * The MediaService whose playback is shown, usually the MediaService singleton
+     */
+    Q_PROPERTY(MediaService *source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(Style style READ style WRITE setStyle NOTIFY styleChanged)
+    Q_PROPERTY(int bands READ bands WRITE setBands NOTIFY bandsChanged)
+    Q_PROPERTY(qreal minFrequency READ minFrequency WRITE setMinFrequency NOTIFY minFrequencyChanged)
+    Q_PROPERTY(qreal maxFrequency READ maxFrequency WRITE setMaxFrequency NOTIFY maxFrequencyChanged)
+    /**
+     * Height lost by the peak markers per second, as a fraction of the item height. 0 disables the peaks
+     */
+    Q_PROPERTY(qreal peakDecay READ peakDecay WRITE setPeakDecay NOTIFY peakDecayChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor peakColor READ peakColor WRITE setPeakColor NOTIFY peakColorChanged)
+    /**
+     * Gap between bars, or width of the line
+     */
+    Q_PROPERTY(qreal spacing READ spacing WRITE setSpacing NOTIFY spacingChanged)
+
+public:
+    enum Style {
+        Bars = 0,
+        Line
+    };
+    Q_ENUM(Style)
+
+    explicit SpectrumItem(QQuickItem *parent = nullptr);
+    ~SpectrumItem() override;
+
+    MediaService *source() const;
+    void setSource(MediaService *source);
+
+    Style style() const;
+    void setStyle(Style style);
+
+    int bands() const;
+    void setBands(int bands);
+
+    qreal minFrequency() const;
+    void setMinFrequency(qreal frequency);
+
+    qreal maxFrequency() const;
+    void setMaxFrequency(qreal frequency);
+
+    qreal peakDecay() const;
+    void setPeakDecay(qreal decay);
+
+    QColor color() const;
+    void setColor(const QColor &color);
+
+    QColor peakColor() const;
+    void setPeakColor(const QColor &color);
+
+    qreal spacing() const;
+    void setSpacing(qreal spacing);
+
+Q_SIGNALS:
+    void sourceChanged();
+    void styleChanged();
+    void bandsChanged();
+    void minFrequencyChanged();
+    void maxFrequencyChanged();
+    void peakDecayChanged();
+    void colorChanged();
+    void peakColorChanged();
+    void spacingChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    void updateLevels();
+
+    QPointer<MediaService> m_source;
+    Style m_style = Bars;
+    int m_bands = 20;
+    qreal m_minFrequency = 50;
+    qreal m_maxFrequency = 16000;
+    qreal m_peakDecay = 0.5;
+    QColor m_color = Qt::white;
+    QColor m_peakColor = Qt::white;
+    qreal m_spacing = 2;
+
+    //Only used in updatePaintNode
+    QVector<float> m_magnitudes;
+    QVector<float> m_levels;
+    QVector<float> m_peaks;
+    quint64 m_serial = 0;
+    int m_sampleRate = 0;
+    QElapsedTimer m_peakClock;
+};
+
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 by OpenVoiceOS Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <QCoreApplication>
+#include <QVariant>
+
+/**
+ * Phases and marks on the startup timeline of an application started with --profile-startup.
+ * The application sets its profiler as the startupProfiler property of the QCoreApplication,
+ * without it these do nothing.
+ */
+namespace StartupTrace
+{
+
+inline QObject *profiler()
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    return app ? app->property("startupProfiler").value<QObject *>() : nullptr;
+}
+
+inline void begin(const QString &name)
+{
+    if (QObject *p = profiler()) {
+        QMetaObject::invokeMethod(p, "begin", Q_ARG(QString, name));
+    }
+}
+
+inline void end(const QString &name)
+{
+    if (QObject *p = profiler()) {
+        QMetaObject::invokeMethod(p, "end", Q_ARG(QString, name));
+    }
+}
+
+inline void mark(const QString &name)
+{
+    if (QObject *p = profiler()) {
+        QMetaObject::invokeMethod(p, "mark", Q_ARG(QString, name));
+    }
+}
+
+}
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2016 Daniel Holanda Noronha. All rights reserved.
+ * Copyright 2026 by OpenVoiceOS Contributors
  *
  * This work is licensed under the terms of the MIT license.
  * For a copy, see <https://opensource.org/licenses/MIT>.
@@ -8,27 +9,116 @@
 
 #include "fft.h"
 
-void fft(CArray& x){
-    const size_t N = x.size();
-    if (N <= 1) return;
+#include <cassert>
+#include <cmath>
 
-    CArray even = x[std::slice(0, N/2, 2)];
-    CArray  odd = x[std::slice(1, N/2, 2)];
+// std::complex multiplication checks for infinities and NaN, which the butterflies don't need
+static inline Complex multiply(const Complex &a, const Complex &b)
+{
+    return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+RealFFT::RealFFT(int size)
+    : m_size(size),
+      m_half(size / 2)
+{
+    assert(size >= 4 && (size & (size - 1)) == 0);
+
+    int bits = 0;
+    while ((1 << bits) < m_half) {
+        ++bits;
+    }
+
+    m_bitReverse.resize(m_half);
+    for (int i = 0; i < m_half; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            if (i & (1 << b)) {
+                reversed |= 1 << (bits - 1 - b);
+            }
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    m_twiddles.resize(m_half / 2);
+    for (int k = 0; k < m_half / 2; ++k) {
+        const double angle = -2 * PI * k / m_half;
+        m_twiddles[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    m_splitTwiddles.resize(m_half);
+    for (int k = 0; k < m_half; ++k) {
+        const double angle = -2 * PI * k / m_size;
+        m_splitTwiddles[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    m_work.resize(m_half);
+}
+
+int RealFFT::size() const
+{
+    return m_size;
+}
 
-    fft(even);
-    fft(odd);
+void RealFFT::complexTransform()
+{
+    Complex *data = m_work.data();
 
-    for (size_t k = 0; k < N/2; ++k)
-    {
-        Complex t = std::polar(1.0, -2 * PI * k / N) * odd[k];
-        x[k    ] = even[k] + t;
-        x[k+N/2] = even[k] - t;
+    for (int len = 2; len <= m_half; len <<= 1) {
+        const int halfLen = len / 2;
+        const int step = m_half / len;
+        for (int i = 0; i < m_half; i += len) {
+            for (int j = 0; j < halfLen; ++j) {
+                const Complex u = data[i + j];
+                const Complex v = multiply(data[i + j + halfLen], m_twiddles[j * step]);
+                data[i + j] = u + v;
+                data[i + j + halfLen] = u - v;
+            }
+        }
     }
 }
 
-void ifft(CArray& x){
-    x = x.apply(std::conj);
-    fft( x );
-    x = x.apply(std::conj);
-    x /= x.size();
+void RealFFT::pack(const float *in)
+{
+    // Even samples as real and odd samples as imaginary parts, in bit reversed order
+    for (int i = 0; i < m_half; ++i) {
+        m_work[m_bitReverse[i]] = Complex(in[2 * i], in[2 * i + 1]);
+    }
+}
+
+Complex RealFFT::splitBin(int k) const
+{
+    const Complex a = m_work[k];
+    const Complex b = std::conj(m_work[m_half - k]);
+    // Spectra of the even and odd samples
+    const Complex even = (a + b) * 0.5f;
+    const Complex odd = Complex((a - b).imag() * 0.5f, -(a - b).real() * 0.5f);
+    return even + multiply(m_splitTwiddles[k], odd);
+}
+
+void RealFFT::transform(const float *in, Complex *out)
+{
+    pack(in);
+    complexTransform();
+
+    // Z[0] holds the sums of the even and odd samples
+    out[0] = Complex(m_work[0].real() + m_work[0].imag(), 0);
+    out[m_half] = Complex(m_work[0].real() - m_work[0].imag(), 0);
+
+    for (int k = 1; k < m_half; ++k) {
+        out[k] = splitBin(k);
+    }
+}
+
+void RealFFT::magnitudes(const float *in, float *out)
+{
+    pack(in);
+    complexTransform();
+
+    out[0] = std::fabs(m_work[0].real() + m_work[0].imag());
+
+    for (int k = 1; k < m_half; ++k) {
+        out[k] = std::abs(splitBin(k));
+    }
 }
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2016 Daniel Holanda Noronha. All rights reserved.
+ * Copyright 2026 by OpenVoiceOS Contributors
  *
  * This work is licensed under the terms of the MIT license.
  * For a copy, see <https://opensource.org/licenses/MIT>.
@@ -10,14 +11,53 @@
 #define FFT_H
 
 #include <complex>
-#include <iostream>
-#include <valarray>
+#include <vector>
 
 const double PI = 3.141592653589793238460;
 
-typedef std::complex<double> Complex;
-typedef std::valarray<Complex> CArray;
+typedef std::complex<float> Complex;
 
-void fft(CArray& x);
+/**
+ * Radix-2 FFT of real samples.
+ * The size/2 points complex transform of the samples packed as
+ * even + i * odd is done iteratively in place, then split into the
+ * spectrum of the real signal. Bit reversal and twiddle tables are computed
+ * once in the constructor, transforms don't allocate.
+ */
+class RealFFT
+{
+public:
+    /**
+     * @param size number of real input samples, a power of two, at least 4
+     */
+    explicit RealFFT(int size);
+
+    int size() const;
+
+    /**
+     * Computes the first size/2 + 1 bins of the spectrum of size samples.
+     * in and out can't overlap
+     */
+    void transform(const float *in, Complex *out);
+
+    /**
+     * Computes the magnitude of the first size/2 bins of the spectrum of size samples
+     */
+    void magnitudes(const float *in, float *out);
+
+private:
+    void pack(const float *in);
+    void complexTransform();
+    Complex splitBin(int k) const;
+
+    int m_size;
+    int m_half;
+    std::vector<int> m_bitReverse;
+    //exp(-2 pi i k / (size / 2)), k < size / 4, for the butterflies
+    std::vector<Complex> m_twiddles;
+    //exp(-2 pi i k / size), k < size / 2, to split the packed transform
+    std::vector<Complex> m_splitTwiddles;
+    std::vector<Complex> m_work;
+};
 
 #endif
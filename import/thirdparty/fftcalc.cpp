@@ -12,14 +12,16 @@
 #define CLAMP(a,min,max) ((a) < (min) ? (min) : (a) > (max) ? (max) : (a))
 
 FFTCalc::FFTCalc(QObject *parent)
-    :QObject(parent){
+    :QObject(parent),
+    ring(RINGSIZE),
+    processor(&ring, &spectrumBuffer){
 
     processor.moveToThread(&processorThread);
 
     qRegisterMetaType< QVector<double> >("QVector<double>");
     connect(&processor, SIGNAL(calculatedSpectrum(QVector<double>)), SLOT(setSpectrum(QVector<double>)));
     connect(&processor, SIGNAL(allDone()),SLOT(freeCalc()));
-    processorThread.start(QThread::LowestPriority);
+    // The thread only runs while there are samples to process
     isBusy = false;
 }
 
@@ -28,26 +30,54 @@ FFTCalc::~FFTCalc(){
     processorThread.wait(10000);
 }
 
-void FFTCalc::calc(QVector<double> &_array, int duration){
-    QMetaObject::invokeMethod(&processor, "processBuffer",
-                              Qt::QueuedConnection, Q_ARG(QVector<double>, _array), Q_ARG(int, duration));
+void FFTCalc::calc(const float *samples, int count, int sampleRate){
+    // No copies and no events per buffer: the worker pulls from the ring at its own pace
+    processor.setSampleRate(sampleRate);
+    ring.write(samples, count);
+    if(!isBusy){
+        isBusy = true;
+        if(!processorThread.isRunning()){
+            processorThread.start(QThread::LowestPriority);
+        }
+        QMetaObject::invokeMethod(&processor, "start", Qt::QueuedConnection);
+    }
+}
+
+SpectrumBuffer *FFTCalc::latestSpectrum(){
+    return &spectrumBuffer;
 }
 
 void FFTCalc::setSpectrum(QVector<double> spectrum){
     emit calculatedSpectrum(spectrum);
 }
 
+void FFTCalc::setIdleTimeout(int msecs){
+    processor.setIdleTimeout(msecs);
+}
+
 void FFTCalc::freeCalc()
 {
     isBusy = false;
+    // The worker is idle, its event loop returns right away: no wakeups until the next samples
+    processorThread.quit();
+    processorThread.wait();
 }
 
-BufferProcessor::BufferProcessor(QObject *parent){
+BufferProcessor::BufferProcessor(SampleRingBuffer *_ring, SpectrumBuffer *_spectrumBuffer, QObject *parent)
+    : ring(_ring),
+    spectrumBuffer(_spectrumBuffer),
+    sampleRate(0),
+    readPosition(0),
+    lastWritePosition(0),
+    idleTicks(0),
+    idleTimeout(IDLETIMEOUT),
+    fft(SPECSIZE){
     Q_UNUSED(parent);
     timer = new QTimer(this);
     connect(timer,SIGNAL(timeout()),this,SLOT(run()));
     window.resize(SPECSIZE);
-    complexFrame.resize(SPECSIZE);
+    frame.resize(SPECSIZE);
+    magnitudes.resize(SPECSIZE/2);
     spectrum.resize(SPECSIZE/2);
     logscale.resize(SPECSIZE/2+1);
     compressed = true;
@@ -57,8 +87,6 @@ BufferProcessor::BufferProcessor(QObject *parent){
     for(int i=0; i<=SPECSIZE/2; i++){
         logscale[i] = powf (SPECSIZE/2, (float) 2*i / SPECSIZE) - 0.5f;
     }
-    running = false;
-    timer->start(100);
 }
 
 BufferProcessor::~BufferProcessor(){
@@ -66,41 +94,66 @@ BufferProcessor::~BufferProcessor(){
 
 }
 
-void BufferProcessor::processBuffer(QVector<double> _array, int duration){
-    if(array.size() != _array.size()){
-        numberOfChunks = _array.size()/SPECSIZE;
-        array.resize(_array.size());
-    }
-    interval = duration/numberOfChunks;
-    if(interval < 1)
-        interval = 1;
-    array = _array;
-    pass = 0;
-    timer->start(interval);
+void BufferProcessor::setSampleRate(int rate){
+    sampleRate.storeRelease(rate);
+}
+
+void BufferProcessor::setIdleTimeout(int msecs){
+    idleTimeout.storeRelease(msecs);
+}
+
+void BufferProcessor::start(){
+    // Continue from where the new samples begin
+    readPosition = lastWritePosition;
+    idleTicks = 0;
+    clock.start();
+    timer->start(FRAMEINTERVAL);
 }
 
 void BufferProcessor::run(){
-    unsigned long bufferSize;
     qreal amplitude;
-    if(pass == numberOfChunks){
-        emit allDone();
-        return;
+    const quint64 written = ring->writePosition();
+
+    if(written == lastWritePosition){
+        if(++idleTicks * FRAMEINTERVAL >= idleTimeout.loadAcquire()){
+            timer->stop();
+            emit allDone();
+            return;
+        }
+    }
+    else{
+        idleTicks = 0;
+        lastWritePosition = written;
+    }
+
+    // Follow the playback in real time: consecutive windows overlap when less
+    // than SPECSIZE samples have been played since the last one
+    readPosition += quint64(clock.restart()) * sampleRate.loadAcquire() / 1000;
+    if(readPosition > written){
+        readPosition = written;
     }
-    bufferSize = array.size();
-    if(bufferSize < SPECSIZE){
+    // Drop the oldest samples if the decoder is too much ahead
+    const quint64 maxBacklog = ring->capacity() - SPECSIZE;
+    if(written - readPosition > maxBacklog){
+        readPosition = written - maxBacklog;
+    }
+
+    if(!ring->read(readPosition, frame.data(), SPECSIZE)){
         return;
     }
     for(uint i=0; i<SPECSIZE; i++){
-        complexFrame[i] = Complex(window[i]*array[i+pass*SPECSIZE],0);
+        frame[i] *= window[i];
     }
-    fft(complexFrame);
+    fft.magnitudes(frame.constData(), magnitudes.data());
     for(uint i=0; i<SPECSIZE/2;i++){
         qreal SpectrumAnalyserMultiplier = 1e-2;
-        amplitude = SpectrumAnalyserMultiplier*std::abs(complexFrame[i]);
+        amplitude = SpectrumAnalyserMultiplier*magnitudes[i];
         amplitude = qMax(qreal(0.0), amplitude);
         amplitude = qMin(qreal(1.0), amplitude);
-        complexFrame[i] = amplitude;
+        magnitudes[i] = amplitude;
     }
+    std::copy(magnitudes.constBegin(), magnitudes.constEnd(), spectrumBuffer->backBuffer(SPECSIZE/2));
+    spectrumBuffer->swap(sampleRate.loadAcquire());
 
     if(compressed){
         for (int i = 0; i <SPECSIZE/2; i ++){
@@ -109,14 +162,14 @@ void BufferProcessor::run(){
             float sum = 0;
 
             if (b < a)
-                sum += complexFrame[b].real()*(logscale[i+1]-logscale[i]);
+                sum += magnitudes[b]*(logscale[i+1]-logscale[i]);
             else{
                 if (a > 0)
-                    sum += complexFrame[a-1].real()*(a-logscale[i]);
+                    sum += magnitudes[a-1]*(a-logscale[i]);
                 for (; a < b; a++)
-                    sum += complexFrame[a].real();
+                    sum += magnitudes[a];
                 if (b < SPECSIZE/2)
-                    sum += complexFrame[b].real()*(logscale[i+1] - b);
+                    sum += magnitudes[b]*(logscale[i+1] - b);
             }
 
             sum *= (float) SPECSIZE/24;
@@ -127,9 +180,8 @@ void BufferProcessor::run(){
     }
     else{
         for(int i=0; i<SPECSIZE/2; i++){
-            spectrum[i] = CLAMP(complexFrame[i].real()*100,0,1);
+            spectrum[i] = CLAMP(magnitudes[i]*100,0,1);
         }
     }
     emit calculatedSpectrum(spectrum);
-    pass++;
 }
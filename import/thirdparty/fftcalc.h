@@ -10,53 +10,71 @@
 #define FFTCALC_H
 
 #include <QThread>
-#include <QWaitCondition>
-#include <QMutex>
 #include <QVector>
 #include <QDebug>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QObject>
 #include "fft.h"
+#include "../sampleringbuffer.h"
+#include "../spectrumbuffer.h"
 
 #define SPECSIZE 512
+// About 185ms of audio at 44.1kHz, older samples are dropped
+#define RINGSIZE (SPECSIZE*16)
+// Milliseconds between two spectrum frames
+#define FRAMEINTERVAL 20
+// Default milliseconds without samples after which the worker and its thread stop
+#define IDLETIMEOUT 500
 
 class BufferProcessor: public QObject{
     Q_OBJECT
-    QVector<double> array;
     QVector<double> window;
     QVector<double> spectrum;
     QVector<double> logscale;
     QTimer *timer;
     bool compressed;
-    bool running;
-    int numberOfChunks;
-    int interval;
-    int pass;
-    CArray complexFrame;
+    SampleRingBuffer *ring;
+    SpectrumBuffer *spectrumBuffer;
+    QAtomicInt sampleRate;
+    quint64 readPosition;
+    quint64 lastWritePosition;
+    int idleTicks;
+    QAtomicInt idleTimeout;
+    QElapsedTimer clock;
+    RealFFT fft;
+    QVector<float> frame;
+    QVector<float> magnitudes;
 
 public slots:
-    void processBuffer(QVector<double> _array, int duration);
+    void start();
 signals:
     void calculatedSpectrum(QVector<double> spectrum);
     void allDone(void);
 protected slots:
     void run();
 public:
-    explicit BufferProcessor(QObject *parent=0);
+    explicit BufferProcessor(SampleRingBuffer *_ring, SpectrumBuffer *_spectrumBuffer, QObject *parent=0);
     ~BufferProcessor();
-    void calc(QVector<double> &_array, int duration);
+    void setSampleRate(int rate);
+    void setIdleTimeout(int msecs);
 };
 class FFTCalc : public QObject{
     Q_OBJECT
 private:
     bool isBusy;
+    SampleRingBuffer ring;
+    SpectrumBuffer spectrumBuffer;
     BufferProcessor processor;
     QThread processorThread;
 
 public:
     explicit FFTCalc(QObject *parent = 0);
     ~FFTCalc();
-    void calc(QVector<double> &_array, int duration);
+    void calc(const float *samples, int count, int sampleRate);
+    // Linear magnitudes of the latest spectrum, readable from any thread
+    SpectrumBuffer *latestSpectrum();
+    void setIdleTimeout(int msecs);
 public slots:
     void setSpectrum(QVector<double> spectrum);
     void freeCalc();